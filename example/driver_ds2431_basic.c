@@ -37,6 +37,19 @@
 #include "driver_ds2431_basic.h"
 
 static ds2431_handle_t gs_handle;        /**< ds2431 handle */
+static const ds2431_ops_t gs_ops =      /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = ds2431_interface_debug_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
 
 /**
  * @brief  basic example init
@@ -51,15 +64,7 @@ uint8_t ds2431_basic_init(void)
     
     /* link interface function */
     DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
-    DRIVER_DS2431_LINK_BUS_INIT(&gs_handle, ds2431_interface_init);
-    DRIVER_DS2431_LINK_BUS_DEINIT(&gs_handle, ds2431_interface_deinit);
-    DRIVER_DS2431_LINK_BUS_READ(&gs_handle, ds2431_interface_read);
-    DRIVER_DS2431_LINK_BUS_WRITE(&gs_handle, ds2431_interface_write);
-    DRIVER_DS2431_LINK_DELAY_MS(&gs_handle, ds2431_interface_delay_ms);
-    DRIVER_DS2431_LINK_DELAY_US(&gs_handle, ds2431_interface_delay_us);
-    DRIVER_DS2431_LINK_ENABLE_IRQ(&gs_handle, ds2431_interface_enable_irq);
-    DRIVER_DS2431_LINK_DISABLE_IRQ(&gs_handle, ds2431_interface_disable_irq);
-    DRIVER_DS2431_LINK_DEBUG_PRINT(&gs_handle, ds2431_interface_debug_print);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
     
     /* ds2431 init */
     res = ds2431_init(&gs_handle);
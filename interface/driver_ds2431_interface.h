@@ -51,68 +51,84 @@ extern "C"{
  */
 
 /**
- * @brief  interface bus init
- * @return status code
- *         - 0 success
- *         - 1 bus init failed
- * @note   none
+ * @brief     interface bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus init failed
+ * @note      none
  */
-uint8_t ds2431_interface_init(void);
+uint8_t ds2431_interface_init(void *user);
 
 /**
- * @brief  interface bus deinit
- * @return status code
- *         - 0 success
- *         - 1 bus deinit failed
- * @note   none
+ * @brief     interface bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus deinit failed
+ * @note      none
  */
-uint8_t ds2431_interface_deinit(void);
+uint8_t ds2431_interface_deinit(void *user);
 
 /**
  * @brief      interface bus read
+ * @param[in]  *user pointer to a user context
  * @param[out] *value pointer to a value buffer
  * @return     status code
  *             - 0 success
  *             - 1 read failed
  * @note       none
  */
-uint8_t ds2431_interface_read(uint8_t *value);
+uint8_t ds2431_interface_read(void *user, uint8_t *value);
 
 /**
  * @brief     interface bus write
+ * @param[in] *user pointer to a user context
  * @param[in] value written value
  * @return    status code
  *            - 0 success
  *            - 1 write failed
  * @note      none
  */
-uint8_t ds2431_interface_write(uint8_t value);
+uint8_t ds2431_interface_write(void *user, uint8_t value);
 
 /**
  * @brief     interface delay ms
+ * @param[in] *user pointer to a user context
  * @param[in] ms time
  * @note      none
  */
-void ds2431_interface_delay_ms(uint32_t ms);
+void ds2431_interface_delay_ms(void *user, uint32_t ms);
 
 /**
  * @brief     interface delay us
+ * @param[in] *user pointer to a user context
  * @param[in] us time
  * @note      none
  */
-void ds2431_interface_delay_us(uint32_t us);
+void ds2431_interface_delay_us(void *user, uint32_t us);
 
 /**
- * @brief interface enable the interrupt
- * @note  none
+ * @brief     interface enable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
+ */
+void ds2431_interface_enable_irq(void *user);
+
+/**
+ * @brief     interface disable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
  */
-void ds2431_interface_enable_irq(void);
+void ds2431_interface_disable_irq(void *user);
 
 /**
- * @brief interface disable the interrupt
- * @note  none
+ * @brief     interface get the timestamp
+ * @param[in] *user pointer to a user context
+ * @return    timestamp in us
+ * @note      none
  */
-void ds2431_interface_disable_irq(void);
+uint32_t ds2431_interface_timestamp_us(void *user);
 
 /**
  * @brief     interface print format data
@@ -37,93 +37,162 @@
 #include "driver_ds2431_interface.h"
 
 /**
- * @brief  interface bus init
- * @return status code
- *         - 0 success
- *         - 1 bus init failed
- * @note   none
+ * @brief interface bus structure definition
+ * @note  a board with several 1-Wire channels keeps one of these per channel and links it
+ *        to every handle on that channel with DRIVER_DS2431_LINK_USER, so one ops table
+ *        serves all the channels and the callbacks find the data pin through user
  */
-uint8_t ds2431_interface_init(void)
+typedef struct ds2431_interface_bus_s
 {
+    void *port;          /**< gpio port of the data pin */
+    uint32_t pin;        /**< gpio pin of the data pin */
+} ds2431_interface_bus_t;
+
+/**
+ * @brief     get the bus of a user context
+ * @param[in] *user pointer to a user context
+ * @return    pointer to a bus structure
+ * @note      a handle without a user context drives the default bus
+ */
+static ds2431_interface_bus_t *a_ds2431_interface_bus(void *user)
+{
+    static ds2431_interface_bus_t bus;
+    
+    if (user == NULL)
+    {
+        return &bus;
+    }
+    
+    return (ds2431_interface_bus_t *)user;
+}
+
+/**
+ * @brief     interface bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus init failed
+ * @note      user selects the bus
+ */
+uint8_t ds2431_interface_init(void *user)
+{
+    ds2431_interface_bus_t *bus;
+    
+    bus = a_ds2431_interface_bus(user);
+    (void)bus;        /* set bus->pin of bus->port as an open drain output and release it */
+    
     return 0;
 }
 
 /**
- * @brief  interface bus deinit
- * @return status code
- *         - 0 success
- *         - 1 bus deinit failed
- * @note   none
+ * @brief     interface bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus deinit failed
+ * @note      user selects the bus
  */
-uint8_t ds2431_interface_deinit(void)
+uint8_t ds2431_interface_deinit(void *user)
 {
+    ds2431_interface_bus_t *bus;
+    
+    bus = a_ds2431_interface_bus(user);
+    (void)bus;        /* release bus->pin of bus->port */
+    
     return 0;
 }
 
 /**
  * @brief      interface bus read
+ * @param[in]  *user pointer to a user context
  * @param[out] *value pointer to a value buffer
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       user selects the bus
  */
-uint8_t ds2431_interface_read(uint8_t *value)
+uint8_t ds2431_interface_read(void *user, uint8_t *value)
 {
+    ds2431_interface_bus_t *bus;
+    
+    bus = a_ds2431_interface_bus(user);
+    (void)bus;        /* sample bus->pin of bus->port into *value */
+    
     return 0;
 }
 
 /**
  * @brief     interface bus write
+ * @param[in] *user pointer to a user context
  * @param[in] value written value
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      user selects the bus
  */
-uint8_t ds2431_interface_write(uint8_t value)
+uint8_t ds2431_interface_write(void *user, uint8_t value)
 {
+    ds2431_interface_bus_t *bus;
+    
+    bus = a_ds2431_interface_bus(user);
+    (void)bus;        /* drive bus->pin of bus->port low for 0 and release it for 1 */
+    
     return 0;
 }
 
 /**
  * @brief     interface delay ms
+ * @param[in] *user pointer to a user context
  * @param[in] ms time
  * @note      none
  */
-void ds2431_interface_delay_ms(uint32_t ms)
+void ds2431_interface_delay_ms(void *user, uint32_t ms)
 {
     
 }
 
 /**
  * @brief     interface delay us
+ * @param[in] *user pointer to a user context
  * @param[in] us time
  * @note      none
  */
-void ds2431_interface_delay_us(uint32_t us)
+void ds2431_interface_delay_us(void *user, uint32_t us)
 {
     
 }
 
 /**
- * @brief interface enable the interrupt
- * @note  none
+ * @brief     interface enable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
  */
-void ds2431_interface_enable_irq(void)
+void ds2431_interface_enable_irq(void *user)
 {
     
 }
 
 /**
- * @brief interface disable the interrupt
- * @note  none
+ * @brief     interface disable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
  */
-void ds2431_interface_disable_irq(void)
+void ds2431_interface_disable_irq(void *user)
 {
     
 }
 
+/**
+ * @brief     interface get the timestamp
+ * @param[in] *user pointer to a user context
+ * @return    timestamp in us
+ * @note      none
+ */
+uint32_t ds2431_interface_timestamp_us(void *user)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
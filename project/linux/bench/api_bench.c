@@ -0,0 +1,312 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      api_bench.c
+ * @brief     api benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431.h"
+#include "driver_ds2431_interface.h"
+#include "ds2431_model.h"
+#include "delay.h"
+#include "wire.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief api bench definition
+ */
+#define API_BENCH_CALLS        16        /**< calls per row */
+
+/**
+ * @brief api bench api enumeration definition
+ */
+typedef enum
+{
+    API_BENCH_READ        = 0x00,        /**< ds2431_read */
+    API_BENCH_WRITE       = 0x01,        /**< ds2431_write */
+    API_BENCH_CONFIG      = 0x02,        /**< ds2431_read_memory_config */
+    API_BENCH_SEARCH      = 0x03,        /**< ds2431_search_rom */
+} api_bench_api_t;
+
+/**
+ * @brief api bench case structure definition
+ */
+typedef struct api_bench_case_s
+{
+    api_bench_api_t api;        /**< api */
+    const char *name;           /**< api name */
+    uint8_t address;            /**< address */
+    uint8_t len;                /**< size */
+} api_bench_case_t;
+
+/**
+ * @brief api bench counter structure definition
+ */
+typedef struct api_bench_counter_s
+{
+    uint8_t irq_off;              /**< irq disabled flag */
+    uint64_t irq_start_ns;        /**< irq disabled at */
+    uint64_t irq_off_ns;          /**< total irq off time */
+    uint64_t irq_max_ns;          /**< longest irq off window */
+} api_bench_counter_t;
+
+static api_bench_counter_t gs_counter;        /**< irq counter */
+
+/**
+ * @brief     bench disable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      not nested, like the cortex-m primask
+ */
+static void a_api_bench_disable_irq(void *user)
+{
+    if (gs_counter.irq_off == 0)
+    {
+        gs_counter.irq_off = 1;
+        gs_counter.irq_start_ns = delay_get_ns();
+    }
+}
+
+/**
+ * @brief     bench enable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
+ */
+static void a_api_bench_enable_irq(void *user)
+{
+    uint64_t ns;
+    
+    if (gs_counter.irq_off != 0)
+    {
+        gs_counter.irq_off = 0;
+        ns = delay_get_ns() - gs_counter.irq_start_ns;
+        gs_counter.irq_off_ns += ns;
+        if (ns > gs_counter.irq_max_ns)
+        {
+            gs_counter.irq_max_ns = ns;
+        }
+    }
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = a_api_bench_enable_irq,
+    .disable_irq = a_api_bench_disable_irq,
+    .debug_print = ds2431_interface_debug_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+static const api_bench_case_t gs_case[] =        /**< benchmark cases */
+{
+    {API_BENCH_READ, "read", 0x00, 1},
+    {API_BENCH_READ, "read", 0x00, 8},
+    {API_BENCH_READ, "read", 0x00, 32},
+    {API_BENCH_READ, "read", 0x00, 128},
+    {API_BENCH_WRITE, "write", 0x03, 1},
+    {API_BENCH_WRITE, "write", 0x00, 8},
+    {API_BENCH_WRITE, "write", 0x00, 32},
+    {API_BENCH_WRITE, "write", 0x00, 128},
+    {API_BENCH_CONFIG, "read_memory_config", 0x80, 8},
+    {API_BENCH_SEARCH, "search_rom", 0x00, 8},
+};
+
+static const char *const gs_mode_name[] =        /**< mode names */
+{
+    "skip_rom",
+    "overdrive_skip_rom",
+    "match_rom",
+    "overdrive_match_rom",
+    "resume",
+    "overdrive_resume",
+};
+
+/**
+ * @brief     call an api once
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *c pointer to a benchmark case
+ * @param[in] *buf pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 call failed
+ * @note      none
+ */
+static uint8_t a_api_bench_call(ds2431_handle_t *handle, const api_bench_case_t *c, uint8_t *buf)
+{
+    uint8_t num;
+    uint8_t rom[1][8];
+    ds2431_config_control_t config;
+    
+    switch (c->api)
+    {
+        case API_BENCH_READ :
+        {
+            return ds2431_read(handle, c->address, buf, c->len);
+        }
+        case API_BENCH_WRITE :
+        {
+            return ds2431_write(handle, c->address, buf, c->len);
+        }
+        case API_BENCH_CONFIG :
+        {
+            return ds2431_read_memory_config(handle, &config);
+        }
+        default :
+        {
+            num = 1;
+            
+            return ds2431_search_rom(handle, rom, &num);
+        }
+    }
+}
+
+/**
+ * @brief     run one benchmark row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] mode rom mode
+ * @param[in] *c pointer to a benchmark case
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the bus figures are per call, the first call is a warm up
+ */
+static uint8_t a_api_bench_row(ds2431_handle_t *handle, ds2431_mode_t mode, const api_bench_case_t *c)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t buf[128];
+    uint32_t slot;
+    uint32_t reset;
+    uint64_t start_ns;
+    uint64_t bus_ns;
+    uint64_t host_ns;
+    struct timespec t0;
+    struct timespec t1;
+    
+    for (i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = (uint8_t)(i * 7 + 1);
+    }
+    if (a_api_bench_call(handle, c, buf) != 0)
+    {
+        return 1;
+    }
+    
+    res = 0;
+    memset(&gs_counter, 0, sizeof(gs_counter));
+    (void)wire_clear_count();
+    start_ns = delay_get_ns();
+    (void)clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t0);
+    for (i = 0; i < API_BENCH_CALLS; i++)
+    {
+        res |= a_api_bench_call(handle, c, buf);
+    }
+    (void)clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t1);
+    bus_ns = delay_get_ns() - start_ns;
+    host_ns = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000ULL + (uint64_t)t1.tv_nsec - (uint64_t)t0.tv_nsec;
+    (void)wire_get_count(&slot, &reset);
+    
+    printf("%s,%s,%u,%u,%.3f,%.1f,%.1f,%.3f,%.3f,%llu,%s\n",
+           c->name, gs_mode_name[mode], c->len, API_BENCH_CALLS,
+           (double)bus_ns / 1000.0 / API_BENCH_CALLS,
+           (double)slot / API_BENCH_CALLS, (double)reset / API_BENCH_CALLS,
+           (double)gs_counter.irq_off_ns / 1000.0 / API_BENCH_CALLS,
+           (double)gs_counter.irq_max_ns / 1000.0,
+           (unsigned long long)(host_ns / API_BENCH_CALLS),
+           (res == 0) ? "ok" : "fail");
+    
+    return res;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   prints one csv row per api, mode and size,
+ *         the search row is the last one of a mode because it drops the device to standard speed
+ */
+int main(void)
+{
+    uint8_t res;
+    uint8_t mode;
+    uint8_t i;
+    ds2431_handle_t handle;
+    ds2431_model_t *device;
+    
+    (void)delay_init();
+    DRIVER_DS2431_LINK_INIT(&handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&handle, &gs_ops);
+    if (ds2431_init(&handle) != 0)
+    {
+        return 1;
+    }
+    device = wire_get_device(0);
+    if ((device == NULL) || (ds2431_set_rom(&handle, device->rom) != 0))
+    {
+        return 1;
+    }
+    
+    res = 0;
+    printf("api,mode,size,calls,bus_us,slots,resets,irq_off_us,irq_max_us,host_ns,status\n");
+    for (mode = DS2431_MODE_SKIP_ROM; mode <= DS2431_MODE_OVERDRIVE_RESUME; mode++)
+    {
+        /* resume needs a device that was selected by a match rom at the same speed */
+        if ((mode == DS2431_MODE_RESUME) || (mode == DS2431_MODE_OVERDRIVE_RESUME))
+        {
+            if ((ds2431_set_mode(&handle, (mode == DS2431_MODE_RESUME) ? DS2431_MODE_MATCH_ROM :
+                                          DS2431_MODE_OVERDRIVE_MATCH_ROM) != 0) ||
+                (ds2431_read(&handle, 0x00, &i, 1) != 0))
+            {
+                return 1;
+            }
+        }
+        if (ds2431_set_mode(&handle, (ds2431_mode_t)mode) != 0)
+        {
+            return 1;
+        }
+        for (i = 0; i < sizeof(gs_case) / sizeof(gs_case[0]); i++)
+        {
+            res |= a_api_bench_row(&handle, (ds2431_mode_t)mode, &gs_case[i]);
+        }
+    }
+    (void)ds2431_deinit(&handle);
+    
+    return res;
+}
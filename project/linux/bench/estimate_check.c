@@ -0,0 +1,349 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      estimate_check.c
+ * @brief     bus time estimate check source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431.h"
+#include "driver_ds2431_interface.h"
+#include "ds2431_model.h"
+#include "delay.h"
+#include "wire.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief estimate check definition
+ */
+#define ESTIMATE_CHECK_SLACK        8        /**< the estimate may be at most 1/8 over the bus time */
+
+/**
+ * @brief estimate check case structure definition
+ */
+typedef struct estimate_check_case_s
+{
+    ds2431_stats_api_t op;        /**< operation id */
+    const char *name;             /**< case name */
+    uint16_t address;             /**< address */
+    uint16_t len;                 /**< size */
+} estimate_check_case_t;
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = ds2431_interface_debug_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+static const char *const gs_mode[] =        /**< mode names */
+{
+    "skip",
+    "od_skip",
+    "match",
+    "od_match",
+    "resume",
+    "od_resume",
+};
+
+static ds2431_config_control_t gs_config;        /**< config read by the first case */
+
+static const estimate_check_case_t gs_case[] =        /**< check cases, run in order */
+{
+    {DS2431_STATS_API_READ_MEMORY_CONFIG, "read_memory_config", 0x00, 0},
+    {DS2431_STATS_API_READ, "read", 0x00, 1},
+    {DS2431_STATS_API_READ, "read", 0x00, 32},
+    {DS2431_STATS_API_READ, "read", 0x00, 128},
+    {DS2431_STATS_API_READ_MEMORY, "read_memory", 0x10, 16},
+    {DS2431_STATS_API_WRITE, "write", 0x08, 8},
+    {DS2431_STATS_API_WRITE, "write", 0x03, 10},
+    {DS2431_STATS_API_WRITE, "write", 0x10, 24},
+    {DS2431_STATS_API_WRITE_SCRATCHPAD, "write_scratchpad", 0x20, 8},
+    {DS2431_STATS_API_READ_SCRATCHPAD, "read_scratchpad", 0x00, 0},
+    {DS2431_STATS_API_COPY_SCRATCHPAD, "copy_scratchpad", 0x20, 8},
+    {DS2431_STATS_API_WRITE_ROW, "write_row", 0x28, 8},
+    {DS2431_STATS_API_READ, "cache read", 0x00, 32},
+    {DS2431_STATS_API_READ, "cache read", 0x10, 32},
+    {DS2431_STATS_API_WRITE, "cache write", 0x30, 8},
+    {DS2431_STATS_API_WRITE, "write_back", 0x41, 4},
+    {DS2431_STATS_API_WRITE, "write_back", 0x48, 16},
+    {DS2431_STATS_API_FLUSH, "flush", 0x00, 0},
+    {DS2431_STATS_API_WRITE_MEMORY_CONFIG, "write_memory_config", 0x00, 0},
+};
+
+/**
+ * @brief     run one case
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *c pointer to a case
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_estimate_check_run(ds2431_handle_t *handle, const estimate_check_case_t *c)
+{
+    uint8_t res;
+    uint16_t address;
+    uint16_t crc16;
+    uint8_t buf[128];
+    
+    memset(buf, 0, sizeof(buf));
+    switch (c->op)
+    {
+        case DS2431_STATS_API_READ :
+        {
+            return ds2431_read(handle, (uint8_t)c->address, buf, (uint8_t)c->len);
+        }
+        case DS2431_STATS_API_READ_MEMORY :
+        {
+            return ds2431_read_memory(handle, c->address, buf, c->len);
+        }
+        case DS2431_STATS_API_WRITE :
+        {
+            memset(buf, 0xA5 ^ c->address, c->len);
+            
+            return ds2431_write(handle, (uint8_t)c->address, buf, (uint8_t)c->len);
+        }
+        case DS2431_STATS_API_WRITE_SCRATCHPAD :
+        {
+            memset(buf, 0x3C, 8);
+            
+            return ds2431_write_scratchpad(handle, c->address, buf, &crc16);
+        }
+        case DS2431_STATS_API_READ_SCRATCHPAD :
+        {
+            return ds2431_read_scratchpad(handle, &address, buf, &crc16);
+        }
+        case DS2431_STATS_API_COPY_SCRATCHPAD :
+        {
+            return ds2431_copy_scratchpad(handle, c->address);
+        }
+        case DS2431_STATS_API_WRITE_ROW :
+        {
+            memset(buf, 0x69, 8);
+            res = ds2431_write_row_start(handle, (uint8_t)c->address, buf);
+            if (res != 0)
+            {
+                return res;
+            }
+            delay_ms(10);
+            
+            return ds2431_write_row_finish(handle);
+        }
+        case DS2431_STATS_API_READ_MEMORY_CONFIG :
+        {
+            return ds2431_read_memory_config(handle, &gs_config);
+        }
+        case DS2431_STATS_API_WRITE_MEMORY_CONFIG :
+        {
+            return ds2431_write_memory_config(handle, &gs_config);
+        }
+        case DS2431_STATS_API_FLUSH :
+        {
+            return ds2431_flush(handle);
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     prepare the handle for one case
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *c pointer to a case
+ * @param[in] *cache pointer to a ds2431 cache structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 prepare failed
+ * @note      the cache cases attach the cache, the write back cases enable write back,
+ *            the flush keeps both and every other case runs without the cache
+ */
+static uint8_t a_estimate_check_prepare(ds2431_handle_t *handle, const estimate_check_case_t *c, ds2431_cache_t *cache)
+{
+    if (strncmp(c->name, "cache", 5) == 0)
+    {
+        if ((handle->ext->cache == NULL) && (ds2431_set_cache(handle, cache) != 0))
+        {
+            return 1;
+        }
+    }
+    else if (strcmp(c->name, "write_back") == 0)
+    {
+        if ((cache->write_back == 0) && (ds2431_set_write_back(handle, DS2431_BOOL_TRUE, 0, 0) != 0))
+        {
+            return 1;
+        }
+    }
+    else if (c->op != DS2431_STATS_API_FLUSH)
+    {
+        if ((handle->ext->cache != NULL) && (ds2431_set_cache(handle, NULL) != 0))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run every case in one mode
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] mode rom mode
+ * @return    failed case number
+ * @note      resume modes are primed with a match rom at the same speed,
+ *            the memory config is written last, the estimate takes every page
+ *            as eprom mode until the next mode reads the config again
+ */
+static uint32_t a_estimate_check_mode(ds2431_handle_t *handle, ds2431_mode_t mode)
+{
+    uint8_t buf[1];
+    uint32_t i;
+    uint32_t us;
+    uint32_t fail;
+    uint64_t start;
+    uint64_t ns;
+    uint64_t est;
+    const char *check;
+    static ds2431_cache_t cache;
+    
+    fail = 0;
+    if ((mode == DS2431_MODE_RESUME) || (mode == DS2431_MODE_OVERDRIVE_RESUME))
+    {
+        if ((ds2431_set_mode(handle, (mode == DS2431_MODE_RESUME) ? DS2431_MODE_MATCH_ROM :
+                                     DS2431_MODE_OVERDRIVE_MATCH_ROM) != 0) ||
+            (ds2431_read(handle, 0x00, buf, 1) != 0))
+        {
+            return 1;
+        }
+    }
+    if (ds2431_set_mode(handle, mode) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < sizeof(gs_case) / sizeof(gs_case[0]); i++)
+    {
+        if ((a_estimate_check_prepare(handle, &gs_case[i], &cache) != 0) ||
+            (ds2431_estimate_us(handle, gs_case[i].op, gs_case[i].address, gs_case[i].len, &us) != 0))
+        {
+            printf("estimate_check: %s %s setup failed.\n", gs_mode[mode], gs_case[i].name);
+            fail++;
+            
+            continue;
+        }
+        start = delay_get_ns();
+        if (a_estimate_check_run(handle, &gs_case[i]) != 0)
+        {
+            printf("estimate_check: %s %s failed.\n", gs_mode[mode], gs_case[i].name);
+            fail++;
+            
+            continue;
+        }
+        ns = delay_get_ns() - start;
+        est = (uint64_t)us * 1000;
+        check = "ok";
+        if ((est < ns) || ((est - ns) > (est / ESTIMATE_CHECK_SLACK)))
+        {
+            check = "FAIL";
+            fail++;
+        }
+        printf("%-9s %-19s 0x%02X %4u %11u %11.3f %7.2f %s\n",
+               gs_mode[mode], gs_case[i].name, gs_case[i].address, gs_case[i].len, us,
+               (double)ns / 1000.0, (est != 0) ? (100.0 * ((double)est - (double)ns) / (double)est) : 0.0,
+               check);
+    }
+    if ((handle->ext->cache != NULL) && (ds2431_set_cache(handle, NULL) != 0))
+    {
+        fail++;
+    }
+    
+    return fail;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 an estimate is under the bus time, too far over it or a case failed
+ * @note   none
+ */
+int main(void)
+{
+    uint8_t mode;
+    uint32_t fail;
+    ds2431_handle_t handle;
+    ds2431_extension_t ext;
+    ds2431_model_t *device;
+    
+    (void)delay_init();
+    DRIVER_DS2431_LINK_INIT(&handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&handle, &gs_ops);
+    (void)ds2431_set_extension(&handle, &ext);
+    if (ds2431_init(&handle) != 0)
+    {
+        return 1;
+    }
+    device = wire_get_device(0);
+    if ((device == NULL) || (ds2431_set_rom(&handle, device->rom) != 0))
+    {
+        return 1;
+    }
+    
+    fail = 0;
+    printf("%-9s %-19s %4s %4s %11s %11s %7s %s\n",
+           "mode", "case", "addr", "len", "estimate_us", "bus_us", "over_%", "check");
+    for (mode = DS2431_MODE_SKIP_ROM; mode <= DS2431_MODE_OVERDRIVE_RESUME; mode++)
+    {
+        fail += a_estimate_check_mode(&handle, (ds2431_mode_t)mode);
+    }
+    (void)ds2431_deinit(&handle);
+    if (fail != 0)
+    {
+        printf("estimate_check: %u failed cases.\n", fail);
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,416 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      fault_inject.c
+ * @brief     fault injection source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431.h"
+#include "driver_ds2431_interface.h"
+#include "ds2431_model.h"
+#include "delay.h"
+#include "wire.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief fault inject definition
+ */
+#define FAULT_INJECT_ATTEMPT        3             /**< attempts per operation */
+#define FAULT_INJECT_ADDRESS        0x10          /**< target row */
+#define FAULT_INJECT_STUCK_US       1000          /**< stuck low time */
+#define FAULT_INJECT_SEED           0x2431        /**< random seed */
+#define FAULT_INJECT_RANDOM_RUNS    500           /**< random runs per operation */
+
+/**
+ * @brief fault inject operation enumeration definition
+ */
+typedef enum
+{
+    FAULT_INJECT_OP_WRITE      = 0x00,        /**< ds2431_write of one row */
+    FAULT_INJECT_OP_READ       = 0x01,        /**< ds2431_read of one row */
+    FAULT_INJECT_OP_SCRATCHPAD = 0x02,        /**< ds2431_write_scratchpad and ds2431_read_scratchpad */
+    FAULT_INJECT_OP_NUM        = 0x03,        /**< operation number */
+} fault_inject_op_t;
+
+/**
+ * @brief fault inject cost structure definition
+ */
+typedef struct fault_inject_cost_s
+{
+    uint64_t ns;            /**< bus time */
+    uint32_t slot;          /**< time slots */
+    uint32_t reset;         /**< resets */
+    uint8_t hit;            /**< a fault was injected */
+} fault_inject_cost_t;
+
+/**
+ * @brief fault inject result structure definition
+ */
+typedef struct fault_inject_result_s
+{
+    uint32_t runs;               /**< runs */
+    uint32_t hit;                /**< runs with an injected fault */
+    uint32_t detected;           /**< first attempt reported an error */
+    uint32_t silent;             /**< first attempt succeeded with wrong data */
+    uint32_t recovered;          /**< detected and fixed by a retry */
+    uint32_t failed;             /**< still wrong after every attempt */
+    uint64_t extra_ns;           /**< total bus time over the clean cost */
+    uint64_t extra_max_ns;       /**< longest bus time over the clean cost */
+    uint64_t extra_slot;         /**< total slots over the clean cost */
+    uint64_t extra_reset;        /**< total resets over the clean cost */
+} fault_inject_result_t;
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = ds2431_interface_debug_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+static const char *const gs_op_name[FAULT_INJECT_OP_NUM] =        /**< operation names */
+{
+    "write",
+    "read",
+    "scratchpad",
+};
+static ds2431_handle_t gs_handle;        /**< ds2431 handle */
+static uint8_t gs_pattern = 0;           /**< data pattern */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the driver reports every injected fault, the harness counts them instead
+ */
+static void a_fault_inject_print(const char *const fmt, ...)
+{
+    
+}
+
+/**
+ * @brief     run one operation attempt
+ * @param[in] op operation
+ * @param[in] *data pointer to the expected row
+ * @return    status code
+ *            - 0 success with the right data
+ *            - 1 the driver reported an error
+ *            - 2 the driver succeeded with the wrong data
+ * @note      the device model is the ground truth
+ */
+static uint8_t a_fault_inject_attempt(fault_inject_op_t op, uint8_t data[8])
+{
+    uint8_t buf[8];
+    uint16_t address;
+    uint16_t crc16;
+    ds2431_model_t *device;
+    
+    device = wire_get_device(0);
+    if (op == FAULT_INJECT_OP_WRITE)
+    {
+        if (ds2431_write(&gs_handle, FAULT_INJECT_ADDRESS, data, 8) != 0)
+        {
+            return 1;
+        }
+        
+        return (memcmp(&device->memory[FAULT_INJECT_ADDRESS], data, 8) == 0) ? 0 : 2;
+    }
+    else if (op == FAULT_INJECT_OP_READ)
+    {
+        if (ds2431_read(&gs_handle, FAULT_INJECT_ADDRESS, buf, 8) != 0)
+        {
+            return 1;
+        }
+        
+        return (memcmp(&device->memory[FAULT_INJECT_ADDRESS], buf, 8) == 0) ? 0 : 2;
+    }
+    else
+    {
+        if ((ds2431_write_scratchpad(&gs_handle, FAULT_INJECT_ADDRESS, data, &crc16) != 0) ||
+            (ds2431_read_scratchpad(&gs_handle, &address, buf, &crc16) != 0))
+        {
+            return 1;
+        }
+        
+        return ((address == FAULT_INJECT_ADDRESS) && (memcmp(buf, data, 8) == 0)) ? 0 : 2;
+    }
+}
+
+/**
+ * @brief      run one operation with retries
+ * @param[in]  op operation
+ * @param[in]  *fault pointer to the injected faults, NULL is a clean run
+ * @param[out] *cost pointer to a cost buffer
+ * @param[out] *first pointer to the first attempt result buffer
+ * @return     result of the last attempt
+ * @note       the data pattern changes on every run, so a lost write is never hidden
+ */
+static uint8_t a_fault_inject_run(fault_inject_op_t op, const wire_fault_t *fault,
+                                  fault_inject_cost_t *cost, uint8_t *first)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t data[8];
+    uint32_t injected;
+    uint64_t start_ns;
+    
+    gs_pattern++;
+    for (i = 0; i < 8; i++)
+    {
+        data[i] = (uint8_t)(gs_pattern * 31 + i * 7);
+    }
+    
+    /* recover the bus and the device speed from an earlier run */
+    (void)wire_set_fault(NULL);
+    delay_ms(2);
+    (void)ds2431_read(&gs_handle, 0x00, &i, 1);
+    
+    (void)wire_clear_count();
+    (void)wire_set_fault(fault);
+    start_ns = delay_get_ns();
+    res = 1;
+    for (i = 0; (i < FAULT_INJECT_ATTEMPT) && (res != 0); i++)
+    {
+        res = a_fault_inject_attempt(op, data);
+        if (i == 0)
+        {
+            *first = res;
+        }
+        if (res == 2)
+        {
+            break;
+        }
+    }
+    cost->ns = delay_get_ns() - start_ns;
+    (void)wire_get_count(&cost->slot, &cost->reset);
+    (void)wire_get_fault_count(&injected);
+    cost->hit = ((injected != 0) ||
+                 ((fault != NULL) && (fault->copy_fail != wire_get_device(0)->copy_fail))) ? 1 : 0;
+    
+    return res;
+}
+
+/**
+ * @brief      add a run to a result
+ * @param[out] *result pointer to a result structure
+ * @param[in]  *clean pointer to the clean cost
+ * @param[in]  *cost pointer to the run cost
+ * @param[in]  first first attempt result
+ * @param[in]  last last attempt result
+ * @note       none
+ */
+static void a_fault_inject_add(fault_inject_result_t *result, const fault_inject_cost_t *clean,
+                               const fault_inject_cost_t *cost, uint8_t first, uint8_t last)
+{
+    uint64_t extra;
+    
+    result->runs++;
+    result->hit += cost->hit;
+    if (first == 1)
+    {
+        result->detected++;
+        if (last == 0)
+        {
+            result->recovered++;
+        }
+    }
+    else if (first == 2)
+    {
+        result->silent++;
+    }
+    else
+    {
+        
+    }
+    if (last != 0)
+    {
+        result->failed++;
+    }
+    extra = (cost->ns > clean->ns) ? (cost->ns - clean->ns) : 0;
+    result->extra_ns += extra;
+    if (extra > result->extra_max_ns)
+    {
+        result->extra_max_ns = extra;
+    }
+    result->extra_slot += (cost->slot > clean->slot) ? (cost->slot - clean->slot) : 0;
+    result->extra_reset += (cost->reset > clean->reset) ? (cost->reset - clean->reset) : 0;
+}
+
+/**
+ * @brief     print a result row
+ * @param[in] *fault fault name
+ * @param[in] op operation
+ * @param[in] *result pointer to a result structure
+ * @note      the costs are the mean over the detected runs
+ */
+static void a_fault_inject_print_row(const char *fault, fault_inject_op_t op, const fault_inject_result_t *result)
+{
+    uint32_t n;
+    
+    n = (result->detected != 0) ? result->detected : 1;
+    printf("%-9s %-10s %5u %5u %8u %6u %9u %6u %10.1f %10.1f %9.1f %7.2f\n",
+           fault, gs_op_name[op], result->runs, result->hit, result->detected, result->silent,
+           result->recovered, result->failed,
+           (double)result->extra_ns / 1000.0 / n, (double)result->extra_max_ns / 1000.0,
+           (double)result->extra_slot / n, (double)result->extra_reset / n);
+}
+
+/**
+ * @brief     init a fault structure with every fault off
+ * @param[in] *fault pointer to a wire fault structure
+ * @note      none
+ */
+static void a_fault_inject_clear(wire_fault_t *fault)
+{
+    memset(fault, 0, sizeof(wire_fault_t));
+    fault->presence_reset = WIRE_FAULT_OFF;
+    fault->flip_slot = WIRE_FAULT_OFF;
+    fault->stuck_reset = WIRE_FAULT_OFF;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 a clean run failed
+ * @note   every fault class is scheduled at every reset or slot of a clean run,
+ *         then the random run mixes presence loss and bit flips with a fixed seed
+ */
+int main(void)
+{
+    uint8_t op;
+    uint8_t first;
+    uint8_t last;
+    uint32_t i;
+    wire_fault_t fault;
+    fault_inject_cost_t clean;
+    fault_inject_cost_t cost;
+    fault_inject_result_t result;
+    ds2431_ops_t ops;
+    
+    (void)delay_init();
+    ops = gs_ops;
+    ops.debug_print = a_fault_inject_print;
+    DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &ops);
+    if (ds2431_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    printf("fault_inject: %d attempts per operation, clean cost per operation:\n", FAULT_INJECT_ATTEMPT);
+    for (op = 0; op < FAULT_INJECT_OP_NUM; op++)
+    {
+        (void)a_fault_inject_run((fault_inject_op_t)op, NULL, &clean, &first);
+        if (a_fault_inject_run((fault_inject_op_t)op, NULL, &clean, &first) != 0)
+        {
+            printf("fault_inject: clean %s failed.\n", gs_op_name[op]);
+            
+            return 1;
+        }
+        printf("  %-10s %10.1f us %6u slots %3u resets\n", gs_op_name[op], (double)clean.ns / 1000.0, clean.slot, clean.reset);
+    }
+    printf("%-9s %-10s %5s %5s %8s %6s %9s %6s %10s %10s %9s %7s\n",
+           "fault", "op", "runs", "hit", "detected", "silent", "recovered", "failed",
+           "extra_us", "max_us", "ex_slots", "ex_rst");
+    for (op = 0; op < FAULT_INJECT_OP_NUM; op++)
+    {
+        (void)a_fault_inject_run((fault_inject_op_t)op, NULL, &clean, &first);
+        
+        /* presence loss at every reset */
+        memset(&result, 0, sizeof(result));
+        for (i = 0; i < clean.reset; i++)
+        {
+            a_fault_inject_clear(&fault);
+            fault.presence_reset = i;
+            last = a_fault_inject_run((fault_inject_op_t)op, &fault, &cost, &first);
+            a_fault_inject_add(&result, &clean, &cost, first, last);
+        }
+        a_fault_inject_print_row("presence", (fault_inject_op_t)op, &result);
+        
+        /* bit flip at every slot */
+        memset(&result, 0, sizeof(result));
+        for (i = 0; i < clean.slot; i++)
+        {
+            a_fault_inject_clear(&fault);
+            fault.flip_slot = i;
+            last = a_fault_inject_run((fault_inject_op_t)op, &fault, &cost, &first);
+            a_fault_inject_add(&result, &clean, &cost, first, last);
+        }
+        a_fault_inject_print_row("flip", (fault_inject_op_t)op, &result);
+        
+        /* stuck low line after every reset */
+        memset(&result, 0, sizeof(result));
+        for (i = 0; i < clean.reset; i++)
+        {
+            a_fault_inject_clear(&fault);
+            fault.stuck_reset = i;
+            fault.stuck_us = FAULT_INJECT_STUCK_US;
+            last = a_fault_inject_run((fault_inject_op_t)op, &fault, &cost, &first);
+            a_fault_inject_add(&result, &clean, &cost, first, last);
+        }
+        a_fault_inject_print_row("stuck", (fault_inject_op_t)op, &result);
+        
+        /* copy response failure */
+        if (op == FAULT_INJECT_OP_WRITE)
+        {
+            memset(&result, 0, sizeof(result));
+            a_fault_inject_clear(&fault);
+            fault.copy_fail = 1;
+            last = a_fault_inject_run((fault_inject_op_t)op, &fault, &cost, &first);
+            a_fault_inject_add(&result, &clean, &cost, first, last);
+            a_fault_inject_print_row("copy", (fault_inject_op_t)op, &result);
+        }
+        
+        /* random presence loss and bit flips */
+        memset(&result, 0, sizeof(result));
+        a_fault_inject_clear(&fault);
+        fault.seed = FAULT_INJECT_SEED;
+        fault.presence_ppm = 10000;
+        fault.flip_ppm = 1000;
+        for (i = 0; i < FAULT_INJECT_RANDOM_RUNS; i++)
+        {
+            last = a_fault_inject_run((fault_inject_op_t)op, &fault, &cost, &first);
+            a_fault_inject_add(&result, &clean, &cost, first, last);
+            fault.seed = fault.seed * 69069U + 1U;
+        }
+        a_fault_inject_print_row("random", (fault_inject_op_t)op, &result);
+    }
+    (void)ds2431_deinit(&gs_handle);
+    
+    return 0;
+}
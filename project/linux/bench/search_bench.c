@@ -0,0 +1,304 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      search_bench.c
+ * @brief     search benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431.h"
+#include "driver_ds2431_interface.h"
+#include "ds2431_model.h"
+#include "delay.h"
+#include "wire.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief search bench definition
+ */
+#define SEARCH_BENCH_GUARD        0xA5        /**< guard row pattern behind the rom buffer */
+
+/**
+ * @brief search bench layout enumeration definition
+ */
+typedef enum
+{
+    SEARCH_BENCH_LAYOUT_RANDOM = 0x00,        /**< random serial numbers */
+    SEARCH_BENCH_LAYOUT_PREFIX = 0x01,        /**< only the last 2 serial bytes differ */
+} search_bench_layout_t;
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = ds2431_interface_debug_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+static uint32_t gs_seed = 0x2431;        /**< random seed */
+
+/**
+ * @brief  get a pseudo random number
+ * @return random number
+ * @note   fixed seed, so every run benchmarks the same population
+ */
+static uint32_t a_search_bench_random(void)
+{
+    gs_seed = gs_seed * 1103515245U + 12345U;
+    
+    return gs_seed >> 8;
+}
+
+/**
+ * @brief     build a device population
+ * @param[in] *device pointer to a device model array
+ * @param[in] num device number
+ * @param[in] layout population layout
+ * @note      serial numbers are unique
+ */
+static void a_search_bench_populate(ds2431_model_t *device, uint16_t num, search_bench_layout_t layout)
+{
+    uint16_t i;
+    uint16_t j;
+    uint8_t k;
+    uint8_t serial[6];
+    
+    for (i = 0; i < num; i++)
+    {
+        if (layout == SEARCH_BENCH_LAYOUT_PREFIX)
+        {
+            /* shared prefix in search order, the index is in the last 2 serial bytes */
+            memset(serial, 0x5A, 4);
+            serial[4] = (uint8_t)(i & 0xFF);
+            serial[5] = (uint8_t)(i >> 8);
+        }
+        else
+        {
+            /* random serial, drawn again on a collision */
+            do
+            {
+                for (k = 0; k < 6; k++)
+                {
+                    serial[k] = (uint8_t)a_search_bench_random();
+                }
+                for (j = 0; j < i; j++)
+                {
+                    if (memcmp(&device[j].rom[1], serial, 6) == 0)
+                    {
+                        break;
+                    }
+                }
+            } while (j != i);
+        }
+        ds2431_model_init(&device[i], serial);
+    }
+}
+
+/**
+ * @brief     check the found roms
+ * @param[in] *device pointer to a device model array
+ * @param[in] num device number
+ * @param[in] **rom pointer to a rom array
+ * @param[in] found found rom number
+ * @return    status code
+ *            - 0 success
+ *            - 1 a rom is invalid, unknown or found twice
+ * @note      none
+ */
+static uint8_t a_search_bench_check(ds2431_model_t *device, uint16_t num, uint8_t (*rom)[8], uint16_t found)
+{
+    uint16_t i;
+    uint16_t j;
+    
+    for (i = 0; i < found; i++)
+    {
+        if (ds2431_model_crc8(rom[i], 7) != rom[i][7])
+        {
+            return 1;
+        }
+        for (j = 0; j < num; j++)
+        {
+            if (memcmp(device[j].rom, rom[i], 8) == 0)
+            {
+                break;
+            }
+        }
+        if (j == num)
+        {
+            return 1;
+        }
+        for (j = 0; j < i; j++)
+        {
+            if (memcmp(rom[j], rom[i], 8) == 0)
+            {
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run one search on a population
+ * @param[in] num device number
+ * @param[in] layout population layout
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_search_bench_run(uint16_t num, search_bench_layout_t layout)
+{
+    uint8_t res;
+    uint8_t found;
+    uint8_t expect;
+    uint16_t i;
+    uint32_t slot;
+    uint32_t reset;
+    uint64_t start_ns;
+    uint64_t bus_ns;
+    double host_ms;
+    struct timespec t0;
+    struct timespec t1;
+    ds2431_handle_t handle;
+    ds2431_model_t *device;
+    static uint8_t rom[DS2431_MAX_SEARCH_SIZE + 1][8];
+    
+    device = (ds2431_model_t *)malloc(sizeof(ds2431_model_t) * num);
+    if (device == NULL)
+    {
+        return 1;
+    }
+    a_search_bench_populate(device, num, layout);
+    (void)wire_detach_all();
+    for (i = 0; i < num; i++)
+    {
+        (void)wire_attach(&device[i]);
+    }
+    
+    DRIVER_DS2431_LINK_INIT(&handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&handle, &gs_ops);
+    if (ds2431_init(&handle) != 0)
+    {
+        free(device);
+        
+        return 1;
+    }
+    
+    /* one call finds at most DS2431_MAX_SEARCH_SIZE devices */
+    memset(rom, SEARCH_BENCH_GUARD, sizeof(rom));
+    found = DS2431_MAX_SEARCH_SIZE;
+    expect = (num < DS2431_MAX_SEARCH_SIZE) ? (uint8_t)num : DS2431_MAX_SEARCH_SIZE;
+    (void)wire_clear_count();
+    start_ns = delay_get_ns();
+    (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+    res = ds2431_search_rom(&handle, rom, &found);
+    (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+    bus_ns = delay_get_ns() - start_ns;
+    (void)wire_get_count(&slot, &reset);
+    (void)ds2431_deinit(&handle);
+    host_ms = (double)(t1.tv_sec - t0.tv_sec) * 1000.0 + (double)(t1.tv_nsec - t0.tv_nsec) / 1000000.0;
+    
+    for (i = 0; i < 8; i++)
+    {
+        if (rom[DS2431_MAX_SEARCH_SIZE][i] != SEARCH_BENCH_GUARD)
+        {
+            res = 1;
+        }
+    }
+    if ((res == 0) && ((found != expect) || (a_search_bench_check(device, num, rom, found) != 0)))
+    {
+        res = 1;
+    }
+    printf("%-6s %6u %6u %10.3f %10u %8u %10.1f %10.3f %s\n",
+           (layout == SEARCH_BENCH_LAYOUT_PREFIX) ? "prefix" : "random",
+           num, found, (double)bus_ns / 1000000.0, slot, reset,
+           (found != 0) ? (double)slot / found : 0.0, host_ms,
+           (res == 0) ? "ok" : "FAIL");
+    free(device);
+    
+    return res;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the optional argument is the largest population, the default is 4096
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+    uint32_t num;
+    uint32_t max;
+    
+    max = WIRE_MAX_DEVICE;
+    if (argc > 1)
+    {
+        max = (uint32_t)strtoul(argv[1], NULL, 0);
+        if ((max == 0) || (max > WIRE_MAX_DEVICE))
+        {
+            printf("search_bench: population must be 1 - %d.\n", WIRE_MAX_DEVICE);
+            
+            return 1;
+        }
+    }
+    (void)delay_init();
+    
+    res = 0;
+    printf("search_bench: one search call finds at most %d devices.\n", DS2431_MAX_SEARCH_SIZE);
+    printf("%-6s %6s %6s %10s %10s %8s %10s %10s %s\n",
+           "layout", "devs", "found", "bus_ms", "slots", "resets", "slots/rom", "host_ms", "check");
+    for (num = 1; num <= max; num *= 2)
+    {
+        res |= a_search_bench_run((uint16_t)num, SEARCH_BENCH_LAYOUT_RANDOM);
+        res |= a_search_bench_run((uint16_t)num, SEARCH_BENCH_LAYOUT_PREFIX);
+    }
+    if ((max & (max - 1)) != 0)
+    {
+        res |= a_search_bench_run((uint16_t)max, SEARCH_BENCH_LAYOUT_RANDOM);
+        res |= a_search_bench_run((uint16_t)max, SEARCH_BENCH_LAYOUT_PREFIX);
+    }
+    
+    return res;
+}
@@ -0,0 +1,470 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      timing_check.c
+ * @brief     timing conformance check source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431.h"
+#include "driver_ds2431_interface.h"
+#include "ds2431_model.h"
+#include "delay.h"
+#include "wire.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief timing check parameter enumeration definition
+ */
+typedef enum
+{
+    TIMING_RSTL  = 0x00,        /**< reset low time */
+    TIMING_PDH   = 0x01,        /**< presence detect high time */
+    TIMING_W0L   = 0x02,        /**< write 0 low time */
+    TIMING_W1L   = 0x03,        /**< write 1 low time */
+    TIMING_RL    = 0x04,        /**< read low time */
+    TIMING_MSR   = 0x05,        /**< master sample read time */
+    TIMING_REC   = 0x06,        /**< recovery time */
+    TIMING_NUM   = 0x07,        /**< parameter number */
+} timing_param_t;
+
+/**
+ * @brief timing check limit structure definition
+ */
+typedef struct timing_limit_s
+{
+    const char *name;          /**< parameter name */
+    uint64_t min_ns[2];        /**< standard and overdrive min */
+    uint64_t max_ns[2];        /**< standard and overdrive max, 0 is unbounded */
+} timing_limit_t;
+
+/**
+ * @brief timing check stat structure definition
+ */
+typedef struct timing_stat_s
+{
+    uint32_t count;           /**< checked edges */
+    uint32_t violation;       /**< out of range */
+    uint64_t min_ns;          /**< shortest measured */
+    uint64_t max_ns;          /**< longest measured */
+    int64_t slack_ns;         /**< smallest distance to a limit */
+} timing_stat_t;
+
+/**
+ * @brief timing check phase enumeration definition
+ */
+typedef enum
+{
+    TIMING_PHASE_IDLE     = 0x00,        /**< nothing pending */
+    TIMING_PHASE_PRESENCE = 0x01,        /**< after a reset */
+    TIMING_PHASE_SLOT     = 0x02,        /**< after a time slot */
+} timing_phase_t;
+
+/**
+ * @brief timing check recorder structure definition
+ */
+typedef struct timing_recorder_s
+{
+    uint8_t level;              /**< master level */
+    uint8_t od;                 /**< overdrive speed of the current pulse */
+    uint8_t phase;              /**< timing phase */
+    uint8_t presence;           /**< presence seen */
+    uint8_t sampled;            /**< the slot was sampled */
+    uint64_t fall_ns;           /**< last falling edge */
+    uint64_t rise_ns;           /**< last rising edge */
+    uint64_t low_ns;            /**< low time of the pending slot */
+    uint64_t sample_ns;         /**< sample time of the pending slot */
+    uint32_t edges;             /**< recorded master edges */
+    uint32_t samples;           /**< recorded bus samples */
+} timing_recorder_t;
+
+/**
+ * @brief ds2431 datasheet limits, delta is 0 on the simulated bus
+ */
+static const timing_limit_t gs_limit[TIMING_NUM] =
+{
+    {"tRSTL", {480000, 48000}, {640000, 80000}},
+    {"tPDH",  {15000, 2000},   {60000, 6000}},
+    {"tW0L",  {60000, 6000},   {120000, 16000}},
+    {"tW1L",  {5000, 1000},    {15000, 2000}},
+    {"tRL",   {5000, 1000},    {15000, 2000}},
+    {"tMSR",  {5000, 1000},    {15000, 2000}},
+    {"tREC",  {5000, 2000},    {0, 0}},
+};
+static timing_stat_t gs_stat[TIMING_NUM][2];        /**< stats per parameter and speed */
+static timing_recorder_t gs_rec;                    /**< recorder */
+
+/**
+ * @brief     check one measurement
+ * @param[in] param timing parameter
+ * @param[in] od overdrive speed
+ * @param[in] ns measured time
+ * @param[in] min_ns min time
+ * @note      max comes from the limit table
+ */
+static void a_timing_check(timing_param_t param, uint8_t od, uint64_t ns, uint64_t min_ns)
+{
+    int64_t slack;
+    uint64_t max_ns;
+    timing_stat_t *stat;
+    
+    stat = &gs_stat[param][od];
+    max_ns = gs_limit[param].max_ns[od];
+    slack = (int64_t)ns - (int64_t)min_ns;
+    if ((max_ns != 0) && (((int64_t)max_ns - (int64_t)ns) < slack))
+    {
+        slack = (int64_t)max_ns - (int64_t)ns;
+    }
+    if ((stat->count == 0) || (ns < stat->min_ns))
+    {
+        stat->min_ns = ns;
+    }
+    if ((stat->count == 0) || (ns > stat->max_ns))
+    {
+        stat->max_ns = ns;
+    }
+    if ((stat->count == 0) || (slack < stat->slack_ns))
+    {
+        stat->slack_ns = slack;
+    }
+    if (slack < 0)
+    {
+        stat->violation++;
+    }
+    stat->count++;
+}
+
+/**
+ * @brief close the pending phase
+ * @note  a slot is a read slot if the master sampled it and a write slot otherwise
+ */
+static void a_timing_close(void)
+{
+    uint8_t od;
+    
+    od = gs_rec.od;
+    if (gs_rec.phase == TIMING_PHASE_PRESENCE)
+    {
+        if (gs_rec.presence == 0)
+        {
+            gs_stat[TIMING_PDH][od].count++;
+            gs_stat[TIMING_PDH][od].violation++;
+        }
+    }
+    else if (gs_rec.phase == TIMING_PHASE_SLOT)
+    {
+        if (gs_rec.sampled != 0)
+        {
+            a_timing_check(TIMING_RL, od, gs_rec.low_ns, gs_limit[TIMING_RL].min_ns[od]);
+            a_timing_check(TIMING_MSR, od, gs_rec.sample_ns, gs_rec.low_ns);
+        }
+        else if (gs_rec.low_ns < gs_limit[TIMING_W1L].max_ns[od])
+        {
+            a_timing_check(TIMING_W1L, od, gs_rec.low_ns, gs_limit[TIMING_W1L].min_ns[od]);
+        }
+        else
+        {
+            a_timing_check(TIMING_W0L, od, gs_rec.low_ns, gs_limit[TIMING_W0L].min_ns[od]);
+        }
+    }
+    else
+    {
+        
+    }
+    gs_rec.phase = TIMING_PHASE_IDLE;
+}
+
+/**
+ * @brief     record a master edge
+ * @param[in] level new master level
+ * @note      the speed is taken from the device when the line falls
+ */
+static void a_timing_edge(uint8_t level)
+{
+    uint8_t od;
+    uint64_t now;
+    uint64_t low;
+    ds2431_model_t *device;
+    
+    now = delay_get_ns();
+    level = (level != 0) ? 1 : 0;
+    if (level == gs_rec.level)
+    {
+        return;
+    }
+    gs_rec.level = level;
+    gs_rec.edges++;
+    if (level == 0)
+    {
+        if (gs_rec.phase == TIMING_PHASE_SLOT)
+        {
+            a_timing_check(TIMING_REC, gs_rec.od, now - gs_rec.rise_ns, gs_limit[TIMING_REC].min_ns[gs_rec.od]);
+        }
+        a_timing_close();
+        device = wire_get_device(0);
+        gs_rec.od = ((device != NULL) && (device->overdrive != 0)) ? 1 : 0;
+        gs_rec.fall_ns = now;
+        
+        return;
+    }
+    
+    od = gs_rec.od;
+    low = now - gs_rec.fall_ns;
+    gs_rec.rise_ns = now;
+    if (low > gs_limit[TIMING_W0L].max_ns[od])
+    {
+        /* a standard reset also leaves overdrive */
+        if ((od != 0) && (low >= gs_limit[TIMING_RSTL].min_ns[0]))
+        {
+            od = 0;
+            gs_rec.od = 0;
+        }
+        a_timing_check(TIMING_RSTL, od, low, gs_limit[TIMING_RSTL].min_ns[od]);
+        gs_rec.phase = TIMING_PHASE_PRESENCE;
+        gs_rec.presence = 0;
+        
+        return;
+    }
+    gs_rec.phase = TIMING_PHASE_SLOT;
+    gs_rec.low_ns = low;
+    gs_rec.sampled = 0;
+}
+
+/**
+ * @brief     record a bus sample
+ * @param[in] value sampled level
+ * @note      none
+ */
+static void a_timing_sample(uint8_t value)
+{
+    uint64_t now;
+    
+    now = delay_get_ns();
+    gs_rec.samples++;
+    if ((gs_rec.phase == TIMING_PHASE_PRESENCE) && (gs_rec.presence == 0) && (value == 0))
+    {
+        gs_rec.presence = 1;
+        a_timing_check(TIMING_PDH, gs_rec.od, now - gs_rec.rise_ns, gs_limit[TIMING_PDH].min_ns[gs_rec.od]);
+    }
+    else if ((gs_rec.phase == TIMING_PHASE_SLOT) && (gs_rec.sampled == 0))
+    {
+        gs_rec.sampled = 1;
+        gs_rec.sample_ns = now - gs_rec.fall_ns;
+    }
+    else
+    {
+        
+    }
+}
+
+/**
+ * @brief     recording bus write
+ * @param[in] *user pointer to a user context
+ * @param[in] value written value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_timing_bus_write(void *user, uint8_t value)
+{
+    a_timing_edge(value);
+    
+    return ds2431_interface_write(user, value);
+}
+
+/**
+ * @brief      recording bus read
+ * @param[in]  *user pointer to a user context
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_timing_bus_read(void *user, uint8_t *value)
+{
+    uint8_t res;
+    
+    res = ds2431_interface_read(user, value);
+    a_timing_sample(*value);
+    
+    return res;
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = a_timing_bus_read,
+    .bus_write = a_timing_bus_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = ds2431_interface_debug_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+/**
+ * @brief     run the workload in one mode
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] mode rom mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      resume modes are primed with a match rom at the same speed
+ */
+static uint8_t a_timing_workload(ds2431_handle_t *handle, ds2431_mode_t mode)
+{
+    uint8_t i;
+    uint8_t num;
+    uint8_t buf[8];
+    uint8_t rom[1][8];
+    ds2431_config_control_t config;
+    
+    if ((mode == DS2431_MODE_RESUME) || (mode == DS2431_MODE_OVERDRIVE_RESUME))
+    {
+        if ((ds2431_set_mode(handle, (mode == DS2431_MODE_RESUME) ? DS2431_MODE_MATCH_ROM :
+                                     DS2431_MODE_OVERDRIVE_MATCH_ROM) != 0) ||
+            (ds2431_read(handle, 0x00, buf, 1) != 0))
+        {
+            return 1;
+        }
+    }
+    if (ds2431_set_mode(handle, mode) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < 8; i++)
+    {
+        buf[i] = (uint8_t)(0x5A ^ (i * 0x11) ^ mode);
+    }
+    if ((ds2431_write(handle, 0x08, buf, 8) != 0) ||
+        (ds2431_read(handle, 0x08, buf, 8) != 0) ||
+        (ds2431_read_memory_config(handle, &config) != 0))
+    {
+        return 1;
+    }
+    num = 1;
+    
+    return ds2431_search_rom(handle, rom, &num);
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 a limit is violated or the workload failed
+ * @note   none
+ */
+int main(void)
+{
+    uint8_t res;
+    uint8_t mode;
+    uint8_t od;
+    uint8_t i;
+    uint32_t violation;
+    char max[16];
+    timing_stat_t *stat;
+    ds2431_handle_t handle;
+    ds2431_model_t *device;
+    
+    (void)delay_init();
+    memset(&gs_rec, 0, sizeof(gs_rec));
+    gs_rec.level = 1;
+    memset(gs_stat, 0, sizeof(gs_stat));
+    DRIVER_DS2431_LINK_INIT(&handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&handle, &gs_ops);
+    if (ds2431_init(&handle) != 0)
+    {
+        return 1;
+    }
+    device = wire_get_device(0);
+    if ((device == NULL) || (ds2431_set_rom(&handle, device->rom) != 0))
+    {
+        return 1;
+    }
+    res = 0;
+    for (mode = DS2431_MODE_SKIP_ROM; mode <= DS2431_MODE_OVERDRIVE_RESUME; mode++)
+    {
+        if (a_timing_workload(&handle, (ds2431_mode_t)mode) != 0)
+        {
+            printf("timing_check: workload failed in mode %d.\n", mode);
+            res = 1;
+        }
+    }
+    (void)ds2431_deinit(&handle);
+    a_timing_close();
+    
+    violation = 0;
+    printf("timing_check: %u edges, %u samples.\n", gs_rec.edges, gs_rec.samples);
+    printf("%-6s %-9s %9s %9s %9s %9s %7s %9s %s\n",
+           "param", "speed", "min_us", "max_us", "meas_min", "meas_max", "count", "slack_us", "check");
+    for (i = 0; i < TIMING_NUM; i++)
+    {
+        for (od = 0; od < 2; od++)
+        {
+            stat = &gs_stat[i][od];
+            if (stat->count == 0)
+            {
+                printf("%-6s %-9s %9.3f %9s %9s %9s %7u %9s %s\n",
+                       gs_limit[i].name, (od != 0) ? "overdrive" : "standard",
+                       (double)gs_limit[i].min_ns[od] / 1000.0, "-", "-", "-", 0U, "-", "unused");
+                
+                continue;
+            }
+            if (gs_limit[i].max_ns[od] != 0)
+            {
+                (void)snprintf(max, sizeof(max), "%.3f", (double)gs_limit[i].max_ns[od] / 1000.0);
+            }
+            else
+            {
+                (void)snprintf(max, sizeof(max), "-");
+            }
+            printf("%-6s %-9s %9.3f %9s %9.3f %9.3f %7u %9.3f %s\n",
+                   gs_limit[i].name, (od != 0) ? "overdrive" : "standard",
+                   (double)gs_limit[i].min_ns[od] / 1000.0, max,
+                   (double)stat->min_ns / 1000.0, (double)stat->max_ns / 1000.0,
+                   stat->count, (double)stat->slack_ns / 1000.0,
+                   (stat->violation == 0) ? "ok" : "FAIL");
+            violation += stat->violation;
+        }
+    }
+    if (violation != 0)
+    {
+        printf("timing_check: %u violations.\n", violation);
+        res = 1;
+    }
+    
+    return res;
+}
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      linux_driver_ds2431_interface.c
+ * @brief     linux driver ds2431 interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_interface.h"
+#include "delay.h"
+#include "wire.h"
+#include "lane.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+/**
+ * @brief     interface bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus init failed
+ * @note      user NULL selects the shared wire bus, any other user is a lane_t
+ */
+uint8_t ds2431_interface_init(void *user)
+{
+    if (user != NULL)
+    {
+        return 0;
+    }
+    
+    return wire_init();
+}
+
+/**
+ * @brief     interface bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus deinit failed
+ * @note      user NULL selects the shared wire bus, any other user is a lane_t
+ */
+uint8_t ds2431_interface_deinit(void *user)
+{
+    if (user != NULL)
+    {
+        return 0;
+    }
+    
+    return wire_deinit();
+}
+
+/**
+ * @brief      interface bus read
+ * @param[in]  *user pointer to a user context
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       user NULL selects the shared wire bus, any other user is a lane_t
+ */
+uint8_t ds2431_interface_read(void *user, uint8_t *value)
+{
+    if (user != NULL)
+    {
+        return lane_read((lane_t *)user, value);
+    }
+    
+    return wire_read(value);
+}
+
+/**
+ * @brief     interface bus write
+ * @param[in] *user pointer to a user context
+ * @param[in] value written value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      user NULL selects the shared wire bus, any other user is a lane_t
+ */
+uint8_t ds2431_interface_write(void *user, uint8_t value)
+{
+    if (user != NULL)
+    {
+        return lane_write((lane_t *)user, value);
+    }
+    
+    return wire_write(value);
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] *user pointer to a user context
+ * @param[in] ms time
+ * @note      none
+ */
+void ds2431_interface_delay_ms(void *user, uint32_t ms)
+{
+    delay_ms(ms);
+}
+
+/**
+ * @brief     interface delay us
+ * @param[in] *user pointer to a user context
+ * @param[in] us time
+ * @note      none
+ */
+void ds2431_interface_delay_us(void *user, uint32_t us)
+{
+    delay_us(us);
+}
+
+/**
+ * @brief     interface enable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
+ */
+void ds2431_interface_enable_irq(void *user)
+{
+    
+}
+
+/**
+ * @brief     interface disable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
+ */
+void ds2431_interface_disable_irq(void *user)
+{
+    
+}
+
+/**
+ * @brief     interface get the timestamp
+ * @param[in] *user pointer to a user context
+ * @return    timestamp in us
+ * @note      none
+ */
+uint32_t ds2431_interface_timestamp_us(void *user)
+{
+    return (uint32_t)(delay_get_ns() / 1000);
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void ds2431_interface_debug_print(const char *const fmt, ...)
+{
+    va_list args;
+    
+    va_start(args, fmt);
+    (void)vprintf((char const *)fmt, args);
+    va_end(args);
+}
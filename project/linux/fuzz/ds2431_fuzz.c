@@ -0,0 +1,638 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      ds2431_fuzz.c
+ * @brief     ds2431 fuzz target source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431.h"
+#include "driver_ds2431_interface.h"
+#include "ds2431_model.h"
+#include "delay.h"
+#include "wire.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief fuzz definition
+ */
+#define FUZZ_MAX_BUS_OPS        200000        /**< bus operations per api call before it is a hang */
+#define FUZZ_MAX_CALLS          8             /**< api calls per input */
+#define FUZZ_MODE_NUM           6             /**< rom modes */
+#define FUZZ_OUT_SIZE           0x90          /**< output bytes per call */
+
+/**
+ * @brief fuzz api enumeration definition
+ */
+typedef enum
+{
+    FUZZ_API_READ                 = 0x00,        /**< ds2431_read */
+    FUZZ_API_WRITE                = 0x01,        /**< ds2431_write */
+    FUZZ_API_READ_MEMORY_CONFIG   = 0x02,        /**< ds2431_read_memory_config */
+    FUZZ_API_WRITE_MEMORY_CONFIG  = 0x03,        /**< ds2431_write_memory_config */
+    FUZZ_API_WRITE_SCRATCHPAD     = 0x04,        /**< ds2431_write_scratchpad */
+    FUZZ_API_READ_SCRATCHPAD      = 0x05,        /**< ds2431_read_scratchpad */
+    FUZZ_API_COPY_SCRATCHPAD      = 0x06,        /**< ds2431_copy_scratchpad */
+    FUZZ_API_READ_MEMORY          = 0x07,        /**< ds2431_read_memory */
+    FUZZ_API_SEARCH_ROM           = 0x08,        /**< ds2431_search_rom */
+    FUZZ_API_NUM                  = 0x09,        /**< api number */
+} fuzz_api_t;
+
+/**
+ * @brief fuzz call structure definition
+ */
+typedef struct fuzz_call_s
+{
+    uint8_t api;              /**< api */
+    uint8_t address;          /**< address lsb */
+    uint8_t address_hi;       /**< address msb */
+    uint8_t len;              /**< length */
+    uint8_t seed;             /**< data seed */
+} fuzz_call_t;
+
+/**
+ * @brief fuzz input structure definition
+ */
+typedef struct fuzz_input_s
+{
+    const uint8_t *data;        /**< input data */
+    size_t size;                /**< input size */
+    size_t pos;                 /**< byte position */
+    uint8_t bit;                /**< bit position */
+} fuzz_input_t;
+
+static fuzz_input_t gs_input;             /**< input stream */
+static uint32_t gs_bus_ops;               /**< bus operations of the current call */
+static const char *gs_api_name[FUZZ_API_NUM] =        /**< api names */
+{
+    "read", "write", "read_memory_config", "write_memory_config", "write_scratchpad",
+    "read_scratchpad", "copy_scratchpad", "read_memory", "search_rom",
+};
+
+/**
+ * @brief  get the next input byte
+ * @return input byte, 0 once the input is exhausted
+ * @note   none
+ */
+static uint8_t a_fuzz_byte(void)
+{
+    if (gs_input.pos >= gs_input.size)
+    {
+        return 0;
+    }
+    
+    return gs_input.data[gs_input.pos++];
+}
+
+/**
+ * @brief count a bus operation
+ * @note  every reset loop and slot loop is bounded, so a call that keeps the bus busy is a hang
+ */
+static void a_fuzz_bus_op(void)
+{
+    gs_bus_ops++;
+    if (gs_bus_ops > FUZZ_MAX_BUS_OPS)
+    {
+        fprintf(stderr, "ds2431_fuzz: more than %d bus operations in one call.\n", FUZZ_MAX_BUS_OPS);
+        abort();
+    }
+}
+
+/**
+ * @brief     fuzz bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_fuzz_bus_init(void *user)
+{
+    return 0;
+}
+
+/**
+ * @brief     fuzz bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_fuzz_bus_deinit(void *user)
+{
+    return 0;
+}
+
+/**
+ * @brief      fuzz bus read
+ * @param[in]  *user pointer to a user context
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ * @note       every sample is the next input bit, a released line once the input is exhausted
+ */
+static uint8_t a_fuzz_bus_read(void *user, uint8_t *value)
+{
+    a_fuzz_bus_op();
+    if (gs_input.pos >= gs_input.size)
+    {
+        *value = 1;
+        
+        return 0;
+    }
+    *value = (gs_input.data[gs_input.pos] >> gs_input.bit) & 0x01;
+    gs_input.bit++;
+    if (gs_input.bit == 8)
+    {
+        gs_input.bit = 0;
+        gs_input.pos++;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     fuzz bus write
+ * @param[in] *user pointer to a user context
+ * @param[in] value written value
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_fuzz_bus_write(void *user, uint8_t value)
+{
+    a_fuzz_bus_op();
+    
+    return 0;
+}
+
+/**
+ * @brief     fuzz delay ms
+ * @param[in] *user pointer to a user context
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_fuzz_delay_ms(void *user, uint32_t ms)
+{
+    a_fuzz_bus_op();
+}
+
+/**
+ * @brief     fuzz delay us
+ * @param[in] *user pointer to a user context
+ * @param[in] us time
+ * @note      none
+ */
+static void a_fuzz_delay_us(void *user, uint32_t us)
+{
+    a_fuzz_bus_op();
+}
+
+/**
+ * @brief     fuzz irq
+ * @param[in] *user pointer to a user context
+ * @note      none
+ */
+static void a_fuzz_irq(void *user)
+{
+
+}
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_fuzz_print(const char *const fmt, ...)
+{
+
+}
+
+static const ds2431_ops_t gs_raw_ops =        /**< ops on the fuzzed bus */
+{
+    .bus_init = a_fuzz_bus_init,
+    .bus_deinit = a_fuzz_bus_deinit,
+    .bus_read = a_fuzz_bus_read,
+    .bus_write = a_fuzz_bus_write,
+    .delay_ms = a_fuzz_delay_ms,
+    .delay_us = a_fuzz_delay_us,
+    .enable_irq = a_fuzz_irq,
+    .disable_irq = a_fuzz_irq,
+    .debug_print = a_fuzz_print,
+};
+
+static const ds2431_ops_t gs_model_ops =        /**< ops on the device model */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_fuzz_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+/**
+ * @brief      call one api
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  *call pointer to a fuzz call structure
+ * @param[out] *out pointer to a FUZZ_OUT_SIZE output buffer
+ * @return     api status code
+ * @note       data buffers are allocated with the exact length, so an overrun is caught by the sanitizer
+ */
+static uint8_t a_fuzz_call(ds2431_handle_t *handle, const fuzz_call_t *call, uint8_t out[FUZZ_OUT_SIZE])
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t num;
+    uint8_t data[8];
+    uint8_t *buf;
+    uint16_t address;
+    uint16_t crc16;
+    uint8_t (*rom)[8];
+    ds2431_config_control_t config;
+    
+    memset(out, 0, FUZZ_OUT_SIZE);
+    address = (uint16_t)((call->address_hi << 8) | call->address);
+    for (i = 0; i < 8; i++)
+    {
+        data[i] = (uint8_t)(call->seed * 37 + i * 11);
+    }
+    gs_bus_ops = 0;
+    switch (call->api % FUZZ_API_NUM)
+    {
+        case FUZZ_API_READ :
+        case FUZZ_API_WRITE :
+        case FUZZ_API_READ_MEMORY :
+        {
+            buf = (uint8_t *)malloc((call->len != 0) ? call->len : 1);
+            if (buf == NULL)
+            {
+                return 0xFF;
+            }
+            for (i = 0; i < call->len; i++)
+            {
+                buf[i] = (uint8_t)(call->seed + i * 13);
+            }
+            if ((call->api % FUZZ_API_NUM) == FUZZ_API_READ)
+            {
+                res = ds2431_read(handle, call->address, buf, call->len);
+            }
+            else if ((call->api % FUZZ_API_NUM) == FUZZ_API_WRITE)
+            {
+                res = ds2431_write(handle, call->address, buf, call->len);
+            }
+            else
+            {
+                res = ds2431_read_memory(handle, address, buf, call->len);
+            }
+            memcpy(out, buf, (call->len < FUZZ_OUT_SIZE) ? call->len : FUZZ_OUT_SIZE);
+            free(buf);
+            
+            return res;
+        }
+        case FUZZ_API_READ_MEMORY_CONFIG :
+        {
+            memset(&config, 0, sizeof(config));
+            res = ds2431_read_memory_config(handle, &config);
+            memcpy(out, &config, sizeof(config));
+            
+            return res;
+        }
+        case FUZZ_API_WRITE_MEMORY_CONFIG :
+        {
+            /* keep most of the pages open, locking everything makes the rest of the input dull */
+            memset(&config, 0, sizeof(config));
+            config.page0_protection_control = ((call->seed & 0x03) == 1) ? 0x55 : 0x00;
+            config.page1_protection_control = ((call->seed & 0x0C) == 4) ? 0xAA : 0x00;
+            config.page2_protection_control = ((call->seed & 0x30) == 0x10) ? 0x55 : 0x00;
+            config.page3_protection_control = 0x00;
+            config.copy_protection = 0x00;
+            config.factory_byte = 0x55;
+            config.user_byte_0 = call->len;
+            config.user_byte_1 = call->address;
+            
+            return ds2431_write_memory_config(handle, &config);
+        }
+        case FUZZ_API_WRITE_SCRATCHPAD :
+        {
+            crc16 = 0;
+            res = ds2431_write_scratchpad(handle, address, data, &crc16);
+            out[0] = (uint8_t)(crc16 & 0xFF);
+            out[1] = (uint8_t)(crc16 >> 8);
+            
+            return res;
+        }
+        case FUZZ_API_READ_SCRATCHPAD :
+        {
+            address = 0;
+            crc16 = 0;
+            memset(data, 0, 8);
+            res = ds2431_read_scratchpad(handle, &address, data, &crc16);
+            out[0] = (uint8_t)(address & 0xFF);
+            out[1] = (uint8_t)(address >> 8);
+            out[2] = (uint8_t)(crc16 & 0xFF);
+            out[3] = (uint8_t)(crc16 >> 8);
+            memcpy(&out[4], data, 8);
+            
+            return res;
+        }
+        case FUZZ_API_COPY_SCRATCHPAD :
+        {
+            return ds2431_copy_scratchpad(handle, address);
+        }
+        default :
+        {
+            num = (uint8_t)(call->len % 4);
+            rom = (uint8_t (*)[8])malloc(sizeof(uint8_t) * 8 * ((num != 0) ? num : 1));
+            if (rom == NULL)
+            {
+                return 0xFF;
+            }
+            memset(rom, 0, sizeof(uint8_t) * 8 * ((num != 0) ? num : 1));
+            res = ds2431_search_rom(handle, rom, &num);
+            out[0] = num;
+            memcpy(&out[1], rom, sizeof(uint8_t) * 8 * ((num != 0) ? ((num < 4) ? num : 4) : 1));
+            free(rom);
+            
+            return res;
+        }
+    }
+}
+
+/**
+ * @brief      parse the api calls
+ * @param[out] *call pointer to a fuzz call array
+ * @param[in]  num call number
+ * @note       none
+ */
+static void a_fuzz_parse_calls(fuzz_call_t *call, uint8_t num)
+{
+    uint8_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        call[i].api = a_fuzz_byte();
+        call[i].address = a_fuzz_byte();
+        call[i].address_hi = ((a_fuzz_byte() & 0x0F) == 0) ? 0x01 : 0x00;
+        call[i].len = a_fuzz_byte();
+        call[i].seed = a_fuzz_byte();
+    }
+}
+
+/**
+ * @brief     run the driver on a bus that answers with the input bits
+ * @param[in] mode rom mode
+ * @note      the driver must never overrun a buffer or keep the bus busy without bound
+ */
+static void a_fuzz_raw(uint8_t mode)
+{
+    uint8_t i;
+    uint8_t num;
+    uint8_t rom[8];
+    uint8_t out[FUZZ_OUT_SIZE];
+    fuzz_call_t call[FUZZ_MAX_CALLS];
+    ds2431_handle_t handle;
+    
+    for (i = 0; i < 8; i++)
+    {
+        rom[i] = a_fuzz_byte();
+    }
+    num = (uint8_t)(a_fuzz_byte() % FUZZ_MAX_CALLS + 1);
+    a_fuzz_parse_calls(call, num);
+    
+    DRIVER_DS2431_LINK_INIT(&handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&handle, &gs_raw_ops);
+    gs_bus_ops = 0;
+    if (ds2431_init(&handle) != 0)
+    {
+        return;
+    }
+    (void)ds2431_set_mode(&handle, (ds2431_mode_t)mode);
+    (void)ds2431_set_rom(&handle, rom);
+    for (i = 0; i < num; i++)
+    {
+        (void)a_fuzz_call(&handle, &call[i], out);
+    }
+    (void)ds2431_deinit(&handle);
+}
+
+/**
+ * @brief     run the same calls in every mode on the device model
+ * @param[in] protect page protection byte
+ * @note      the modes only differ in how the device is selected,
+ *            so every status code, every output and the final memory must agree
+ */
+static void a_fuzz_differential(uint8_t protect)
+{
+    uint8_t i;
+    uint8_t mode;
+    uint8_t num;
+    uint8_t pattern;
+    uint8_t res[FUZZ_MODE_NUM][FUZZ_MAX_CALLS];
+    static uint8_t out[FUZZ_MODE_NUM][FUZZ_MAX_CALLS][FUZZ_OUT_SIZE];
+    static uint8_t memory[FUZZ_MODE_NUM][DS2431_MODEL_MEMORY_SIZE];
+    const uint8_t serial[6] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+    fuzz_call_t call[FUZZ_MAX_CALLS];
+    ds2431_model_t model;
+    ds2431_handle_t handle;
+    uint8_t prime;
+    
+    pattern = a_fuzz_byte();
+    num = (uint8_t)(a_fuzz_byte() % FUZZ_MAX_CALLS + 1);
+    a_fuzz_parse_calls(call, num);
+    
+    for (mode = 0; mode < FUZZ_MODE_NUM; mode++)
+    {
+        /* identical device for every mode */
+        ds2431_model_init(&model, serial);
+        for (i = 0; i < 0x80; i++)
+        {
+            model.memory[i] = (uint8_t)(pattern + i * 3);
+        }
+        model.memory[0x80] = ((protect & 0x03) == 1) ? 0x55 : 0x00;
+        model.memory[0x81] = ((protect & 0x0C) == 4) ? 0xAA : 0x00;
+        model.memory[0x84] = ((protect & 0xF0) == 0x50) ? 0x55 : 0x00;
+        (void)wire_detach_all();
+        (void)wire_attach(&model);
+        
+        DRIVER_DS2431_LINK_INIT(&handle, ds2431_handle_t);
+        DRIVER_DS2431_LINK_OPS(&handle, &gs_model_ops);
+        if ((ds2431_init(&handle) != 0) || (ds2431_set_rom(&handle, model.rom) != 0))
+        {
+            fprintf(stderr, "ds2431_fuzz: init failed in mode %d.\n", mode);
+            abort();
+        }
+        
+        /* select the device once at the speed of the mode, resume needs it */
+        (void)ds2431_set_mode(&handle, ((mode == DS2431_MODE_OVERDRIVE_SKIP_ROM) ||
+                                        (mode == DS2431_MODE_OVERDRIVE_MATCH_ROM) ||
+                                        (mode == DS2431_MODE_OVERDRIVE_RESUME)) ?
+                                        DS2431_MODE_OVERDRIVE_MATCH_ROM : DS2431_MODE_MATCH_ROM);
+        if (ds2431_read(&handle, 0x00, &prime, 1) != 0)
+        {
+            fprintf(stderr, "ds2431_fuzz: select failed in mode %d.\n", mode);
+            abort();
+        }
+        (void)ds2431_set_mode(&handle, (ds2431_mode_t)mode);
+        for (i = 0; i < num; i++)
+        {
+            res[mode][i] = a_fuzz_call(&handle, &call[i], out[mode][i]);
+            
+            /* a search drops the device to standard speed and clears the selection */
+            if ((call[i].api % FUZZ_API_NUM) == FUZZ_API_SEARCH_ROM)
+            {
+                break;
+            }
+        }
+        (void)ds2431_deinit(&handle);
+        memcpy(memory[mode], model.memory, DS2431_MODEL_MEMORY_SIZE);
+        
+        if (mode == 0)
+        {
+            continue;
+        }
+        for (i = 0; i < num; i++)
+        {
+            if ((res[mode][i] != res[0][i]) ||
+                (memcmp(out[mode][i], out[0][i], FUZZ_OUT_SIZE) != 0))
+            {
+                fprintf(stderr, "ds2431_fuzz: call %d %s returns %d in mode %d and %d in mode 0.\n",
+                        i, gs_api_name[call[i].api % FUZZ_API_NUM], res[mode][i], mode, res[0][i]);
+                abort();
+            }
+            if ((call[i].api % FUZZ_API_NUM) == FUZZ_API_SEARCH_ROM)
+            {
+                break;
+            }
+        }
+        if (memcmp(memory[mode], memory[0], DS2431_MODEL_MEMORY_SIZE) != 0)
+        {
+            fprintf(stderr, "ds2431_fuzz: memory differs between mode %d and mode 0.\n", mode);
+            abort();
+        }
+    }
+    (void)wire_detach_all();
+}
+
+/**
+ * @brief     libfuzzer entry
+ * @param[in] *data pointer to the input
+ * @param[in] size input size
+ * @return    0
+ * @note      the first byte chooses the fuzzed bus or the differential run on the device model
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    uint8_t select;
+    
+    gs_input.data = data;
+    gs_input.size = size;
+    gs_input.pos = 0;
+    gs_input.bit = 0;
+    select = a_fuzz_byte();
+    if ((select & 0x80) == 0)
+    {
+        a_fuzz_raw((uint8_t)(select % FUZZ_MODE_NUM));
+    }
+    else
+    {
+        a_fuzz_differential(select);
+    }
+    
+    return 0;
+}
+
+#ifdef DS2431_FUZZ_STANDALONE
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 an input file can't be read
+ * @note      replays the input files, or runs pseudo random inputs from a fixed seed
+ *            when the compiler has no libfuzzer
+ */
+int main(int argc, char **argv)
+{
+    int i;
+    size_t size;
+    uint32_t n;
+    uint32_t runs;
+    uint32_t seed;
+    FILE *fp;
+    static uint8_t buf[4096];
+    
+    if ((argc > 1) && (strncmp(argv[1], "-runs=", 6) != 0))
+    {
+        for (i = 1; i < argc; i++)
+        {
+            fp = fopen(argv[i], "rb");
+            if (fp == NULL)
+            {
+                fprintf(stderr, "ds2431_fuzz: can't open %s.\n", argv[i]);
+                
+                return 1;
+            }
+            size = fread(buf, 1, sizeof(buf), fp);
+            (void)fclose(fp);
+            (void)LLVMFuzzerTestOneInput(buf, size);
+        }
+        printf("ds2431_fuzz: replayed %d inputs.\n", argc - 1);
+        
+        return 0;
+    }
+    
+    runs = (argc > 1) ? (uint32_t)strtoul(argv[1] + 6, NULL, 0) : 10000;
+    seed = 0x2431;
+    for (n = 0; n < runs; n++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        size = (seed >> 8) % 512;
+        for (i = 0; i < (int)size; i++)
+        {
+            seed = seed * 1103515245U + 12345U;
+            buf[i] = (uint8_t)(seed >> 16);
+        }
+        (void)LLVMFuzzerTestOneInput(buf, size);
+    }
+    printf("ds2431_fuzz: %u random inputs passed.\n", runs);
+    
+    return 0;
+}
+
+#endif
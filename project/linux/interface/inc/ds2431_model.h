@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      ds2431_model.h
+ * @brief     ds2431 model header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DS2431_MODEL_H
+#define DS2431_MODEL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup ds2431_model ds2431 model function
+ * @brief    ds2431 software device model modules
+ * @{
+ */
+
+/**
+ * @brief ds2431 model size definition
+ */
+#define DS2431_MODEL_MEMORY_SIZE        0x90        /**< 0x00 - 0x7F memory, 0x80 - 0x8F config */
+#define DS2431_MODEL_TX_SIZE            0xA0        /**< transmit buffer size */
+
+/**
+ * @brief ds2431 model timing definition
+ * @note  all times are in ns, standard speed first and overdrive speed second
+ */
+#define DS2431_MODEL_RSTL_NS            480000        /**< min reset low time */
+#define DS2431_MODEL_RSTL_OD_NS         48000         /**< min overdrive reset low time */
+#define DS2431_MODEL_PDH_NS             30000         /**< presence detect high time */
+#define DS2431_MODEL_PDH_OD_NS          3000          /**< overdrive presence detect high time */
+#define DS2431_MODEL_PDL_NS             120000        /**< presence detect low time */
+#define DS2431_MODEL_PDL_OD_NS          10000         /**< overdrive presence detect low time */
+#define DS2431_MODEL_W0L_MAX_NS         120000        /**< max write 0 low time */
+#define DS2431_MODEL_W0L_MAX_OD_NS      16000         /**< max overdrive write 0 low time */
+#define DS2431_MODEL_SAMPLE_NS          15000         /**< the slave samples a written bit here */
+#define DS2431_MODEL_SAMPLE_OD_NS       2000          /**< the slave samples a written bit here in overdrive */
+#define DS2431_MODEL_HOLD_NS            30000         /**< a transmitted 0 is held this long */
+#define DS2431_MODEL_HOLD_OD_NS         3000          /**< a transmitted 0 is held this long in overdrive */
+#define DS2431_MODEL_PROG_NS            10000000      /**< max programming time */
+
+/**
+ * @brief ds2431 model state enumeration definition
+ */
+typedef enum
+{
+    DS2431_MODEL_STATE_IDLE              = 0x00,        /**< wait for a reset */
+    DS2431_MODEL_STATE_ROM               = 0x01,        /**< receive a rom command */
+    DS2431_MODEL_STATE_MATCH             = 0x02,        /**< receive a rom to match */
+    DS2431_MODEL_STATE_SEARCH            = 0x03,        /**< search rom triplets */
+    DS2431_MODEL_STATE_READ_ROM          = 0x04,        /**< transmit the rom */
+    DS2431_MODEL_STATE_FUNCTION          = 0x05,        /**< receive a function command */
+    DS2431_MODEL_STATE_WRITE_SCRATCHPAD  = 0x06,        /**< receive the target address and data */
+    DS2431_MODEL_STATE_COPY_SCRATCHPAD   = 0x07,        /**< receive the authorization pattern */
+    DS2431_MODEL_STATE_READ_MEMORY       = 0x08,        /**< receive the target address */
+    DS2431_MODEL_STATE_TX                = 0x09,        /**< transmit the buffer then 1s */
+    DS2431_MODEL_STATE_PROGRAM           = 0x0A,        /**< 1s while programming then alternating 1s and 0s */
+} ds2431_model_state_t;
+
+/**
+ * @brief ds2431 model structure definition
+ */
+typedef struct ds2431_model_s
+{
+    uint8_t rom[8];                                   /**< family code, serial number and crc8 */
+    uint8_t memory[DS2431_MODEL_MEMORY_SIZE];         /**< eeprom and config */
+    uint8_t scratchpad[8];                            /**< scratchpad */
+    uint8_t ta1;                                      /**< target address lsb */
+    uint8_t ta2;                                      /**< target address msb */
+    uint8_t es;                                       /**< ending offset and status */
+    uint8_t overdrive;                                /**< overdrive speed flag */
+    uint8_t resume;                                   /**< resume flag */
+    uint8_t state;                                    /**< protocol state */
+    uint8_t count;                                    /**< bytes in the current state */
+    uint8_t mismatch;                                 /**< match rom mismatch flag */
+    uint8_t shift;                                    /**< receive shift register */
+    uint8_t bits;                                     /**< bits in the shift register */
+    uint8_t search_index;                             /**< search rom bit index */
+    uint8_t search_phase;                             /**< search rom triplet phase */
+    uint16_t crc;                                     /**< running crc16 */
+    uint8_t tx[DS2431_MODEL_TX_SIZE];                 /**< transmit buffer */
+    uint8_t tx_len;                                   /**< transmit buffer length */
+    uint8_t tx_pos;                                   /**< transmit buffer position */
+    uint8_t tx_byte;                                  /**< byte being transmitted */
+    uint8_t tx_bits;                                  /**< bits left in tx_byte */
+    uint8_t slot_tx;                                  /**< the slave transmits in the current slot */
+    uint64_t fall_ns;                                 /**< master falling edge time */
+    uint64_t drive_start_ns;                          /**< the slave pulls the line low from here */
+    uint64_t drive_end_ns;                            /**< the slave releases the line here */
+    uint64_t prog_end_ns;                             /**< programming ends here */
+    uint64_t prog_ns;                                 /**< programming time */
+    uint32_t resets;                                  /**< detected resets */
+    uint32_t programs;                                /**< row programs */
+    uint32_t copy_fail;                               /**< upcoming copies that fail without programming */
+} ds2431_model_t;
+
+/**
+ * @brief     initialize a device model
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] *serial pointer to a 6 byte serial number
+ * @note      the memory is erased to 0xFF, every page is open and the factory byte is 0x55
+ */
+void ds2431_model_init(ds2431_model_t *model, const uint8_t serial[6]);
+
+/**
+ * @brief     the master pulls the line low
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] now_ns current time
+ * @note      none
+ */
+void ds2431_model_fall(ds2431_model_t *model, uint64_t now_ns);
+
+/**
+ * @brief     the master releases the line
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] now_ns current time
+ * @note      the low time decides between a reset and a time slot
+ */
+void ds2431_model_rise(ds2431_model_t *model, uint64_t now_ns);
+
+/**
+ * @brief     get the line level driven by the device
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] now_ns current time
+ * @return    0 if the device pulls the line low, 1 if it is released
+ * @note      none
+ */
+uint8_t ds2431_model_level(ds2431_model_t *model, uint64_t now_ns);
+
+/**
+ * @brief     get the crc8 of a buffer
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc8
+ * @note      none
+ */
+uint8_t ds2431_model_crc8(const uint8_t *data, uint8_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      lane.h
+ * @brief     lane header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef LANE_H
+#define LANE_H
+
+#include "ds2431_model.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup lane lane function
+ * @brief    lane function modules
+ * @{
+ */
+
+/**
+ * @brief lane structure definition
+ * @note  a lane is a bus of its own with one device model, so several handles
+ *        can run on independent buses that share the virtual clock
+ */
+typedef struct lane_s
+{
+    ds2431_model_t device;        /**< the device on the lane */
+    uint8_t level;                /**< master level */
+    uint8_t cut;                  /**< the device is disconnected */
+} lane_t;
+
+/**
+ * @brief     initialize a lane
+ * @param[in] *lane pointer to a lane structure
+ * @param[in] *serial pointer to a 6 byte serial number
+ * @note      the device is connected and erased
+ */
+void lane_init(lane_t *lane, const uint8_t serial[6]);
+
+/**
+ * @brief      lane read data
+ * @param[in]  *lane pointer to a lane structure
+ * @param[out] *value pointer to a read data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the line is the wired-and of the master and the device
+ */
+uint8_t lane_read(lane_t *lane, uint8_t *value);
+
+/**
+ * @brief     lane write data
+ * @param[in] *lane pointer to a lane structure
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ * @note      a disconnected device sees no edge
+ */
+uint8_t lane_write(lane_t *lane, uint8_t value);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      wire.h
+ * @brief     wire header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include "ds2431_model.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup wire wire function
+ * @brief    wire function modules
+ * @{
+ */
+
+/**
+ * @brief wire max device definition
+ */
+#define WIRE_MAX_DEVICE        4096              /**< max attached device models */
+#define WIRE_FAULT_OFF         0xFFFFFFFFU       /**< fault index that never matches */
+
+/**
+ * @brief wire fault structure definition
+ * @note  reset and slot indexes count from the last wire_clear_count
+ */
+typedef struct wire_fault_s
+{
+    uint32_t presence_reset;        /**< reset whose presence pulse is lost */
+    uint32_t flip_slot;             /**< slot whose bit is flipped in both directions */
+    uint32_t stuck_reset;           /**< reset after which the line is stuck low */
+    uint32_t stuck_us;              /**< stuck low time in us */
+    uint32_t copy_fail;             /**< upcoming copies that every device fails */
+    uint32_t seed;                  /**< random seed */
+    uint32_t presence_ppm;          /**< random presence loss rate per reset */
+    uint32_t flip_ppm;              /**< random bit flip rate per slot */
+} wire_fault_t;
+
+/**
+ * @brief  wire bus init
+ * @return status code
+ *         - 0 success
+ * @note   a default device model is attached if none is attached
+ */
+uint8_t wire_init(void);
+
+/**
+ * @brief  wire bus deint
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_deinit(void);
+
+/**
+ * @brief      wire bus read data
+ * @param[out] *value pointer to a read data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the line is the wired-and of the master and every device
+ */
+uint8_t wire_read(uint8_t *value);
+
+/**
+ * @brief     wire bus write data
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t wire_write(uint8_t value);
+
+/**
+ * @brief     attach a device model to the bus
+ * @param[in] *model pointer to a ds2431 model structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 the bus is full
+ * @note      none
+ */
+uint8_t wire_attach(ds2431_model_t *model);
+
+/**
+ * @brief  detach every device model
+ * @return status code
+ *         - 0 success
+ * @note   the next wire_init attaches the default device again
+ */
+uint8_t wire_detach_all(void);
+
+/**
+ * @brief     get an attached device model
+ * @param[in] index device index
+ * @return    pointer to the device model or NULL
+ * @note      none
+ */
+ds2431_model_t *wire_get_device(uint16_t index);
+
+/**
+ * @brief      get the bus counters
+ * @param[out] *slot pointer to a time slot number buffer
+ * @param[out] *reset pointer to a reset number buffer
+ * @return     status code
+ *             - 0 success
+ * @note       a low pulse counts as a reset if a device answers it as one
+ */
+uint8_t wire_get_count(uint32_t *slot, uint32_t *reset);
+
+/**
+ * @brief     set the injected faults
+ * @param[in] *fault pointer to a wire fault structure, NULL clears every fault
+ * @return    status code
+ *            - 0 success
+ * @note      copy_fail is handed to every attached device
+ */
+uint8_t wire_set_fault(const wire_fault_t *fault);
+
+/**
+ * @brief      get the injected fault number
+ * @param[out] *injected pointer to an injected fault number buffer
+ * @return     status code
+ *             - 0 success
+ * @note       copy failures are counted by the devices
+ */
+uint8_t wire_get_fault_count(uint32_t *injected);
+
+/**
+ * @brief  clear the bus counters
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_clear_count(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      delay.c
+ * @brief     delay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "delay.h"
+
+/**
+ * @brief virtual clock in ns
+ */
+static uint64_t gs_now_ns = 0;
+
+/**
+ * @brief  delay clock init
+ * @return status code
+ *         - 0 success
+ * @note   the clock is virtual, a delay advances it without sleeping
+ */
+uint8_t delay_init(void)
+{
+    gs_now_ns = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     delay us
+ * @param[in] us time
+ * @note      none
+ */
+void delay_us(uint32_t us)
+{
+    gs_now_ns += (uint64_t)us * 1000;
+}
+
+/**
+ * @brief     delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+void delay_ms(uint32_t ms)
+{
+    gs_now_ns += (uint64_t)ms * 1000000;
+}
+
+/**
+ * @brief  get the virtual clock
+ * @return current time in ns
+ * @note   none
+ */
+uint64_t delay_get_ns(void)
+{
+    return gs_now_ns;
+}
@@ -0,0 +1,600 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      ds2431_model.c
+ * @brief     ds2431 model source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ds2431_model.h"
+#include <string.h>
+
+/**
+ * @brief ds2431 model command definition
+ */
+#define MODEL_CMD_SEARCH_ROM                 0xF0        /**< search rom command */
+#define MODEL_CMD_READ_ROM                   0x33        /**< read rom command */
+#define MODEL_CMD_MATCH_ROM                  0x55        /**< match rom command */
+#define MODEL_CMD_OVERDRIVE_MATCH_ROM        0x69        /**< overdrive match rom command */
+#define MODEL_CMD_SKIP_ROM                   0xCC        /**< skip rom command */
+#define MODEL_CMD_OVERDRIVE_SKIP_ROM         0x3C        /**< overdrive skip rom command */
+#define MODEL_CMD_RESUME                     0xA5        /**< resume command */
+#define MODEL_CMD_WRITE_SCRATCHPAD           0x0F        /**< write scratchpad command */
+#define MODEL_CMD_READ_SCRATCHPAD            0xAA        /**< read scratchpad command */
+#define MODEL_CMD_COPY_SCRATCHPAD            0x55        /**< copy scratchpad command */
+#define MODEL_CMD_READ_MEMORY                0xF0        /**< read memory command */
+
+/**
+ * @brief ds2431 model config definition
+ */
+#define MODEL_CONFIG_EPROM_MODE              0xAA        /**< eprom mode */
+#define MODEL_CONFIG_WRITE_PROTECT_MODE      0x55        /**< write protect mode */
+#define MODEL_ES_AA                          0x80        /**< authorization accepted flag */
+#define MODEL_ES_PF                          0x20        /**< partial byte flag */
+
+/**
+ * @brief     crc16 update
+ * @param[in] crc input crc16
+ * @param[in] data input data
+ * @return    calculated crc16
+ * @note      none
+ */
+static uint16_t a_model_crc16_update(uint16_t crc, uint8_t data)
+{
+    uint8_t i;
+    
+    for (i = 0; i < 8; i++)                                /* 8 bits */
+    {
+        if (((crc ^ data) & 0x01) != 0)                    /* check lsb */
+        {
+            crc = (uint16_t)((crc >> 1) ^ 0xA001U);        /* shift and xor */
+        }
+        else
+        {
+            crc >>= 1;                                     /* shift */
+        }
+        data >>= 1;                                        /* next bit */
+    }
+    
+    return crc;                                            /* return crc */
+}
+
+/**
+ * @brief     get the crc8 of a buffer
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc8
+ * @note      none
+ */
+uint8_t ds2431_model_crc8(const uint8_t *data, uint8_t len)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t crc;
+    uint8_t byte;
+    
+    crc = 0;                                               /* init 0 */
+    for (i = 0; i < len; i++)                              /* every byte */
+    {
+        byte = data[i];                                    /* get byte */
+        for (j = 0; j < 8; j++)                            /* 8 bits */
+        {
+            if (((crc ^ byte) & 0x01) != 0)                /* check lsb */
+            {
+                crc = (uint8_t)((crc >> 1) ^ 0x8C);        /* shift and xor */
+            }
+            else
+            {
+                crc >>= 1;                                 /* shift */
+            }
+            byte >>= 1;                                    /* next bit */
+        }
+    }
+    
+    return crc;                                            /* return crc */
+}
+
+/**
+ * @brief     start transmitting the buffer
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] state transmit state
+ * @note      none
+ */
+static void a_model_tx_start(ds2431_model_t *model, uint8_t state)
+{
+    model->state = state;        /* set state */
+    model->tx_pos = 0;           /* from the start */
+    model->tx_bits = 0;          /* load on the next slot */
+}
+
+/**
+ * @brief     copy the scratchpad into the memory
+ * @param[in] *model pointer to a ds2431 model structure
+ * @return    1 if the row was accepted, 0 if it is protected
+ * @note      eprom mode pages keep the bitwise and of the old and the new data,
+ *            locked config bytes keep their value and 0x85 - 0x8F are read only
+ */
+static uint8_t a_model_copy(ds2431_model_t *model)
+{
+    uint8_t i;
+    uint8_t control;
+    uint16_t address;
+    
+    address = (uint16_t)(((model->ta2 << 8) | model->ta1) & ~0x07);                                          /* row address */
+    if (address >= 0x80)                                                                                     /* config row */
+    {
+        control = model->memory[0x84];                                                                       /* copy protection */
+        if ((address > 0x80) || (control == MODEL_CONFIG_EPROM_MODE) ||
+            (control == MODEL_CONFIG_WRITE_PROTECT_MODE))                                                    /* check protection */
+        {
+            return 0;                                                                                        /* protected */
+        }
+        for (i = 0; i < 5; i++)                                                                              /* control bytes */
+        {
+            control = model->memory[0x80 + i];                                                               /* get control */
+            if ((control != MODEL_CONFIG_EPROM_MODE) && (control != MODEL_CONFIG_WRITE_PROTECT_MODE))        /* check lock */
+            {
+                model->memory[0x80 + i] = model->scratchpad[i];                                              /* write control */
+            }
+        }
+        model->memory[0x86] = model->scratchpad[6];                                                          /* user byte 0 */
+        model->memory[0x87] = model->scratchpad[7];                                                          /* user byte 1 */
+        
+        return 1;                                                                                            /* accepted */
+    }
+    control = model->memory[0x80 + address / 32];                                                            /* page control */
+    if (control == MODEL_CONFIG_WRITE_PROTECT_MODE)                                                          /* write protected */
+    {
+        return 0;                                                                                            /* protected */
+    }
+    for (i = 0; i < 8; i++)                                                                                  /* 8 bytes */
+    {
+        if (control == MODEL_CONFIG_EPROM_MODE)                                                              /* eprom mode */
+        {
+            model->memory[address + i] &= model->scratchpad[i];                                              /* bits can only be cleared */
+        }
+        else
+        {
+            model->memory[address + i] = model->scratchpad[i];                                               /* program */
+        }
+    }
+    
+    return 1;                                                                                                /* accepted */
+}
+
+/**
+ * @brief     handle a received byte
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] byte received byte
+ * @param[in] now_ns current time
+ * @note      none
+ */
+static void a_model_rx_byte(ds2431_model_t *model, uint8_t byte, uint64_t now_ns)
+{
+    uint8_t i;
+    uint8_t offset;
+    uint16_t address;
+    
+    switch (model->state)
+    {
+        case DS2431_MODEL_STATE_ROM :
+        {
+            if (byte == MODEL_CMD_READ_ROM)                                                           /* read rom */
+            {
+                memcpy(model->tx, model->rom, 8);                                                     /* rom */
+                model->tx_len = 8;                                                                    /* 8 bytes */
+                model->resume = 0;                                                                    /* clear resume */
+                a_model_tx_start(model, DS2431_MODEL_STATE_READ_ROM);                                 /* transmit */
+            }
+            else if ((byte == MODEL_CMD_MATCH_ROM) || (byte == MODEL_CMD_OVERDRIVE_MATCH_ROM))        /* match rom */
+            {
+                if (byte == MODEL_CMD_OVERDRIVE_MATCH_ROM)                                            /* overdrive */
+                {
+                    model->overdrive = 1;                                                             /* overdrive speed */
+                }
+                model->state = DS2431_MODEL_STATE_MATCH;                                              /* match */
+                model->count = 0;                                                                     /* init 0 */
+                model->mismatch = 0;                                                                  /* init 0 */
+            }
+            else if ((byte == MODEL_CMD_SKIP_ROM) || (byte == MODEL_CMD_OVERDRIVE_SKIP_ROM))          /* skip rom */
+            {
+                if (byte == MODEL_CMD_OVERDRIVE_SKIP_ROM)                                             /* overdrive */
+                {
+                    model->overdrive = 1;                                                             /* overdrive speed */
+                }
+                model->resume = 0;                                                                    /* clear resume */
+                model->state = DS2431_MODEL_STATE_FUNCTION;                                           /* selected */
+            }
+            else if (byte == MODEL_CMD_RESUME)                                                        /* resume */
+            {
+                model->state = (model->resume != 0) ? DS2431_MODEL_STATE_FUNCTION :
+                                                      DS2431_MODEL_STATE_IDLE;                        /* check resume */
+            }
+            else if (byte == MODEL_CMD_SEARCH_ROM)                                                    /* search rom */
+            {
+                model->state = DS2431_MODEL_STATE_SEARCH;                                             /* search */
+                model->search_index = 0;                                                              /* first bit */
+                model->search_phase = 0;                                                              /* send the bit */
+            }
+            else
+            {
+                model->state = DS2431_MODEL_STATE_IDLE;                                               /* unknown command */
+            }
+            
+            break;
+        }
+        case DS2431_MODEL_STATE_MATCH :
+        {
+            if (byte != model->rom[model->count])                                                     /* compare */
+            {
+                model->mismatch = 1;                                                                  /* mismatch */
+            }
+            model->count++;                                                                           /* count++ */
+            if (model->count == 8)                                                                    /* whole rom */
+            {
+                model->resume = (model->mismatch == 0) ? 1 : 0;                                       /* set resume */
+                model->state = (model->mismatch == 0) ? DS2431_MODEL_STATE_FUNCTION :
+                                                        DS2431_MODEL_STATE_IDLE;                      /* selected or not */
+            }
+            
+            break;
+        }
+        case DS2431_MODEL_STATE_FUNCTION :
+        {
+            model->count = 0;                                                                         /* init 0 */
+            if (byte == MODEL_CMD_WRITE_SCRATCHPAD)                                                   /* write scratchpad */
+            {
+                model->crc = a_model_crc16_update(0, byte);                                           /* crc of the command */
+                model->state = DS2431_MODEL_STATE_WRITE_SCRATCHPAD;                                   /* receive */
+            }
+            else if (byte == MODEL_CMD_READ_SCRATCHPAD)                                               /* read scratchpad */
+            {
+                model->crc = a_model_crc16_update(0, byte);                                           /* crc of the command */
+                model->tx[0] = model->ta1;                                                            /* ta1 */
+                model->tx[1] = model->ta2;                                                            /* ta2 */
+                model->tx[2] = model->es;                                                             /* e/s */
+                model->tx_len = 3;                                                                    /* 3 bytes */
+                for (i = (uint8_t)(model->ta1 & 0x07); i <= (model->es & 0x07); i++)                  /* t to e */
+                {
+                    model->tx[model->tx_len++] = model->scratchpad[i];                                /* data */
+                }
+                for (i = 0; i < model->tx_len; i++)                                                   /* crc */
+                {
+                    model->crc = a_model_crc16_update(model->crc, model->tx[i]);                      /* update */
+                }
+                model->tx[model->tx_len++] = (uint8_t)(~model->crc & 0xFF);                           /* inverted crc lsb */
+                model->tx[model->tx_len++] = (uint8_t)((~model->crc >> 8) & 0xFF);                    /* inverted crc msb */
+                a_model_tx_start(model, DS2431_MODEL_STATE_TX);                                       /* transmit */
+            }
+            else if (byte == MODEL_CMD_COPY_SCRATCHPAD)                                               /* copy scratchpad */
+            {
+                model->state = DS2431_MODEL_STATE_COPY_SCRATCHPAD;                                    /* receive */
+            }
+            else if (byte == MODEL_CMD_READ_MEMORY)                                                   /* read memory */
+            {
+                model->state = DS2431_MODEL_STATE_READ_MEMORY;                                        /* receive */
+            }
+            else
+            {
+                model->state = DS2431_MODEL_STATE_IDLE;                                               /* unknown command */
+            }
+            
+            break;
+        }
+        case DS2431_MODEL_STATE_WRITE_SCRATCHPAD :
+        {
+            model->crc = a_model_crc16_update(model->crc, byte);                                      /* update crc */
+            if (model->count == 0)                                                                    /* ta1 */
+            {
+                model->ta1 = byte;                                                                    /* set ta1 */
+            }
+            else if (model->count == 1)                                                               /* ta2 */
+            {
+                model->ta2 = byte;                                                                    /* set ta2 */
+                model->es = (uint8_t)(MODEL_ES_PF | (model->ta1 & 0x07));                             /* no data yet */
+                address = (uint16_t)((model->ta2 << 8) | model->ta1);                                 /* target address */
+                if (address >= DS2431_MODEL_MEMORY_SIZE)                                              /* check address */
+                {
+                    model->state = DS2431_MODEL_STATE_IDLE;                                           /* invalid address */
+                }
+            }
+            else
+            {
+                offset = (uint8_t)((model->ta1 & 0x07) + model->count - 2);                           /* scratchpad offset */
+                model->scratchpad[offset] = byte;                                                     /* set data */
+                model->es = offset;                                                                   /* ending offset */
+                if (offset == 7)                                                                      /* end of the scratchpad */
+                {
+                    model->tx[0] = (uint8_t)(~model->crc & 0xFF);                                     /* inverted crc lsb */
+                    model->tx[1] = (uint8_t)((~model->crc >> 8) & 0xFF);                              /* inverted crc msb */
+                    model->tx_len = 2;                                                                /* 2 bytes */
+                    a_model_tx_start(model, DS2431_MODEL_STATE_TX);                                   /* transmit */
+                    
+                    break;
+                }
+            }
+            model->count++;                                                                           /* count++ */
+            
+            break;
+        }
+        case DS2431_MODEL_STATE_COPY_SCRATCHPAD :
+        {
+            model->tx[model->count] = byte;                                                           /* save pattern */
+            model->count++;                                                                           /* count++ */
+            if (model->count < 3)                                                                     /* ta1, ta2 and e/s */
+            {
+                break;                                                                                /* wait */
+            }
+            if ((model->tx[0] != model->ta1) || (model->tx[1] != model->ta2) ||
+                (model->tx[2] != model->es) || ((model->es & MODEL_ES_PF) != 0))                      /* check authorization */
+            {
+                model->state = DS2431_MODEL_STATE_IDLE;                                               /* rejected, reads 1s */
+                
+                break;
+            }
+            if (model->copy_fail != 0)                                                                /* injected failure */
+            {
+                model->copy_fail--;                                                                   /* copy_fail-- */
+                model->state = DS2431_MODEL_STATE_IDLE;                                               /* no response, reads 1s */
+                
+                break;
+            }
+            if (a_model_copy(model) == 0)                                                             /* copy */
+            {
+                model->state = DS2431_MODEL_STATE_IDLE;                                               /* protected, reads 1s */
+                
+                break;
+            }
+            model->es |= MODEL_ES_AA;                                                                 /* set aa */
+            model->programs++;                                                                        /* programs++ */
+            model->prog_end_ns = now_ns + model->prog_ns;                                             /* programming time */
+            model->tx_bits = 0;                                                                       /* load on the next slot */
+            model->state = DS2431_MODEL_STATE_PROGRAM;                                                /* program */
+            
+            break;
+        }
+        case DS2431_MODEL_STATE_READ_MEMORY :
+        {
+            if (model->count == 0)                                                                    /* ta1 */
+            {
+                model->ta1 = byte;                                                                    /* set ta1 */
+                model->count++;                                                                       /* count++ */
+                
+                break;
+            }
+            model->ta2 = byte;                                                                        /* set ta2 */
+            address = (uint16_t)((model->ta2 << 8) | model->ta1);                                     /* target address */
+            model->tx_len = 0;                                                                        /* init 0 */
+            while (address < DS2431_MODEL_MEMORY_SIZE)                                                /* to the end */
+            {
+                model->tx[model->tx_len++] = model->memory[address++];                                /* data */
+            }
+            a_model_tx_start(model, DS2431_MODEL_STATE_TX);                                           /* transmit */
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     get the next bit the device transmits
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] now_ns current time
+ * @return    transmitted bit
+ * @note      none
+ */
+static uint8_t a_model_tx_bit(ds2431_model_t *model, uint64_t now_ns)
+{
+    uint8_t bit;
+    
+    if (model->state == DS2431_MODEL_STATE_SEARCH)                                              /* search rom */
+    {
+        bit = (model->rom[model->search_index / 8] >> (model->search_index % 8)) & 0x01;        /* rom bit */
+        
+        return (model->search_phase == 0) ? bit : (uint8_t)(bit ^ 0x01);                        /* bit or complement */
+    }
+    if (model->tx_bits == 0)                                                                    /* load a byte */
+    {
+        if (model->state == DS2431_MODEL_STATE_PROGRAM)                                         /* program */
+        {
+            model->tx_byte = (now_ns >= model->prog_end_ns) ? 0xAA : 0xFF;                      /* done or busy */
+        }
+        else if (model->tx_pos < model->tx_len)                                                 /* check buffer */
+        {
+            model->tx_byte = model->tx[model->tx_pos++];                                        /* next byte */
+        }
+        else
+        {
+            model->tx_byte = 0xFF;                                                              /* 1s */
+        }
+        model->tx_bits = 8;                                                                     /* 8 bits */
+    }
+    
+    return model->tx_byte & 0x01;                                                               /* lsb first */
+}
+
+/**
+ * @brief     initialize a device model
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] *serial pointer to a 6 byte serial number
+ * @note      the memory is erased to 0xFF, every page is open and the factory byte is 0x55
+ */
+void ds2431_model_init(ds2431_model_t *model, const uint8_t serial[6])
+{
+    memset(model, 0, sizeof(ds2431_model_t));                     /* clear */
+    model->rom[0] = 0x2D;                                         /* family code */
+    memcpy(&model->rom[1], serial, 6);                            /* serial number */
+    model->rom[7] = ds2431_model_crc8(model->rom, 7);             /* crc8 */
+    memset(model->memory, 0xFF, DS2431_MODEL_MEMORY_SIZE);        /* erased */
+    memset(&model->memory[0x80], 0x00, 5);                        /* open pages */
+    model->memory[0x85] = 0x55;                                   /* factory byte */
+    memset(model->scratchpad, 0xFF, 8);                           /* scratchpad */
+    model->prog_ns = DS2431_MODEL_PROG_NS;                        /* programming time */
+    model->state = DS2431_MODEL_STATE_IDLE;                       /* wait for a reset */
+}
+
+/**
+ * @brief     the master pulls the line low
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] now_ns current time
+ * @note      none
+ */
+void ds2431_model_fall(ds2431_model_t *model, uint64_t now_ns)
+{
+    uint8_t bit;
+    
+    model->fall_ns = now_ns;                                                                        /* slot start */
+    model->slot_tx = 0;                                                                             /* init 0 */
+    if ((model->state == DS2431_MODEL_STATE_READ_ROM) ||
+        (model->state == DS2431_MODEL_STATE_TX) ||
+        (model->state == DS2431_MODEL_STATE_PROGRAM) ||
+        ((model->state == DS2431_MODEL_STATE_SEARCH) && (model->search_phase < 2)))                 /* transmit states */
+    {
+        model->slot_tx = 1;                                                                         /* transmit slot */
+        bit = a_model_tx_bit(model, now_ns);                                                        /* get bit */
+        if (bit == 0)                                                                               /* hold the line low */
+        {
+            model->drive_start_ns = now_ns;                                                         /* from now */
+            model->drive_end_ns = now_ns + ((model->overdrive != 0) ? DS2431_MODEL_HOLD_OD_NS :
+                                                                      DS2431_MODEL_HOLD_NS);        /* hold time */
+        }
+    }
+}
+
+/**
+ * @brief     the master releases the line
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] now_ns current time
+ * @note      the low time decides between a reset and a time slot
+ */
+void ds2431_model_rise(ds2431_model_t *model, uint64_t now_ns)
+{
+    uint8_t bit;
+    uint64_t low;
+    uint64_t pdh;
+    
+    low = now_ns - model->fall_ns;                                                                     /* low time */
+    if ((low >= DS2431_MODEL_RSTL_NS) ||
+        ((model->overdrive != 0) && (low >= DS2431_MODEL_RSTL_OD_NS)))                                 /* reset */
+    {
+        if (low >= DS2431_MODEL_RSTL_NS)                                                               /* standard reset */
+        {
+            model->overdrive = 0;                                                                      /* back to standard speed */
+        }
+        pdh = (model->overdrive != 0) ? DS2431_MODEL_PDH_OD_NS : DS2431_MODEL_PDH_NS;                  /* presence high time */
+        model->drive_start_ns = now_ns + pdh;                                                          /* presence start */
+        model->drive_end_ns = model->drive_start_ns + ((model->overdrive != 0) ?
+                              DS2431_MODEL_PDL_OD_NS : DS2431_MODEL_PDL_NS);                           /* presence end */
+        model->state = DS2431_MODEL_STATE_ROM;                                                         /* rom command */
+        model->bits = 0;                                                                               /* init 0 */
+        model->tx_bits = 0;                                                                            /* init 0 */
+        model->resets++;                                                                               /* resets++ */
+        
+        return;
+    }
+    if (low > ((model->overdrive != 0) ? DS2431_MODEL_W0L_MAX_OD_NS : DS2431_MODEL_W0L_MAX_NS))        /* too long for a slot */
+    {
+        model->state = DS2431_MODEL_STATE_IDLE;                                                        /* lost */
+        
+        return;
+    }
+    if (model->state == DS2431_MODEL_STATE_IDLE)                                                       /* idle */
+    {
+        return;
+    }
+    if (model->slot_tx != 0)                                                                           /* transmit slot */
+    {
+        if (model->state == DS2431_MODEL_STATE_SEARCH)                                                 /* search rom */
+        {
+            model->search_phase++;                                                                     /* next phase */
+        }
+        else
+        {
+            model->tx_byte >>= 1;                                                                      /* next bit */
+            model->tx_bits--;                                                                          /* bits-- */
+            if ((model->tx_bits == 0) && (model->state == DS2431_MODEL_STATE_READ_ROM) &&
+                (model->tx_pos >= model->tx_len))                                                      /* rom sent */
+            {
+                model->state = DS2431_MODEL_STATE_FUNCTION;                                            /* selected */
+            }
+        }
+        
+        return;
+    }
+    bit = (low < ((model->overdrive != 0) ? DS2431_MODEL_SAMPLE_OD_NS :
+                                            DS2431_MODEL_SAMPLE_NS)) ? 1 : 0;                          /* sample the bit */
+    if (model->state == DS2431_MODEL_STATE_SEARCH)                                                     /* search direction */
+    {
+        if (bit != ((model->rom[model->search_index / 8] >> (model->search_index % 8)) & 0x01))        /* check direction */
+        {
+            model->state = DS2431_MODEL_STATE_IDLE;                                                    /* deselected */
+            
+            return;
+        }
+        model->search_index++;                                                                         /* next bit */
+        model->search_phase = 0;                                                                       /* send the bit */
+        if (model->search_index == 64)                                                                 /* whole rom */
+        {
+            model->resume = 1;                                                                         /* set resume */
+            model->state = DS2431_MODEL_STATE_FUNCTION;                                                /* selected */
+        }
+        
+        return;
+    }
+    model->shift = (uint8_t)((model->shift >> 1) | (bit << 7));                                        /* lsb first */
+    model->bits++;                                                                                     /* bits++ */
+    if (model->bits == 8)                                                                              /* whole byte */
+    {
+        model->bits = 0;                                                                               /* init 0 */
+        a_model_rx_byte(model, model->shift, now_ns);                                                  /* handle byte */
+    }
+}
+
+/**
+ * @brief     get the line level driven by the device
+ * @param[in] *model pointer to a ds2431 model structure
+ * @param[in] now_ns current time
+ * @return    0 if the device pulls the line low, 1 if it is released
+ * @note      none
+ */
+uint8_t ds2431_model_level(ds2431_model_t *model, uint64_t now_ns)
+{
+    if ((now_ns >= model->drive_start_ns) && (now_ns < model->drive_end_ns))        /* check drive */
+    {
+        return 0;                                                                   /* low */
+    }
+    
+    return 1;                                                                       /* released */
+}
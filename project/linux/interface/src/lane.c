@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      lane.c
+ * @brief     lane source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "lane.h"
+#include "delay.h"
+#include <string.h>
+
+/**
+ * @brief     initialize a lane
+ * @param[in] *lane pointer to a lane structure
+ * @param[in] *serial pointer to a 6 byte serial number
+ * @note      the device is connected and erased
+ */
+void lane_init(lane_t *lane, const uint8_t serial[6])
+{
+    memset(lane, 0, sizeof(lane_t));
+    ds2431_model_init(&lane->device, serial);
+    lane->level = 1;
+}
+
+/**
+ * @brief      lane read data
+ * @param[in]  *lane pointer to a lane structure
+ * @param[out] *value pointer to a read data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the line is the wired-and of the master and the device
+ */
+uint8_t lane_read(lane_t *lane, uint8_t *value)
+{
+    *value = lane->level;
+    if ((lane->cut == 0) && (lane->level != 0))
+    {
+        *value = ds2431_model_level(&lane->device, delay_get_ns());
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     lane write data
+ * @param[in] *lane pointer to a lane structure
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ * @note      a disconnected device sees no edge
+ */
+uint8_t lane_write(lane_t *lane, uint8_t value)
+{
+    value = (value != 0) ? 1 : 0;
+    if (value == lane->level)
+    {
+        return 0;
+    }
+    lane->level = value;
+    if (lane->cut != 0)
+    {
+        return 0;
+    }
+    if (value == 0)
+    {
+        ds2431_model_fall(&lane->device, delay_get_ns());
+    }
+    else
+    {
+        ds2431_model_rise(&lane->device, delay_get_ns());
+    }
+    
+    return 0;
+}
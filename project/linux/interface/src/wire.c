@@ -0,0 +1,415 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      wire.c
+ * @brief     wire source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "wire.h"
+#include "delay.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief wire bus var definition
+ */
+static ds2431_model_t *gs_device[WIRE_MAX_DEVICE];        /**< attached devices */
+static ds2431_model_t *gs_active[WIRE_MAX_DEVICE];        /**< devices that are not idle */
+static uint16_t gs_device_num = 0;                        /**< attached device number */
+static uint16_t gs_active_num = 0;                        /**< active device number */
+static ds2431_model_t gs_default;                         /**< default device */
+static uint8_t gs_level = 1;                              /**< master level */
+static uint64_t gs_fall_ns = 0;                           /**< master falling edge time */
+static uint32_t gs_slot = 0;                              /**< time slot counter */
+static uint32_t gs_reset = 0;                             /**< reset counter */
+
+/**
+ * @brief wire fault var definition
+ */
+static wire_fault_t gs_fault =                            /**< injected faults */
+{
+    WIRE_FAULT_OFF, WIRE_FAULT_OFF, WIRE_FAULT_OFF, 0, 0, 0, 0, 0,
+};
+static uint32_t gs_injected = 0;                          /**< injected fault counter */
+static uint8_t gs_mute = 0;                               /**< presence is hidden until the next fall */
+static uint8_t gs_flip = 0;                               /**< samples are inverted until the next fall */
+static uint8_t gs_stuck = 0;                              /**< the line is stuck low */
+static uint64_t gs_stuck_start_ns = 0;                    /**< stuck low from */
+static uint64_t gs_stuck_end_ns = 0;                      /**< stuck low until */
+
+/**
+ * @brief     decide a random fault
+ * @param[in] ppm fault rate in parts per million
+ * @return    1 if the fault hits, 0 if not
+ * @note      none
+ */
+static uint8_t a_wire_fault_hit(uint32_t ppm)
+{
+    if (ppm == 0)
+    {
+        return 0;
+    }
+    gs_fault.seed = gs_fault.seed * 1103515245U + 12345U;
+    
+    return (((gs_fault.seed >> 8) % 1000000U) < ppm) ? 1 : 0;
+}
+
+/**
+ * @brief     release a stuck line once its time is over
+ * @param[in] now current time
+ * @note      the devices see the stuck time as one long low pulse
+ */
+static void a_wire_stuck_update(uint64_t now)
+{
+    uint16_t i;
+    
+    if ((gs_stuck == 0) || (now < gs_stuck_end_ns))
+    {
+        return;
+    }
+    gs_stuck = 0;
+    gs_active_num = 0;
+    for (i = 0; i < gs_device_num; i++)
+    {
+        ds2431_model_fall(gs_device[i], gs_stuck_start_ns);
+        if (gs_level != 0)
+        {
+            ds2431_model_rise(gs_device[i], gs_stuck_end_ns);
+        }
+        if ((gs_level == 0) || (gs_device[i]->state != DS2431_MODEL_STATE_IDLE))
+        {
+            gs_active[gs_active_num++] = gs_device[i];
+        }
+    }
+    if (gs_level == 0)
+    {
+        gs_fall_ns = gs_stuck_start_ns;
+    }
+}
+
+/**
+ * @brief  wire bus init
+ * @return status code
+ *         - 0 success
+ * @note   a default device model is attached if none is attached
+ */
+uint8_t wire_init(void)
+{
+    const uint8_t serial[6] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+    
+    if (gs_device_num == 0)
+    {
+        ds2431_model_init(&gs_default, serial);
+        (void)wire_attach(&gs_default);
+    }
+    gs_level = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  wire bus deint
+ * @return status code
+ *         - 0 success
+ * @note   the attached devices keep their memory
+ */
+uint8_t wire_deinit(void)
+{
+    gs_level = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief      wire bus read data
+ * @param[out] *value pointer to a read data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the line is the wired-and of the master and every device,
+ *             idle devices never pull the line low and are skipped
+ */
+uint8_t wire_read(uint8_t *value)
+{
+    uint16_t i;
+    uint8_t level;
+    uint64_t now;
+    
+    now = delay_get_ns();
+    a_wire_stuck_update(now);
+    if (gs_stuck != 0)
+    {
+        *value = 0;
+        
+        return 0;
+    }
+    level = gs_level;
+    for (i = 0; (i < gs_active_num) && (level != 0) && (gs_mute == 0); i++)
+    {
+        level &= ds2431_model_level(gs_active[i], now);
+    }
+    *value = level ^ gs_flip;
+    
+    return 0;
+}
+
+/**
+ * @brief     wire bus write data
+ * @param[in] value write data
+ * @return    status code
+ *            - 0 success
+ * @note      a falling edge reaches the active devices, a reset reaches every device
+ *            and the devices that went idle are dropped from the active list
+ */
+uint8_t wire_write(uint8_t value)
+{
+    uint16_t i;
+    uint16_t num;
+    uint8_t reset;
+    uint64_t now;
+    uint64_t low;
+    uint64_t sample;
+    uint64_t edge;
+    
+    value = (value != 0) ? 1 : 0;
+    if (value == gs_level)
+    {
+        return 0;
+    }
+    now = delay_get_ns();
+    a_wire_stuck_update(now);
+    gs_level = value;
+    if (gs_stuck != 0)
+    {
+        return 0;
+    }
+    if (value == 0)
+    {
+        gs_fall_ns = now;
+        gs_mute = 0;
+        gs_flip = 0;
+        for (i = 0; i < gs_active_num; i++)
+        {
+            ds2431_model_fall(gs_active[i], now);
+        }
+        
+        return 0;
+    }
+    
+    /* a reset for any device, an idle device in overdrive also answers a short one */
+    low = now - gs_fall_ns;
+    reset = (low >= DS2431_MODEL_RSTL_NS) ? 1 : 0;
+    for (i = 0; (i < gs_device_num) && (reset == 0) && (low >= DS2431_MODEL_RSTL_OD_NS); i++)
+    {
+        reset = gs_device[i]->overdrive;
+    }
+    if (reset != 0)
+    {
+        gs_active_num = 0;
+        for (i = 0; i < gs_device_num; i++)
+        {
+            if (gs_device[i]->state == DS2431_MODEL_STATE_IDLE)
+            {
+                ds2431_model_fall(gs_device[i], gs_fall_ns);
+            }
+            ds2431_model_rise(gs_device[i], now);
+            if (gs_device[i]->state != DS2431_MODEL_STATE_IDLE)
+            {
+                gs_active[gs_active_num++] = gs_device[i];
+            }
+        }
+        if ((gs_reset == gs_fault.presence_reset) || (a_wire_fault_hit(gs_fault.presence_ppm) != 0))
+        {
+            gs_mute = 1;
+            gs_injected++;
+        }
+        if (gs_reset == gs_fault.stuck_reset)
+        {
+            gs_stuck = 1;
+            gs_stuck_start_ns = now;
+            gs_stuck_end_ns = now + (uint64_t)gs_fault.stuck_us * 1000;
+            gs_injected++;
+        }
+        gs_reset++;
+        
+        return 0;
+    }
+    
+    if ((gs_slot == gs_fault.flip_slot) || (a_wire_fault_hit(gs_fault.flip_ppm) != 0))
+    {
+        gs_flip = 1;
+        gs_injected++;
+    }
+    gs_slot++;
+    num = 0;
+    for (i = 0; i < gs_active_num; i++)
+    {
+        edge = now;
+        if (gs_flip != 0)
+        {
+            /* move the edge to the other side of the sample point */
+            sample = (gs_active[i]->overdrive != 0) ? DS2431_MODEL_SAMPLE_OD_NS : DS2431_MODEL_SAMPLE_NS;
+            edge = (low < sample) ? (gs_fall_ns + sample * 2) : (gs_fall_ns + sample / 2);
+        }
+        ds2431_model_rise(gs_active[i], edge);
+        if (gs_active[i]->state != DS2431_MODEL_STATE_IDLE)
+        {
+            gs_active[num++] = gs_active[i];
+        }
+    }
+    gs_active_num = num;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach a device model to the bus
+ * @param[in] *model pointer to a ds2431 model structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 the bus is full
+ * @note      none
+ */
+uint8_t wire_attach(ds2431_model_t *model)
+{
+    if (gs_device_num >= WIRE_MAX_DEVICE)
+    {
+        return 1;
+    }
+    gs_device[gs_device_num++] = model;
+    
+    return 0;
+}
+
+/**
+ * @brief  detach every device model
+ * @return status code
+ *         - 0 success
+ * @note   the next wire_init attaches the default device again
+ */
+uint8_t wire_detach_all(void)
+{
+    gs_device_num = 0;
+    gs_active_num = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     get an attached device model
+ * @param[in] index device index
+ * @return    pointer to the device model or NULL
+ * @note      none
+ */
+ds2431_model_t *wire_get_device(uint16_t index)
+{
+    if (index >= gs_device_num)
+    {
+        return NULL;
+    }
+    
+    return gs_device[index];
+}
+
+/**
+ * @brief      get the bus counters
+ * @param[out] *slot pointer to a time slot number buffer
+ * @param[out] *reset pointer to a reset number buffer
+ * @return     status code
+ *             - 0 success
+ * @note       a low pulse counts as a reset if a device answers it as one
+ */
+uint8_t wire_get_count(uint32_t *slot, uint32_t *reset)
+{
+    *slot = gs_slot;
+    *reset = gs_reset;
+    
+    return 0;
+}
+
+/**
+ * @brief     set the injected faults
+ * @param[in] *fault pointer to a wire fault structure, NULL clears every fault
+ * @return    status code
+ *            - 0 success
+ * @note      copy_fail is handed to every attached device
+ */
+uint8_t wire_set_fault(const wire_fault_t *fault)
+{
+    uint16_t i;
+    
+    if (fault == NULL)
+    {
+        memset(&gs_fault, 0, sizeof(wire_fault_t));
+        gs_fault.presence_reset = WIRE_FAULT_OFF;
+        gs_fault.flip_slot = WIRE_FAULT_OFF;
+        gs_fault.stuck_reset = WIRE_FAULT_OFF;
+    }
+    else
+    {
+        gs_fault = *fault;
+    }
+    for (i = 0; i < gs_device_num; i++)
+    {
+        gs_device[i]->copy_fail = gs_fault.copy_fail;
+    }
+    gs_injected = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      get the injected fault number
+ * @param[out] *injected pointer to an injected fault number buffer
+ * @return     status code
+ *             - 0 success
+ * @note       copy failures are counted by the devices
+ */
+uint8_t wire_get_fault_count(uint32_t *injected)
+{
+    *injected = gs_injected;
+    
+    return 0;
+}
+
+/**
+ * @brief  clear the bus counters
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t wire_clear_count(void)
+{
+    gs_slot = 0;
+    gs_reset = 0;
+    
+    return 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      compress_test.c
+ * @brief     compress test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_compress.h"
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief compress test definition
+ */
+#define COMPRESS_TEST_ADDRESS        0x08        /**< stored image address */
+#define COMPRESS_TEST_LEN            120         /**< raw length of every pattern */
+#define COMPRESS_TEST_PATTERN        4           /**< pattern number */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the results are checked through the status codes
+ */
+static void a_compress_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_compress_test_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+static lane_t gs_lane;                    /**< simulated bus */
+static ds2431_handle_t gs_handle;         /**< ds2431 handle */
+
+/**
+ * @brief      fill a test pattern
+ * @param[in]  pattern pattern index
+ * @param[out] *data pointer to a data buffer
+ * @note       0 is blank, 1 is a ramp with no run, 2 mixes runs and literals,
+ *             3 is short runs of 2 and 3 bytes
+ */
+static void a_compress_test_pattern(uint8_t pattern, uint8_t data[COMPRESS_TEST_LEN])
+{
+    uint8_t i;
+    
+    for (i = 0; i < COMPRESS_TEST_LEN; i++)
+    {
+        if (pattern == 0)
+        {
+            data[i] = 0xFF;
+        }
+        else if (pattern == 1)
+        {
+            data[i] = i;
+        }
+        else if (pattern == 2)
+        {
+            data[i] = ((i / 16) % 2 == 0) ? 0x00 : (uint8_t)(i * 7);
+        }
+        else
+        {
+            data[i] = (uint8_t)(i / ((i % 10 < 5) ? 2 : 3));
+        }
+    }
+}
+
+/**
+ * @brief     read the stored image and check the status code
+ * @param[in] len buffer size
+ * @param[in] res expected status code
+ * @param[in] *data pointer to the expected data, NULL skips the data check
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_compress_test_read(uint8_t len, uint8_t res, const uint8_t *data)
+{
+    uint8_t buf[COMPRESS_TEST_LEN];
+    
+    if (ds2431_compress_read(&gs_handle, COMPRESS_TEST_ADDRESS, buf, &len) != res)
+    {
+        return 1;
+    }
+    if ((data != NULL) && ((len != COMPRESS_TEST_LEN) || (memcmp(buf, data, COMPRESS_TEST_LEN) != 0)))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   every pattern goes through the codec and the device, then the stored
+ *         header and control bytes are corrupted one at a time
+ */
+int main(void)
+{
+    uint8_t serial[6];
+    uint8_t data[COMPRESS_TEST_LEN];
+    uint8_t out[COMPRESS_TEST_LEN];
+    uint8_t packed[128];
+    uint8_t packed_len;
+    uint8_t out_len;
+    uint8_t size;
+    uint8_t stored;
+    uint8_t i;
+    uint8_t *image;
+    
+    (void)delay_init();
+    memset(serial, 0, 6);
+    serial[0] = 0x01;
+    lane_init(&gs_lane, serial);
+    DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
+    DRIVER_DS2431_LINK_USER(&gs_handle, &gs_lane);
+    if (ds2431_init(&gs_handle) != 0)
+    {
+        printf("compress_test: init failed.\n");
+        
+        return 1;
+    }
+    image = &gs_lane.device.memory[COMPRESS_TEST_ADDRESS];
+    
+    /* round trip */
+    for (i = 0; i < COMPRESS_TEST_PATTERN; i++)
+    {
+        a_compress_test_pattern(i, data);
+        if ((ds2431_compress_size(data, COMPRESS_TEST_LEN, &size) != 0) ||
+            (ds2431_compress_encode(data, COMPRESS_TEST_LEN, packed, sizeof(packed), &packed_len) != 0) ||
+            (size != packed_len + DS2431_COMPRESS_HEADER) ||
+            (ds2431_compress_decode(packed, packed_len, out, sizeof(out), &out_len) != 0) ||
+            (out_len != COMPRESS_TEST_LEN) || (memcmp(data, out, COMPRESS_TEST_LEN) != 0))
+        {
+            printf("compress_test: pattern %d codec failed.\n", i);
+            (void)ds2431_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if (size > 0x80 - COMPRESS_TEST_ADDRESS)
+        {
+            if (ds2431_compress_write(&gs_handle, COMPRESS_TEST_ADDRESS, data, COMPRESS_TEST_LEN, &stored) != 4)
+            {
+                printf("compress_test: pattern %d room check failed.\n", i);
+                (void)ds2431_deinit(&gs_handle);
+                
+                return 1;
+            }
+            printf("compress_test: pattern %d needs %d bytes and does not fit passed.\n", i, size);
+            
+            continue;
+        }
+        if ((ds2431_compress_write(&gs_handle, COMPRESS_TEST_ADDRESS, data, COMPRESS_TEST_LEN, &stored) != 0) ||
+            (stored != size) || (a_compress_test_read(COMPRESS_TEST_LEN, 0, data) != 0))
+        {
+            printf("compress_test: pattern %d device round trip failed.\n", i);
+            (void)ds2431_deinit(&gs_handle);
+            
+            return 1;
+        }
+        printf("compress_test: pattern %d stored in %d bytes passed.\n", i, size);
+    }
+    
+    /* a small buffer gets the needed length */
+    a_compress_test_pattern(2, data);
+    if ((ds2431_compress_write(&gs_handle, COMPRESS_TEST_ADDRESS, data, COMPRESS_TEST_LEN, NULL) != 0) ||
+        (a_compress_test_read(COMPRESS_TEST_LEN - 1, 4, NULL) != 0))
+    {
+        printf("compress_test: small buffer check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("compress_test: small buffer check passed.\n");
+    
+    /* corrupted raw length */
+    image[0] = COMPRESS_TEST_LEN - 1;
+    if (a_compress_test_read(COMPRESS_TEST_LEN, 5, NULL) != 0)
+    {
+        printf("compress_test: raw length check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    image[0] = COMPRESS_TEST_LEN;
+    
+    /* packed length past the data memory */
+    packed_len = image[1];
+    image[1] = 0x80 - COMPRESS_TEST_ADDRESS - 1;
+    if (a_compress_test_read(COMPRESS_TEST_LEN, 5, NULL) != 0)
+    {
+        printf("compress_test: packed length check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    image[1] = packed_len;
+    
+    /* literal control past the packed data */
+    size = image[2];
+    image[2] = 0x7F;
+    if (a_compress_test_read(COMPRESS_TEST_LEN, 5, NULL) != 0)
+    {
+        printf("compress_test: literal control check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    image[2] = size;
+    
+    /* repeat control without its byte */
+    packed[0] = 0x85;
+    if ((ds2431_compress_decode(packed, 1, out, sizeof(out), &out_len) != 5) ||
+        (a_compress_test_read(COMPRESS_TEST_LEN, 0, data) != 0))
+    {
+        printf("compress_test: repeat control check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("compress_test: corrupted image checks passed.\n");
+    (void)ds2431_deinit(&gs_handle);
+    printf("compress_test: passed.\n");
+    
+    return 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      counter_test.c
+ * @brief     counter test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_counter.h"
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief counter test definition
+ */
+#define COUNTER_TEST_ADDRESS        0x20        /**< first counter row, page 1 */
+#define COUNTER_TEST_ROWS           2           /**< counter rows */
+#define COUNTER_TEST_TIMES          70          /**< first increments, into the second row */
+
+static lane_t gs_lane;                          /**< simulated bus */
+static ds2431_handle_t gs_handle;               /**< ds2431 handle */
+static ds2431_extension_t gs_ext;               /**< handle extension */
+static ds2431_counter_t gs_counter;             /**< counter under test */
+static ds2431_counter_t gs_other;               /**< second view of the same rows */
+static uint8_t gs_weak;                         /**< 1 if the next row program does not hold */
+static uint8_t gs_weak_row[8];                  /**< row content before the program */
+static uint8_t gs_weak_address;                 /**< row address of the weak program */
+static uint32_t gs_weak_programs;               /**< device programs when armed */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the results are checked through the status codes
+ */
+static void a_counter_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     undo a row program
+ * @param[in] *user pointer to a user context
+ * @param[in] *transaction pointer to the finished transaction
+ * @note      the write reports success but the row keeps its old content,
+ *            as with a cell that does not hold its charge
+ */
+static void a_counter_test_end(void *user, const ds2431_transaction_t *transaction)
+{
+    (void)user;
+    if ((gs_weak != 0) && (transaction->op == DS2431_STATS_API_WRITE) &&
+        (gs_lane.device.programs > gs_weak_programs))
+    {
+        memcpy(&gs_lane.device.memory[gs_weak_address], gs_weak_row, 8);
+        gs_weak = 0;
+    }
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_counter_test_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+    .on_transaction_end = a_counter_test_end,
+};
+
+/**
+ * @brief     mount a counter and check its count
+ * @param[in] *counter pointer to a ds2431 counter structure
+ * @param[in] count expected count
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_counter_test_mount(ds2431_counter_t *counter, uint16_t count)
+{
+    uint16_t n;
+    
+    memset(counter, 0, sizeof(ds2431_counter_t));
+    if ((ds2431_counter_init(counter, &gs_handle, COUNTER_TEST_ADDRESS, COUNTER_TEST_ROWS) != 0) ||
+        (ds2431_counter_read(counter, &n) != 0) || (n != count))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the counter runs into its second row and is mounted again, then a stale
+ *         counter, a row program that does not hold and a full counter are checked
+ */
+int main(void)
+{
+    uint8_t serial[6];
+    uint16_t i;
+    uint16_t count;
+    ds2431_config_control_t config;
+    
+    (void)delay_init();
+    memset(serial, 0, 6);
+    serial[0] = 0x01;
+    lane_init(&gs_lane, serial);
+    DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
+    DRIVER_DS2431_LINK_USER(&gs_handle, &gs_lane);
+    (void)ds2431_set_extension(&gs_handle, &gs_ext);
+    if (ds2431_init(&gs_handle) != 0)
+    {
+        printf("counter_test: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* the page must be in eprom mode */
+    if (ds2431_counter_init(&gs_counter, &gs_handle, COUNTER_TEST_ADDRESS, COUNTER_TEST_ROWS) != 5)
+    {
+        printf("counter_test: eprom mode check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (ds2431_read_memory_config(&gs_handle, &config) != 0)
+    {
+        printf("counter_test: read memory config failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    config.page1_protection_control = DS2431_CONFIG_EPROM_MODE;
+    if ((ds2431_write_memory_config(&gs_handle, &config) != 0) || (a_counter_test_mount(&gs_counter, 0) != 0))
+    {
+        printf("counter_test: mount failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("counter_test: eprom mode check passed.\n");
+    
+    /* increment into the second row */
+    for (i = 0; i < COUNTER_TEST_TIMES; i++)
+    {
+        if ((ds2431_counter_increment(&gs_counter, &count) != 0) || (count != i + 1))
+        {
+            printf("counter_test: increment %d failed.\n", i);
+            (void)ds2431_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    for (i = 0; i < 8; i++)
+    {
+        if (gs_lane.device.memory[COUNTER_TEST_ADDRESS + i] != 0x00)
+        {
+            break;
+        }
+    }
+    if ((i != 8) || (gs_lane.device.memory[COUNTER_TEST_ADDRESS + 8] != 0xC0) ||
+        (gs_lane.device.memory[COUNTER_TEST_ADDRESS + 9] != 0xFF))
+    {
+        printf("counter_test: counter rows check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("counter_test: %d increments passed.\n", COUNTER_TEST_TIMES);
+    
+    /* mount again */
+    if (a_counter_test_mount(&gs_counter, COUNTER_TEST_TIMES) != 0)
+    {
+        printf("counter_test: remount failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("counter_test: remount passed.\n");
+    
+    /* a stale count follows the chip */
+    if ((a_counter_test_mount(&gs_other, COUNTER_TEST_TIMES) != 0) ||
+        (ds2431_counter_increment(&gs_other, NULL) != 0) || (ds2431_counter_increment(&gs_other, NULL) != 0) ||
+        (ds2431_counter_increment(&gs_counter, &count) != 0) || (count != COUNTER_TEST_TIMES + 3) ||
+        (gs_lane.device.memory[COUNTER_TEST_ADDRESS + 9] != 0xFE))
+    {
+        printf("counter_test: stale count check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("counter_test: stale count check passed.\n");
+    
+    /* a program that does not hold is no increment */
+    gs_weak_address = COUNTER_TEST_ADDRESS + 8;
+    memcpy(gs_weak_row, &gs_lane.device.memory[gs_weak_address], 8);
+    gs_weak_programs = gs_lane.device.programs;
+    gs_weak = 1;
+    if ((ds2431_counter_increment(&gs_counter, &count) != 1) || (gs_weak != 0) ||
+        (gs_counter.count != COUNTER_TEST_TIMES + 3) ||
+        (ds2431_counter_increment(&gs_counter, &count) != 0) || (count != COUNTER_TEST_TIMES + 4))
+    {
+        printf("counter_test: weak bit check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("counter_test: weak bit check passed.\n");
+    
+    /* full */
+    for (i = COUNTER_TEST_TIMES + 4; i < COUNTER_TEST_ROWS * DS2431_COUNTER_ROW_STEPS; i++)
+    {
+        if (ds2431_counter_increment(&gs_counter, NULL) != 0)
+        {
+            printf("counter_test: increment %d failed.\n", i);
+            (void)ds2431_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    if ((ds2431_counter_increment(&gs_counter, &count) != 4) ||
+        (a_counter_test_mount(&gs_counter, COUNTER_TEST_ROWS * DS2431_COUNTER_ROW_STEPS) != 0))
+    {
+        printf("counter_test: full check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("counter_test: full check passed.\n");
+    (void)ds2431_deinit(&gs_handle);
+    printf("counter_test: passed.\n");
+    
+    return 0;
+}
@@ -0,0 +1,498 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      extension_test.c
+ * @brief     extension test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431.h"
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief extension test definition
+ */
+#define EXTENSION_TEST_DIGEST        0x78        /**< digest row address */
+
+static lane_t gs_lane;                             /**< simulated bus */
+static ds2431_handle_t gs_handle;                  /**< ds2431 handle */
+static ds2431_extension_t gs_ext;                  /**< handle extension */
+static ds2431_cache_t gs_cache;                    /**< shadow cache */
+static ds2431_trace_t gs_trace;                    /**< bus trace */
+static ds2431_stats_t gs_stats;                    /**< performance counters */
+static uint32_t gs_event[64];                      /**< trace events */
+static uint32_t gs_begin;                          /**< transaction begin count */
+static uint32_t gs_end;                            /**< transaction end count */
+static ds2431_transaction_t gs_transaction;        /**< last ended transaction */
+static uint8_t gs_buffer[128];                     /**< data buffer */
+static uint8_t gs_buffer_check[128];               /**< check buffer */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the results are checked through the status codes
+ */
+static void a_extension_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     transaction begin hook
+ * @param[in] *user pointer to a user context
+ * @param[in] *transaction pointer to a ds2431 transaction structure
+ * @note      none
+ */
+static void a_extension_test_begin(void *user, const ds2431_transaction_t *transaction)
+{
+    (void)user;
+    (void)transaction;
+    gs_begin++;
+}
+
+/**
+ * @brief     transaction end hook
+ * @param[in] *user pointer to a user context
+ * @param[in] *transaction pointer to a ds2431 transaction structure
+ * @note      none
+ */
+static void a_extension_test_end(void *user, const ds2431_transaction_t *transaction)
+{
+    (void)user;
+    gs_end++;
+    gs_transaction = *transaction;
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_extension_test_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+    .on_transaction_begin = a_extension_test_begin,
+    .on_transaction_end = a_extension_test_end,
+};
+
+/**
+ * @brief  cache test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a write through the cache must reach the device and the cached image,
+ *         and a cached read must not touch the bus
+ */
+static uint8_t a_extension_test_cache(void)
+{
+    uint8_t j;
+    uint32_t end;
+    
+    if ((ds2431_set_cache(&gs_handle, &gs_cache) != 0) || (ds2431_cache_refresh(&gs_handle) != 0))
+    {
+        return 1;
+    }
+    for (j = 0; j < 128; j++)
+    {
+        gs_buffer[j] = (uint8_t)(j * 13 + 7);
+    }
+    if (ds2431_write(&gs_handle, 0, gs_buffer, 128) != 0)
+    {
+        return 1;
+    }
+    end = gs_end;
+    if ((ds2431_read(&gs_handle, 0, gs_buffer_check, 128) != 0) || (gs_end != end) ||
+        (memcmp(gs_buffer, gs_buffer_check, 128) != 0) ||
+        (memcmp(gs_buffer, gs_lane.device.memory, 128) != 0))
+    {
+        return 1;
+    }
+    for (j = 0; j < 128; j++)
+    {
+        if (((gs_cache.valid & (1UL << (j / 8))) != 0) && (gs_cache.image[j] != gs_buffer[j]))
+        {
+            return 1;
+        }
+    }
+    (void)ds2431_set_cache(&gs_handle, NULL);
+    
+    return 0;
+}
+
+/**
+ * @brief  digest test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a write and a raw scratchpad copy must both move the generation on,
+ *         and the raw scratchpad commands must reject the digest row
+ */
+static uint8_t a_extension_test_digest(void)
+{
+    uint8_t res;
+    uint8_t row[8];
+    uint16_t crc16;
+    uint16_t address;
+    uint32_t digest;
+    uint32_t digest_check;
+    ds2431_bool_t changed;
+    
+    if ((ds2431_set_digest(&gs_handle, DS2431_BOOL_TRUE, EXTENSION_TEST_DIGEST) != 0) ||
+        (ds2431_get_digest(&gs_handle, &digest) != 0))
+    {
+        return 1;
+    }
+    res = 0;
+    
+    /* unchanged, then one write */
+    if ((ds2431_is_changed(&gs_handle, digest, &changed, &digest_check) != 0) || (changed != DS2431_BOOL_FALSE) ||
+        (ds2431_write(&gs_handle, 0, gs_buffer, 8) != 0) ||
+        (ds2431_is_changed(&gs_handle, digest, &changed, &digest_check) != 0) ||
+        (changed != DS2431_BOOL_TRUE) || (digest_check != digest + 1))
+    {
+        res = 1;
+    }
+    
+    /* the digest row is reserved for the raw scratchpad commands */
+    memset(row, 0x5A, 8);
+    if ((res == 0) &&
+        ((ds2431_write_scratchpad(&gs_handle, EXTENSION_TEST_DIGEST, row, &crc16) != 7) ||
+         (ds2431_copy_scratchpad(&gs_handle, EXTENSION_TEST_DIGEST) != 6)))
+    {
+        res = 1;
+    }
+    
+    /* a raw copy moves the generation on */
+    if ((res == 0) &&
+        ((ds2431_write_scratchpad(&gs_handle, 0x10, row, &crc16) != 0) ||
+         (ds2431_read_scratchpad(&gs_handle, &address, row, &crc16) != 0) ||
+         (ds2431_copy_scratchpad(&gs_handle, address) != 0) ||
+         (ds2431_is_changed(&gs_handle, digest + 1, &changed, &digest_check) != 0) ||
+         (changed != DS2431_BOOL_TRUE) || (digest_check != digest + 2) ||
+         (gs_lane.device.memory[0x10] != 0x5A)))
+    {
+        res = 1;
+    }
+    (void)ds2431_set_digest(&gs_handle, DS2431_BOOL_FALSE, EXTENSION_TEST_DIGEST);
+    
+    return res;
+}
+
+/**
+ * @brief  trace test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   one read must start with a reset and end with the data bytes
+ */
+static uint8_t a_extension_test_trace(void)
+{
+    uint8_t j;
+    uint16_t len;
+    uint32_t lost;
+    
+    (void)ds2431_set_trace(&gs_handle, &gs_trace);
+    if (ds2431_read(&gs_handle, 0, gs_buffer_check, 8) != 0)
+    {
+        (void)ds2431_set_trace(&gs_handle, NULL);
+        
+        return 1;
+    }
+    len = 64;
+    if ((ds2431_trace_read(&gs_handle, gs_event, &len, &lost) != 0) || (lost != 0) || (len < 9))
+    {
+        (void)ds2431_set_trace(&gs_handle, NULL);
+        
+        return 1;
+    }
+    (void)ds2431_set_trace(&gs_handle, NULL);
+    if ((DS2431_TRACE_GET_DATA(gs_event[0]) != 0) ||
+        ((DS2431_TRACE_GET_EVENT(gs_event[0]) != DS2431_TRACE_RESET) &&
+         (DS2431_TRACE_GET_EVENT(gs_event[0]) != DS2431_TRACE_RESET_OVERDRIVE)))
+    {
+        return 1;
+    }
+    for (j = 0; j < 8; j++)
+    {
+        if (DS2431_TRACE_GET_DATA(gs_event[len - 8 + j]) != gs_buffer_check[j])
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  stats test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   one read is one reset with presence, the data bytes and one histogram sample, and so is one get rom
+ */
+static uint8_t a_extension_test_stats(void)
+{
+    uint8_t j;
+    uint8_t rom[8];
+    uint32_t samples;
+    
+    memset(&gs_stats, 0, sizeof(ds2431_stats_t));
+    (void)ds2431_set_stats(&gs_handle, &gs_stats);
+    if (ds2431_read(&gs_handle, 0, gs_buffer_check, 8) != 0)
+    {
+        (void)ds2431_set_stats(&gs_handle, NULL);
+        
+        return 1;
+    }
+    (void)ds2431_set_stats(&gs_handle, NULL);
+    samples = 0;
+    for (j = 0; j < DS2431_STATS_BINS; j++)
+    {
+        samples += gs_stats.histogram[DS2431_STATS_API_READ][j];
+    }
+    if ((gs_stats.reset < 1) || (gs_stats.presence_fail != 0) || (gs_stats.byte_read < 8) ||
+        (gs_stats.bit_read < 64) || (gs_stats.crc_error != 0) || (gs_stats.prog_wait != 0) || (samples != 1))
+    {
+        return 1;
+    }
+    memset(&gs_stats, 0, sizeof(ds2431_stats_t));
+    (void)ds2431_set_stats(&gs_handle, &gs_stats);
+    if (ds2431_get_rom(&gs_handle, rom) != 0)
+    {
+        (void)ds2431_set_stats(&gs_handle, NULL);
+        
+        return 1;
+    }
+    (void)ds2431_set_stats(&gs_handle, NULL);
+    samples = 0;
+    for (j = 0; j < DS2431_STATS_BINS; j++)
+    {
+        samples += gs_stats.histogram[DS2431_STATS_API_GET_ROM][j];
+    }
+    if ((gs_stats.reset != 1) || (gs_stats.byte_read != 8) || (samples != 1))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  transaction test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   one read is one transaction, and so is a one row write once the config is cached
+ */
+static uint8_t a_extension_test_transaction(void)
+{
+    gs_begin = 0;
+    gs_end = 0;
+    if (ds2431_read(&gs_handle, 0, gs_buffer_check, 8) != 0)
+    {
+        return 1;
+    }
+    if ((gs_begin != 1) || (gs_end != 1) || (gs_transaction.op != DS2431_STATS_API_READ) ||
+        (gs_transaction.mode != gs_handle.mode) || (gs_transaction.byte_read < 8) ||
+        (gs_transaction.byte_write < 3) || (gs_transaction.result != 0))
+    {
+        return 1;
+    }
+    gs_begin = 0;
+    gs_end = 0;
+    if ((gs_ext.config_valid == 0) || (ds2431_write(&gs_handle, 0x10, gs_buffer, 8) != 0) ||
+        (gs_begin != 1) || (gs_end != 1) || (gs_transaction.op != DS2431_STATS_API_WRITE))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  estimate test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a longer read and a split write cost more, a write includes tPROG,
+ *         an invalid range and an unsupported op are rejected
+ */
+static uint8_t a_extension_test_estimate(void)
+{
+    uint32_t us;
+    uint32_t us_check;
+    
+    if ((ds2431_estimate_us(&gs_handle, DS2431_STATS_API_READ_MEMORY, 0, 8, &us) != 0) ||
+        (ds2431_estimate_us(&gs_handle, DS2431_STATS_API_READ_MEMORY, 0, 16, &us_check) != 0) ||
+        (us == 0) || (us >= us_check))
+    {
+        return 1;
+    }
+    if ((ds2431_estimate_us(&gs_handle, DS2431_STATS_API_WRITE, 0, 8, &us) != 0) ||
+        (ds2431_estimate_us(&gs_handle, DS2431_STATS_API_WRITE, 4, 8, &us_check) != 0) ||
+        (us < 10000) || (us >= us_check))
+    {
+        return 1;
+    }
+    if ((ds2431_estimate_us(&gs_handle, DS2431_STATS_API_READ, 0x7C, 8, &us) != 4) ||
+        (ds2431_estimate_us(&gs_handle, DS2431_STATS_API_SEARCH_ROM, 0, 0, &us) != 5))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  rom test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   selecting another rom drops the cached rows, the config and the digest,
+ *         selecting the same rom keeps them, dirty rows block another rom until they are flushed
+ */
+static uint8_t a_extension_test_rom(void)
+{
+    uint8_t rom[8];
+    uint8_t rom_check[8];
+    uint8_t row[8];
+    uint8_t j;
+    uint32_t valid;
+    uint32_t dirty;
+    uint32_t digest;
+    
+    if ((ds2431_get_rom(&gs_handle, rom) != 0) || (ds2431_set_rom(&gs_handle, rom) != 0) ||
+        (ds2431_set_cache(&gs_handle, &gs_cache) != 0) || (ds2431_cache_refresh(&gs_handle) != 0) ||
+        (ds2431_set_digest(&gs_handle, DS2431_BOOL_TRUE, EXTENSION_TEST_DIGEST) != 0) ||
+        (ds2431_write(&gs_handle, 0x10, gs_buffer, 8) != 0))
+    {
+        return 1;
+    }
+    if ((ds2431_set_rom(&gs_handle, rom) != 0) || (ds2431_cache_get_valid(&gs_handle, &valid) != 0) ||
+        (valid == 0) || (gs_ext.config_valid == 0) || (ds2431_get_digest(&gs_handle, &digest) != 0))
+    {
+        return 1;
+    }
+    memcpy(rom_check, rom, 8);
+    rom_check[1] ^= 0xFF;
+    for (j = 0; j < 8; j++)
+    {
+        row[j] = (uint8_t)(0xA5 ^ j);
+    }
+    if ((ds2431_set_write_back(&gs_handle, DS2431_BOOL_TRUE, 0, 0) != 0) ||
+        (ds2431_write(&gs_handle, 0x18, row, 8) != 0) ||
+        (ds2431_set_rom(&gs_handle, rom_check) != 4) || (ds2431_cache_get_dirty(&gs_handle, &dirty) != 0) ||
+        (dirty == 0) || (memcmp(gs_handle.rom, rom, 8) != 0) ||
+        (memcmp(&gs_lane.device.memory[0x18], row, 8) == 0) || (ds2431_flush(&gs_handle) != 0) ||
+        (ds2431_set_write_back(&gs_handle, DS2431_BOOL_FALSE, 0, 0) != 0) ||
+        (memcmp(&gs_lane.device.memory[0x18], row, 8) != 0))
+    {
+        return 1;
+    }
+    if ((ds2431_set_rom(&gs_handle, rom_check) != 0) || (ds2431_cache_get_valid(&gs_handle, &valid) != 0) ||
+        (valid != 0) || (gs_ext.config_valid != 0) || (ds2431_get_digest(&gs_handle, &digest) != 4))
+    {
+        return 1;
+    }
+    if (ds2431_set_rom(&gs_handle, rom) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   the cache, the digest, the trace, the stats, the transaction hooks,
+ *         the estimator and the rom selection run one after another on the same handle
+ */
+int main(void)
+{
+    uint8_t i;
+    uint8_t serial[6];
+    static const struct
+    {
+        const char *name;
+        uint8_t (*run)(void);
+    } test[] =
+    {
+        {"cache", a_extension_test_cache},
+        {"digest", a_extension_test_digest},
+        {"trace", a_extension_test_trace},
+        {"stats", a_extension_test_stats},
+        {"transaction", a_extension_test_transaction},
+        {"estimate", a_extension_test_estimate},
+        {"rom", a_extension_test_rom},
+    };
+    
+    (void)delay_init();
+    memset(serial, 0, 6);
+    serial[0] = 0x01;
+    lane_init(&gs_lane, serial);
+    DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
+    DRIVER_DS2431_LINK_USER(&gs_handle, &gs_lane);
+    (void)ds2431_set_extension(&gs_handle, &gs_ext);
+    if (ds2431_init(&gs_handle) != 0)
+    {
+        printf("extension_test: init failed.\n");
+        
+        return 1;
+    }
+    
+    for (i = 0; i < sizeof(test) / sizeof(test[0]); i++)
+    {
+        if (test[i].run() != 0)
+        {
+            printf("extension_test: %s check failed.\n", test[i].name);
+            (void)ds2431_deinit(&gs_handle);
+            
+            return 1;
+        }
+        printf("extension_test: %s check passed.\n", test[i].name);
+    }
+    (void)ds2431_deinit(&gs_handle);
+    printf("extension_test: passed.\n");
+    
+    return 0;
+}
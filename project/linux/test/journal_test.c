@@ -0,0 +1,253 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      journal_test.c
+ * @brief     journal test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_journal.h"
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief journal test definition
+ */
+#define JOURNAL_TEST_ADDRESS        0x00          /**< first row of the journal area */
+#define JOURNAL_TEST_ROWS           2             /**< logical rows */
+#define JOURNAL_TEST_LEN            16            /**< logical bytes */
+
+static lane_t gs_lane;                            /**< simulated bus */
+static ds2431_extension_t gs_ext;                 /**< handle extension */
+static ds2431_handle_t gs_handle;                 /**< ds2431 handle */
+static ds2431_journal_t gs_journal;               /**< journal under test */
+static uint32_t gs_cut;                           /**< row programs before the power cut, 0 is disarmed */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the results are checked through the status codes
+ */
+static void a_journal_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     cut the power after a number of row programs
+ * @param[in] *user pointer to a user context
+ * @param[in] *transaction pointer to the finished transaction
+ * @note      the device drops off the bus at the end of the write transaction
+ *            that programmed the last row
+ */
+static void a_journal_test_end(void *user, const ds2431_transaction_t *transaction)
+{
+    (void)user;
+    if ((gs_cut != 0) && (transaction->op == DS2431_STATS_API_WRITE) &&
+        (gs_lane.device.programs >= gs_cut))
+    {
+        gs_lane.cut = 1;
+    }
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_journal_test_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+    .on_transaction_end = a_journal_test_end,
+};
+
+/**
+ * @brief  power the device up and recover the journal
+ * @return status code
+ *         - 0 success
+ *         - 1 recover failed
+ * @note   the handle and the journal start from scratch as after a reboot
+ */
+static uint8_t a_journal_test_boot(void)
+{
+    (void)ds2431_deinit(&gs_handle);
+    gs_lane.cut = 0;
+    gs_cut = 0;
+    DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
+    DRIVER_DS2431_LINK_USER(&gs_handle, &gs_lane);
+    (void)ds2431_set_extension(&gs_handle, &gs_ext);
+    if (ds2431_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    return ds2431_journal_init(&gs_journal, &gs_handle, JOURNAL_TEST_ADDRESS, JOURNAL_TEST_ROWS);
+}
+
+/**
+ * @brief     check the recovered logical data
+ * @param[in] pattern expected byte pattern
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_journal_test_check(uint8_t pattern)
+{
+    uint8_t i;
+    uint8_t buf[JOURNAL_TEST_LEN];
+    
+    if (ds2431_journal_read(&gs_journal, 0, buf, JOURNAL_TEST_LEN) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < JOURNAL_TEST_LEN; i++)
+    {
+        if (buf[i] != pattern)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     write a pattern with a power cut armed
+ * @param[in] pattern byte pattern
+ * @param[in] rows row programs before the cut, 0 is no cut
+ * @return    status code of ds2431_journal_write
+ * @note      none
+ */
+static uint8_t a_journal_test_write(uint8_t pattern, uint8_t rows)
+{
+    uint8_t buf[JOURNAL_TEST_LEN];
+    
+    memset(buf, pattern, JOURNAL_TEST_LEN);
+    gs_cut = (rows != 0) ? (gs_lane.device.programs + rows) : 0;
+    
+    return ds2431_journal_write(&gs_journal, 0, buf, JOURNAL_TEST_LEN);
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   every update changes both logical rows, so it is two data rows and one commit row
+ */
+int main(void)
+{
+    uint8_t serial[6];
+    uint32_t programs;
+    
+    (void)delay_init();
+    memset(serial, 0, 6);
+    serial[0] = 0x01;
+    lane_init(&gs_lane, serial);
+    if (a_journal_test_boot() != 0)
+    {
+        printf("journal_test: format failed.\n");
+        
+        return 1;
+    }
+    if ((a_journal_test_write(0x11, 0) != 0) || (a_journal_test_check(0x11) != 0))
+    {
+        printf("journal_test: first update failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("journal_test: first update passed.\n");
+    
+    /* power cut between the data rows and the commit row */
+    programs = gs_lane.device.programs;
+    if ((a_journal_test_write(0x22, 2) == 0) || (gs_lane.device.programs != programs + 2))
+    {
+        printf("journal_test: cut before the commit check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if ((a_journal_test_boot() != 0) || (a_journal_test_check(0x11) != 0))
+    {
+        printf("journal_test: roll back failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("journal_test: cut before the commit rolls back passed.\n");
+    
+    /* power cut between the two data rows */
+    if ((a_journal_test_write(0x33, 1) == 0) ||
+        (a_journal_test_boot() != 0) || (a_journal_test_check(0x11) != 0))
+    {
+        printf("journal_test: cut between the data rows failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("journal_test: cut between the data rows rolls back passed.\n");
+    
+    /* power cut right after the commit row */
+    if ((a_journal_test_write(0x44, 3) != 0) ||
+        (a_journal_test_boot() != 0) || (a_journal_test_check(0x44) != 0))
+    {
+        printf("journal_test: cut after the commit failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("journal_test: cut after the commit rolls forward passed.\n");
+    
+    /* the recovered journal keeps working */
+    if ((a_journal_test_write(0x55, 0) != 0) ||
+        (a_journal_test_boot() != 0) || (a_journal_test_check(0x55) != 0))
+    {
+        printf("journal_test: update after recovery failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("journal_test: update after recovery passed.\n");
+    (void)ds2431_deinit(&gs_handle);
+    printf("journal_test: passed.\n");
+    
+    return 0;
+}
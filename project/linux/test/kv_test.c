@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      kv_test.c
+ * @brief     kv test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_kv.h"
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the results are checked through the status codes
+ */
+static void a_kv_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_kv_test_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+static lane_t gs_lane;                    /**< simulated bus */
+static ds2431_handle_t gs_handle;         /**< ds2431 handle */
+static ds2431_kv_t gs_kv;                 /**< kv store under test */
+
+/**
+ * @brief     check a value
+ * @param[in] *key pointer to a key string
+ * @param[in] *value pointer to the expected value
+ * @param[in] len expected value length
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_kv_test_check(const char *key, const uint8_t *value, uint8_t len)
+{
+    uint8_t buf[120];
+    uint8_t buf_len;
+    
+    buf_len = sizeof(buf);
+    if ((ds2431_kv_get(&gs_kv, key, buf, &buf_len) != 0) || (buf_len != len) ||
+        (memcmp(buf, value, len) != 0))
+    {
+        printf("kv_test: %s check failed.\n", key);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   a blank store is formatted, two keys are set, one is rewritten in place,
+ *         the other grows and moves, then one is deleted and the store is mounted again
+ */
+int main(void)
+{
+    uint8_t serial[6];
+    uint8_t id[10];
+    uint8_t mode[16];
+    uint8_t index[8];
+    uint8_t buf[8];
+    uint8_t len;
+    uint32_t programs;
+    
+    (void)delay_init();
+    memset(serial, 0, 6);
+    serial[0] = 0x01;
+    lane_init(&gs_lane, serial);
+    DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
+    DRIVER_DS2431_LINK_USER(&gs_handle, &gs_lane);
+    if (ds2431_init(&gs_handle) != 0)
+    {
+        printf("kv_test: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* a blank store is formatted */
+    if ((ds2431_kv_mount(&gs_kv, &gs_handle) != 0) || (gs_kv.count != 0) ||
+        (gs_lane.device.memory[0] == 0xFF))
+    {
+        printf("kv_test: format failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("kv_test: format passed.\n");
+    
+    /* set two keys */
+    memset(id, 0x11, sizeof(id));
+    memset(mode, 0x22, sizeof(mode));
+    if ((ds2431_kv_set(&gs_kv, "id", id, sizeof(id)) != 0) ||
+        (ds2431_kv_set(&gs_kv, "mode", mode, 3) != 0) || (gs_kv.count != 2) ||
+        (a_kv_test_check("id", id, sizeof(id)) != 0) || (a_kv_test_check("mode", mode, 3) != 0))
+    {
+        printf("kv_test: set failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    len = sizeof(buf);
+    if (ds2431_kv_get(&gs_kv, "none", buf, &len) != 4)
+    {
+        printf("kv_test: missing key check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("kv_test: set passed.\n");
+    
+    /* the same size is rewritten in place, only the changed row is programmed */
+    memcpy(index, gs_lane.device.memory, 8);
+    programs = gs_lane.device.programs;
+    id[sizeof(id) - 1] = 0x33;
+    if ((ds2431_kv_set(&gs_kv, "id", id, sizeof(id)) != 0) ||
+        (gs_lane.device.programs != programs + 1) || (memcmp(index, gs_lane.device.memory, 8) != 0) ||
+        (a_kv_test_check("id", id, sizeof(id)) != 0))
+    {
+        printf("kv_test: replace in place failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("kv_test: replace in place passed.\n");
+    
+    /* a larger value moves to free rows */
+    if ((ds2431_kv_set(&gs_kv, "mode", mode, sizeof(mode)) != 0) || (gs_kv.count != 2) ||
+        (memcmp(index, gs_lane.device.memory, 8) == 0) ||
+        (a_kv_test_check("mode", mode, sizeof(mode)) != 0) || (a_kv_test_check("id", id, sizeof(id)) != 0))
+    {
+        printf("kv_test: replace failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("kv_test: replace passed.\n");
+    
+    /* delete */
+    programs = gs_lane.device.programs;
+    len = sizeof(buf);
+    if ((ds2431_kv_delete(&gs_kv, "id") != 0) || (gs_lane.device.programs != programs + 1) ||
+        (gs_kv.count != 1) || (ds2431_kv_get(&gs_kv, "id", buf, &len) != 4) ||
+        (ds2431_kv_delete(&gs_kv, "id") != 4))
+    {
+        printf("kv_test: delete failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("kv_test: delete passed.\n");
+    
+    /* mount again */
+    memset(&gs_kv, 0, sizeof(gs_kv));
+    len = sizeof(buf);
+    if ((ds2431_kv_mount(&gs_kv, &gs_handle) != 0) || (gs_kv.count != 1) ||
+        (ds2431_kv_get(&gs_kv, "id", buf, &len) != 4) || (a_kv_test_check("mode", mode, sizeof(mode)) != 0))
+    {
+        printf("kv_test: remount failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("kv_test: remount passed.\n");
+    (void)ds2431_deinit(&gs_handle);
+    printf("kv_test: passed.\n");
+    
+    return 0;
+}
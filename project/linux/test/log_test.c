@@ -0,0 +1,267 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      log_test.c
+ * @brief     log test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_log.h"
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief log test definition
+ */
+#define LOG_TEST_ADDRESS        0x00          /**< first row of the ring */
+#define LOG_TEST_ROWS           8             /**< ring rows */
+#define LOG_TEST_TIMES          20            /**< appended records, more than 2 laps */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the results are checked through the status codes
+ */
+static void a_log_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_log_test_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+static lane_t gs_lane;                              /**< simulated bus */
+static ds2431_handle_t gs_handle;                   /**< ds2431 handle */
+static ds2431_log_t gs_log;                         /**< log under test */
+static uint32_t gs_program[LOG_TEST_ROWS];          /**< programs per row */
+
+/**
+ * @brief      fill the payload of a record
+ * @param[in]  i record index
+ * @param[out] *payload pointer to a payload buffer
+ * @note       none
+ */
+static void a_log_test_payload(uint32_t i, uint8_t payload[DS2431_LOG_PAYLOAD])
+{
+    uint8_t j;
+    
+    for (j = 0; j < DS2431_LOG_PAYLOAD; j++)
+    {
+        payload[j] = (uint8_t)(i * 3 + j);
+    }
+}
+
+/**
+ * @brief     mount the ring and check the record number
+ * @param[in] count expected record number
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_log_test_mount(uint8_t count)
+{
+    uint8_t n;
+    
+    if ((ds2431_log_init(&gs_log, &gs_handle, LOG_TEST_ADDRESS, LOG_TEST_ROWS) != 0) ||
+        (ds2431_log_get_count(&gs_log, &n) != 0) || (n != count))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check every record of the ring
+ * @param[in] last index of the newest record
+ * @param[in] count record number
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      record i carries sequence i and the payload of record i
+ */
+static uint8_t a_log_test_check(uint32_t last, uint8_t count)
+{
+    uint8_t n;
+    uint16_t seq;
+    uint32_t i;
+    uint8_t payload[DS2431_LOG_PAYLOAD];
+    uint8_t payload_check[DS2431_LOG_PAYLOAD];
+    
+    for (n = 0; n < count; n++)
+    {
+        i = last + 1 - count + n;
+        a_log_test_payload(i, payload);
+        if ((ds2431_log_read(&gs_log, n, payload_check, &seq) != 0) || (seq != (uint16_t)i) ||
+            (memcmp(payload, payload_check, DS2431_LOG_PAYLOAD) != 0))
+        {
+            printf("log_test: record %d check failed.\n", n);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   blank and zeroed rings mount empty, then the ring wraps twice,
+ *         is mounted again and loses its newest record to corruption
+ */
+int main(void)
+{
+    uint8_t serial[6];
+    uint8_t payload[DS2431_LOG_PAYLOAD];
+    uint16_t seq;
+    uint32_t i;
+    uint32_t wear;
+    uint64_t start;
+    
+    (void)delay_init();
+    memset(serial, 0, 6);
+    serial[0] = 0x01;
+    lane_init(&gs_lane, serial);
+    DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
+    DRIVER_DS2431_LINK_USER(&gs_handle, &gs_lane);
+    if (ds2431_init(&gs_handle) != 0)
+    {
+        printf("log_test: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* blank and zeroed rows are no records */
+    if (a_log_test_mount(0) != 0)
+    {
+        printf("log_test: blank ring check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(&gs_lane.device.memory[LOG_TEST_ADDRESS], 0x00, LOG_TEST_ROWS * 8);
+    if (a_log_test_mount(0) != 0)
+    {
+        printf("log_test: zeroed ring check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(&gs_lane.device.memory[LOG_TEST_ADDRESS], 0xFF, LOG_TEST_ROWS * 8);
+    if (a_log_test_mount(0) != 0)
+    {
+        printf("log_test: mount failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("log_test: blank and zeroed rings mount empty passed.\n");
+    
+    /* append more than two laps */
+    memset(gs_program, 0, sizeof(gs_program));
+    start = delay_get_ns();
+    for (i = 0; i < LOG_TEST_TIMES; i++)
+    {
+        a_log_test_payload(i, payload);
+        if ((ds2431_log_append(&gs_log, payload, &seq) != 0) || (seq != (uint16_t)i))
+        {
+            printf("log_test: append failed.\n");
+            (void)ds2431_deinit(&gs_handle);
+            
+            return 1;
+        }
+        gs_program[gs_log.head]++;
+    }
+    wear = 0;
+    for (i = 0; i < LOG_TEST_ROWS; i++)
+    {
+        if (gs_program[i] > wear)
+        {
+            wear = gs_program[i];
+        }
+    }
+    if ((wear != (LOG_TEST_TIMES + LOG_TEST_ROWS - 1) / LOG_TEST_ROWS) ||
+        (a_log_test_check(LOG_TEST_TIMES - 1, LOG_TEST_ROWS) != 0))
+    {
+        printf("log_test: wear levelling failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("log_test: %d records in %d us, most worn row programmed %d times passed.\n",
+           LOG_TEST_TIMES, (int)((delay_get_ns() - start) / 1000), (int)wear);
+    
+    /* mount again */
+    if ((a_log_test_mount(LOG_TEST_ROWS) != 0) || (gs_log.sequence != LOG_TEST_TIMES - 1) ||
+        (a_log_test_check(LOG_TEST_TIMES - 1, LOG_TEST_ROWS) != 0))
+    {
+        printf("log_test: head recovery failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("log_test: head recovery passed.\n");
+    
+    /* a corrupted newest record is dropped */
+    gs_lane.device.memory[LOG_TEST_ADDRESS + gs_log.head * 8 + 2] ^= 0x01;
+    if ((a_log_test_mount(LOG_TEST_ROWS - 1) != 0) || (gs_log.sequence != LOG_TEST_TIMES - 2) ||
+        (a_log_test_check(LOG_TEST_TIMES - 2, LOG_TEST_ROWS - 1) != 0))
+    {
+        printf("log_test: corrupted record check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("log_test: corrupted record check passed.\n");
+    (void)ds2431_deinit(&gs_handle);
+    printf("log_test: passed.\n");
+    
+    return 0;
+}
@@ -0,0 +1,331 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      multi_test.c
+ * @brief     multi lane test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_multi.h"
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief multi test definition
+ */
+#define MULTI_TEST_LANE           4             /**< lanes on the port, the last one has no device */
+#define MULTI_TEST_ADDRESS        0x20          /**< first target row */
+#define MULTI_TEST_LEN            16            /**< bytes per lane */
+
+/**
+ * @brief multi test port structure definition
+ */
+typedef struct multi_test_port_s
+{
+    lane_t lane[MULTI_TEST_LANE];        /**< one simulated bus per port pin */
+} multi_test_port_t;
+
+static multi_test_port_t gs_port;                                          /**< gpio port */
+static uint8_t gs_data[MULTI_TEST_LANE * MULTI_TEST_LEN];                  /**< data buffer */
+static uint8_t gs_data_check[MULTI_TEST_LANE * MULTI_TEST_LEN];            /**< check buffer */
+static uint8_t gs_expect[MULTI_TEST_LANE][0x80];                           /**< expected memory per lane */
+
+/**
+ * @brief     port init
+ * @param[in] *user pointer to a port
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_multi_test_init(void *user)
+{
+    (void)user;
+    
+    return 0;
+}
+
+/**
+ * @brief     port deinit
+ * @param[in] *user pointer to a port
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_multi_test_deinit(void *user)
+{
+    (void)user;
+    
+    return 0;
+}
+
+/**
+ * @brief      read the port
+ * @param[in]  *user pointer to a port
+ * @param[out] *mask pointer to a level mask buffer
+ * @return     status code
+ *             - 0 success
+ * @note       pins without a lane read as released
+ */
+static uint8_t a_multi_test_read_mask(void *user, uint32_t *mask)
+{
+    uint8_t n;
+    uint8_t level;
+    multi_test_port_t *port = (multi_test_port_t *)user;
+    
+    *mask = 0xFFFFFFFFU;
+    for (n = 0; n < MULTI_TEST_LANE; n++)
+    {
+        (void)lane_read(&port->lane[n], &level);
+        if (level == 0)
+        {
+            *mask &= ~((uint32_t)1 << n);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     write the port
+ * @param[in] *user pointer to a port
+ * @param[in] mask level mask
+ * @return    status code
+ *            - 0 success
+ * @note      every pin changes at the same virtual time
+ */
+static uint8_t a_multi_test_write_mask(void *user, uint32_t mask)
+{
+    uint8_t n;
+    multi_test_port_t *port = (multi_test_port_t *)user;
+    
+    for (n = 0; n < MULTI_TEST_LANE; n++)
+    {
+        (void)lane_write(&port->lane[n], (uint8_t)((mask >> n) & 0x01));
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the failing lanes are checked through the fail mask
+ */
+static void a_multi_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+static const ds2431_multi_ops_t gs_ops =        /**< ds2431 multi ops */
+{
+    .bus_init = a_multi_test_init,
+    .bus_deinit = a_multi_test_deinit,
+    .bus_read_mask = a_multi_test_read_mask,
+    .bus_write_mask = a_multi_test_write_mask,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_multi_test_print,
+};
+
+/**
+ * @brief     fill the per lane data
+ * @param[in] seed data seed
+ * @note      every lane gets different data
+ */
+static void a_multi_test_fill(uint8_t seed)
+{
+    uint32_t i;
+    
+    for (i = 0; i < sizeof(gs_data); i++)
+    {
+        gs_data[i] = (uint8_t)(seed + i * 7);
+    }
+}
+
+/**
+ * @brief     save the rows a lane should hold
+ * @param[in] lane lane index
+ * @param[in] address first row address
+ * @param[in] len data length
+ * @note      none
+ */
+static void a_multi_test_expect(uint8_t lane, uint8_t address, uint8_t len)
+{
+    memcpy(&gs_expect[lane][address], &gs_data[lane * len], len);
+}
+
+/**
+ * @brief  check every device against the expected memory
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   the device model is the ground truth
+ */
+static uint8_t a_multi_test_check_memory(void)
+{
+    uint8_t n;
+    
+    for (n = 0; n < MULTI_TEST_LANE - 1; n++)
+    {
+        if (memcmp(gs_port.lane[n].device.memory, gs_expect[n], 0x80) != 0)
+        {
+            printf("multi_test: lane %d memory check failed.\n", n);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   lane 0 - 2 hold a device and lane 3 is empty,
+ *         lane 1 loses its device for one write and lane 2 fails one copy
+ */
+int main(void)
+{
+    uint8_t n;
+    uint8_t serial[6];
+    uint32_t lane;
+    uint32_t present;
+    uint32_t fail;
+    ds2431_multi_handle_t handle;
+    
+    (void)delay_init();
+    for (n = 0; n < MULTI_TEST_LANE; n++)
+    {
+        memset(serial, 0, 6);
+        serial[0] = (uint8_t)(n + 1);
+        lane_init(&gs_port.lane[n], serial);
+        memset(gs_expect[n], 0xFF, 0x80);
+    }
+    gs_port.lane[MULTI_TEST_LANE - 1].cut = 1;
+    DRIVER_DS2431_MULTI_LINK_INIT(&handle, ds2431_multi_handle_t);
+    DRIVER_DS2431_MULTI_LINK_OPS(&handle, &gs_ops);
+    DRIVER_DS2431_MULTI_LINK_USER(&handle, &gs_port);
+    if (ds2431_multi_init(&handle, 0x0F, &present) != 0)
+    {
+        printf("multi_test: init failed.\n");
+        
+        return 1;
+    }
+    if ((present != 0x07) || (ds2431_multi_get_lane(&handle, &lane) != 0) || (lane != 0x07))
+    {
+        printf("multi_test: presence check failed.\n");
+        (void)ds2431_multi_deinit(&handle);
+        
+        return 1;
+    }
+    printf("multi_test: lanes 0x%02X present.\n", (unsigned int)present);
+    
+    /* every lane */
+    a_multi_test_fill(0x11);
+    if ((ds2431_multi_write(&handle, MULTI_TEST_ADDRESS, gs_data, MULTI_TEST_LEN, &fail) != 0) || (fail != 0))
+    {
+        printf("multi_test: lockstep write failed.\n");
+        (void)ds2431_multi_deinit(&handle);
+        
+        return 1;
+    }
+    for (n = 0; n < MULTI_TEST_LANE - 1; n++)
+    {
+        a_multi_test_expect(n, MULTI_TEST_ADDRESS, MULTI_TEST_LEN);
+    }
+    printf("multi_test: lockstep write passed.\n");
+    
+    /* lane 1 has no presence */
+    a_multi_test_fill(0x22);
+    gs_port.lane[1].cut = 1;
+    if ((ds2431_multi_write(&handle, MULTI_TEST_ADDRESS, gs_data, MULTI_TEST_LEN, &fail) != 0) || (fail != 0x02))
+    {
+        printf("multi_test: presence fail check failed.\n");
+        (void)ds2431_multi_deinit(&handle);
+        
+        return 1;
+    }
+    gs_port.lane[1].cut = 0;
+    a_multi_test_expect(0, MULTI_TEST_ADDRESS, MULTI_TEST_LEN);
+    a_multi_test_expect(2, MULTI_TEST_ADDRESS, MULTI_TEST_LEN);
+    printf("multi_test: presence fail check passed.\n");
+    
+    /* lane 2 fails the first copy and is dropped for the second row */
+    a_multi_test_fill(0x33);
+    gs_port.lane[2].device.copy_fail = 1;
+    if ((ds2431_multi_write(&handle, MULTI_TEST_ADDRESS, gs_data, MULTI_TEST_LEN, &fail) != 0) || (fail != 0x04))
+    {
+        printf("multi_test: copy fail check failed.\n");
+        (void)ds2431_multi_deinit(&handle);
+        
+        return 1;
+    }
+    a_multi_test_expect(0, MULTI_TEST_ADDRESS, MULTI_TEST_LEN);
+    a_multi_test_expect(1, MULTI_TEST_ADDRESS, MULTI_TEST_LEN);
+    if (a_multi_test_check_memory() != 0)
+    {
+        (void)ds2431_multi_deinit(&handle);
+        
+        return 1;
+    }
+    printf("multi_test: copy fail check passed.\n");
+    
+    /* lockstep read of every lane */
+    if ((ds2431_multi_read(&handle, MULTI_TEST_ADDRESS, gs_data_check, MULTI_TEST_LEN, &fail) != 0) || (fail != 0))
+    {
+        printf("multi_test: lockstep read failed.\n");
+        (void)ds2431_multi_deinit(&handle);
+        
+        return 1;
+    }
+    for (n = 0; n < MULTI_TEST_LANE - 1; n++)
+    {
+        if (memcmp(&gs_data_check[n * MULTI_TEST_LEN], &gs_expect[n][MULTI_TEST_ADDRESS], MULTI_TEST_LEN) != 0)
+        {
+            printf("multi_test: lane %d read check failed.\n", n);
+            (void)ds2431_multi_deinit(&handle);
+            
+            return 1;
+        }
+    }
+    printf("multi_test: lockstep read passed.\n");
+    (void)ds2431_multi_deinit(&handle);
+    printf("multi_test: passed.\n");
+    
+    return 0;
+}
@@ -0,0 +1,363 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      scheduler_test.c
+ * @brief     scheduler test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_scheduler.h"
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief scheduler test definition
+ */
+#define SCHEDULER_TEST_BUS             2             /**< independent buses */
+#define SCHEDULER_TEST_DIGEST          0x78          /**< digest row of bus 0 */
+#define SCHEDULER_TEST_ROW             0x40          /**< row of the pending row check */
+#define SCHEDULER_TEST_POLL_US         100           /**< idle time between two polls */
+#define SCHEDULER_TEST_SAVED_US        30000         /**< tPROG the overlap must save at least */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the results are checked through the status codes
+ */
+static void a_scheduler_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_scheduler_test_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+static lane_t gs_lane[SCHEDULER_TEST_BUS];                      /**< one simulated bus per handle */
+static ds2431_extension_t gs_ext[SCHEDULER_TEST_BUS];           /**< handle extensions */
+static ds2431_handle_t gs_handle[SCHEDULER_TEST_BUS];           /**< ds2431 handles */
+static uint8_t gs_data_0[16];                                   /**< bus 0 data, 2 rows */
+static uint8_t gs_data_1[24];                                   /**< bus 1 data, 3 rows */
+
+/**
+ * @brief  deinit every handle
+ * @return 1
+ * @note   none
+ */
+static int a_scheduler_test_close(void)
+{
+    uint8_t n;
+    
+    for (n = 0; n < SCHEDULER_TEST_BUS; n++)
+    {
+        (void)ds2431_deinit(&gs_handle[n]);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief  check the pending row flow on bus 0
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   with the digest enabled the row stays pending for a second tPROG
+ */
+static uint8_t a_scheduler_test_row_pending(void)
+{
+    uint8_t buf[8];
+    ds2431_handle_t *handle = &gs_handle[0];
+    ds2431_bool_t pending;
+    
+    memset(buf, 0x5A, 8);
+    if (ds2431_write_row_finish(handle) != 4)
+    {
+        printf("scheduler_test: finish without a row check failed.\n");
+        
+        return 1;
+    }
+    if (ds2431_write_row_start(handle, SCHEDULER_TEST_ROW, buf) != 0)
+    {
+        printf("scheduler_test: row start failed.\n");
+        
+        return 1;
+    }
+    if (ds2431_write_row_start(handle, SCHEDULER_TEST_ROW, buf) != 7)
+    {
+        printf("scheduler_test: second row start check failed.\n");
+        
+        return 1;
+    }
+    delay_ms(10);
+    if ((ds2431_write_row_finish(handle) != 0) ||
+        (ds2431_get_row_pending(handle, &pending) != 0) || (pending != DS2431_BOOL_TRUE))
+    {
+        printf("scheduler_test: data row finish failed.\n");
+        
+        return 1;
+    }
+    delay_ms(10);
+    if ((ds2431_write_row_finish(handle) != 0) ||
+        (ds2431_get_row_pending(handle, &pending) != 0) || (pending != DS2431_BOOL_FALSE))
+    {
+        printf("scheduler_test: digest row finish failed.\n");
+        
+        return 1;
+    }
+    if ((memcmp(&gs_lane[0].device.memory[SCHEDULER_TEST_ROW], buf, 8) != 0) ||
+        (gs_lane[0].device.memory[SCHEDULER_TEST_DIGEST] != 1))
+    {
+        printf("scheduler_test: row memory check failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     fill the data and submit the requests
+ * @param[in] *sched pointer to a ds2431 scheduler structure
+ * @param[in] *request pointer to the request array
+ * @param[in] seed data seed
+ * @param[in] mask bus mask to submit
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      bus n is the scheduler bus n
+ */
+static uint8_t a_scheduler_test_submit(ds2431_scheduler_t *sched, ds2431_scheduler_request_t *request,
+                                       uint8_t seed, uint8_t mask)
+{
+    uint8_t n;
+    
+    for (n = 0; n < sizeof(gs_data_0); n++)
+    {
+        gs_data_0[n] = (uint8_t)(seed + n);
+    }
+    for (n = 0; n < sizeof(gs_data_1); n++)
+    {
+        gs_data_1[n] = (uint8_t)(seed + 0x80 + n);
+    }
+    for (n = 0; n < SCHEDULER_TEST_BUS; n++)
+    {
+        if (((mask >> n) & 0x01) != 0)
+        {
+            memset(&request[n], 0, sizeof(ds2431_scheduler_request_t));
+            request[n].op = DS2431_SCHEDULER_OP_WRITE;
+            request[n].address = (n == 0) ? 0x00 : 0x20;
+            request[n].data = (n == 0) ? gs_data_0 : gs_data_1;
+            request[n].len = (n == 0) ? sizeof(gs_data_0) : sizeof(gs_data_1);
+            if (ds2431_scheduler_submit(sched, n, &request[n]) != 0)
+            {
+                printf("scheduler_test: submit failed.\n");
+                
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     poll the scheduler until every bus is idle
+ * @param[in] *sched pointer to a ds2431 scheduler structure
+ * @return    elapsed virtual time in us
+ * @note      the virtual clock only moves while the buses run or the caller idles
+ */
+static uint32_t a_scheduler_test_run(ds2431_scheduler_t *sched)
+{
+    uint8_t busy;
+    uint64_t start;
+    
+    start = delay_get_ns();
+    busy = 1;
+    while (busy != 0)
+    {
+        (void)ds2431_scheduler_poll(sched, &busy);
+        if (busy != 0)
+        {
+            delay_us(SCHEDULER_TEST_POLL_US);
+        }
+    }
+    
+    return (uint32_t)((delay_get_ns() - start) / 1000);
+}
+
+/**
+ * @brief     check the requests and the device memory
+ * @param[in] *request pointer to the request array
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the device model is the ground truth
+ */
+static uint8_t a_scheduler_test_check(ds2431_scheduler_request_t *request)
+{
+    if ((request[0].status != DS2431_SCHEDULER_STATUS_DONE) ||
+        (request[1].status != DS2431_SCHEDULER_STATUS_DONE))
+    {
+        printf("scheduler_test: request failed.\n");
+        
+        return 1;
+    }
+    if ((memcmp(&gs_lane[0].device.memory[0x00], gs_data_0, sizeof(gs_data_0)) != 0) ||
+        (memcmp(&gs_lane[1].device.memory[0x20], gs_data_1, sizeof(gs_data_1)) != 0))
+    {
+        printf("scheduler_test: memory check failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   bus 0 writes 2 rows with the digest enabled and bus 1 writes 3 rows,
+ *         once one bus after the other and once side by side,
+ *         side by side the tPROG of one bus covers the traffic of the other
+ */
+int main(void)
+{
+    uint8_t n;
+    uint8_t bus;
+    uint8_t serial[6];
+    uint32_t digest;
+    uint32_t serial_us;
+    uint32_t parallel_us;
+    ds2431_scheduler_t sched;
+    ds2431_scheduler_request_t request[SCHEDULER_TEST_BUS];
+    
+    (void)delay_init();
+    for (n = 0; n < SCHEDULER_TEST_BUS; n++)
+    {
+        memset(serial, 0, 6);
+        serial[0] = (uint8_t)(n + 1);
+        lane_init(&gs_lane[n], serial);
+        DRIVER_DS2431_LINK_INIT(&gs_handle[n], ds2431_handle_t);
+        DRIVER_DS2431_LINK_OPS(&gs_handle[n], &gs_ops);
+        DRIVER_DS2431_LINK_USER(&gs_handle[n], &gs_lane[n]);
+        (void)ds2431_set_extension(&gs_handle[n], &gs_ext[n]);
+        if (ds2431_init(&gs_handle[n]) != 0)
+        {
+            printf("scheduler_test: init failed.\n");
+            
+            return 1;
+        }
+    }
+    if (ds2431_set_digest(&gs_handle[0], DS2431_BOOL_TRUE, SCHEDULER_TEST_DIGEST) != 0)
+    {
+        printf("scheduler_test: set digest failed.\n");
+        
+        return a_scheduler_test_close();
+    }
+    
+    /* one row by hand */
+    if (a_scheduler_test_row_pending() != 0)
+    {
+        return a_scheduler_test_close();
+    }
+    printf("scheduler_test: pending row check passed.\n");
+    
+    /* one bus after the other */
+    (void)ds2431_scheduler_init(&sched);
+    for (n = 0; n < SCHEDULER_TEST_BUS; n++)
+    {
+        if (ds2431_scheduler_add_bus(&sched, &gs_handle[n], &bus) != 0)
+        {
+            printf("scheduler_test: add bus failed.\n");
+            
+            return a_scheduler_test_close();
+        }
+    }
+    if (a_scheduler_test_submit(&sched, request, 0x10, 0x01) != 0)
+    {
+        return a_scheduler_test_close();
+    }
+    serial_us = a_scheduler_test_run(&sched);
+    if (a_scheduler_test_submit(&sched, request, 0x10, 0x02) != 0)
+    {
+        return a_scheduler_test_close();
+    }
+    serial_us += a_scheduler_test_run(&sched);
+    if (a_scheduler_test_check(request) != 0)
+    {
+        return a_scheduler_test_close();
+    }
+    printf("scheduler_test: one bus after the other in %d us.\n", (int)serial_us);
+    
+    /* two buses side by side */
+    if (a_scheduler_test_submit(&sched, request, 0x20, 0x03) != 0)
+    {
+        return a_scheduler_test_close();
+    }
+    parallel_us = a_scheduler_test_run(&sched);
+    if (a_scheduler_test_check(request) != 0)
+    {
+        return a_scheduler_test_close();
+    }
+    if ((ds2431_get_digest(&gs_handle[0], &digest) != 0) || (digest != 5) ||
+        (gs_lane[0].device.memory[SCHEDULER_TEST_DIGEST] != 5))
+    {
+        printf("scheduler_test: digest check failed.\n");
+        
+        return a_scheduler_test_close();
+    }
+    if ((parallel_us + SCHEDULER_TEST_SAVED_US) > serial_us)
+    {
+        printf("scheduler_test: %d us, tPROG did not overlap.\n", (int)parallel_us);
+        
+        return a_scheduler_test_close();
+    }
+    printf("scheduler_test: two buses side by side in %d us passed.\n", (int)parallel_us);
+    (void)a_scheduler_test_close();
+    printf("scheduler_test: passed.\n");
+    
+    return 0;
+}
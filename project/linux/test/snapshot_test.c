@@ -0,0 +1,274 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      snapshot_test.c
+ * @brief     snapshot test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_interface.h"
+#include "lane.h"
+#include "delay.h"
+#include <stdio.h>
+#include <string.h>
+
+static void a_snapshot_test_barrier(void);
+
+/**
+ * @brief snapshot barrier definition
+ * @note  every barrier of the module becomes a point where a reader or a writer cuts in
+ */
+#define DS2431_SNAPSHOT_BARRIER()        a_snapshot_test_barrier()
+
+#include "driver_ds2431_snapshot.c"
+
+/**
+ * @brief snapshot test definition
+ */
+#define SNAPSHOT_TEST_LEN        0x80          /**< data memory bytes checked by every read */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      the results are checked through the status codes
+ */
+static void a_snapshot_test_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+static const ds2431_ops_t gs_ops =        /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = a_snapshot_test_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+
+static lane_t gs_lane;                        /**< simulated bus */
+static ds2431_handle_t gs_handle;             /**< ds2431 handle */
+static ds2431_snapshot_t gs_snapshot;         /**< snapshot under test */
+static uint8_t gs_inside;                     /**< a barrier hook is running */
+static uint8_t gs_reader;                     /**< read at every writer barrier */
+static uint8_t gs_writer;                     /**< refresh at the next reader barrier */
+static uint8_t gs_old;                        /**< pattern before the refresh */
+static uint8_t gs_new;                        /**< pattern after the refresh */
+static uint32_t gs_old_seq;                   /**< sequence before the refresh */
+static uint32_t gs_old_count;                 /**< reads that saw the old image */
+static uint32_t gs_new_count;                 /**< reads that saw the new image */
+static uint32_t gs_bad_count;                 /**< reads that saw anything else */
+
+/**
+ * @brief     fill the device memory
+ * @param[in] pattern byte pattern
+ * @note      the device changes behind the handle, as if another master wrote it
+ */
+static void a_snapshot_test_fill(uint8_t pattern)
+{
+    memset(gs_lane.device.memory, pattern, SNAPSHOT_TEST_LEN);
+}
+
+/**
+ * @brief  read the snapshot and sort the result
+ * @return status code of ds2431_snapshot_read
+ * @note   a read is good if every byte and the sequence belong to one refresh
+ */
+static uint8_t a_snapshot_test_read(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t buf[SNAPSHOT_TEST_LEN];
+    uint32_t seq;
+    
+    res = ds2431_snapshot_read(&gs_snapshot, 0x00, buf, SNAPSHOT_TEST_LEN, &seq);
+    if (res != 0)
+    {
+        gs_bad_count++;
+        
+        return res;
+    }
+    for (i = 1; i < SNAPSHOT_TEST_LEN; i++)
+    {
+        if (buf[i] != buf[0])
+        {
+            gs_bad_count++;
+            
+            return res;
+        }
+    }
+    if ((buf[0] == gs_old) && (seq == gs_old_seq))
+    {
+        gs_old_count++;
+    }
+    else if ((buf[0] == gs_new) && (seq == gs_old_seq + 2))
+    {
+        gs_new_count++;
+    }
+    else
+    {
+        gs_bad_count++;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief cut in at a barrier
+ * @note  a writer barrier runs a read and a reader barrier runs a refresh,
+ *        the hooks do not nest
+ */
+static void a_snapshot_test_barrier(void)
+{
+    __sync_synchronize();
+    if (gs_inside != 0)
+    {
+        return;
+    }
+    gs_inside = 1;
+    if (gs_reader != 0)
+    {
+        (void)a_snapshot_test_read();
+    }
+    else if (gs_writer != 0)
+    {
+        gs_writer = 0;
+        a_snapshot_test_fill(gs_new);
+        (void)ds2431_snapshot_refresh(&gs_snapshot, &gs_handle);
+    }
+    gs_inside = 0;
+}
+
+/**
+ * @brief  main function
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   readers cut into a refresh at every barrier,
+ *         then a refresh cuts into a reader
+ */
+int main(void)
+{
+    uint8_t buf[8];
+    uint8_t serial[6];
+    
+    (void)delay_init();
+    memset(serial, 0, 6);
+    serial[0] = 0x01;
+    lane_init(&gs_lane, serial);
+    DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
+    DRIVER_DS2431_LINK_USER(&gs_handle, &gs_lane);
+    if (ds2431_init(&gs_handle) != 0)
+    {
+        printf("snapshot_test: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* empty snapshot */
+    (void)ds2431_snapshot_init(&gs_snapshot);
+    if (ds2431_snapshot_read(&gs_snapshot, 0x00, buf, 8, NULL) != 5)
+    {
+        printf("snapshot_test: empty check failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* first refresh */
+    gs_old = 0x11;
+    gs_new = 0x11;
+    gs_old_seq = 0;
+    a_snapshot_test_fill(gs_old);
+    if ((ds2431_snapshot_refresh(&gs_snapshot, &gs_handle) != 0) ||
+        (a_snapshot_test_read() != 0) || (gs_new_count != 1))
+    {
+        printf("snapshot_test: first refresh failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("snapshot_test: first refresh passed.\n");
+    
+    /* readers during a refresh */
+    gs_old = 0x11;
+    gs_new = 0x22;
+    gs_old_seq = 2;
+    gs_old_count = 0;
+    gs_new_count = 0;
+    a_snapshot_test_fill(gs_new);
+    gs_reader = 1;
+    if (ds2431_snapshot_refresh(&gs_snapshot, &gs_handle) != 0)
+    {
+        printf("snapshot_test: refresh failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_reader = 0;
+    if ((gs_bad_count != 0) || (gs_old_count == 0) || (gs_new_count == 0))
+    {
+        printf("snapshot_test: reads during a refresh failed, %d old %d new %d torn.\n",
+               (int)gs_old_count, (int)gs_new_count, (int)gs_bad_count);
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("snapshot_test: %d old and %d new reads during a refresh passed.\n",
+           (int)gs_old_count, (int)gs_new_count);
+    
+    /* a refresh during a read */
+    gs_old = 0x22;
+    gs_new = 0x33;
+    gs_old_seq = 4;
+    gs_old_count = 0;
+    gs_new_count = 0;
+    gs_writer = 1;
+    if ((a_snapshot_test_read() != 0) || (gs_writer != 0) ||
+        (gs_bad_count != 0) || (gs_new_count != 1))
+    {
+        printf("snapshot_test: refresh during a read failed.\n");
+        (void)ds2431_deinit(&gs_handle);
+        
+        return 1;
+    }
+    printf("snapshot_test: refresh during a read passed.\n");
+    (void)ds2431_deinit(&gs_handle);
+    printf("snapshot_test: passed.\n");
+    
+    return 0;
+}
@@ -0,0 +1,1010 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      ds2431_trace.c
+ * @brief     ds2431 trace tool source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431.h"
+#include "driver_ds2431_interface.h"
+#include "ds2431_model.h"
+#include "delay.h"
+#include "wire.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief trace tool definition
+ */
+#define TRACE_MAGIC              "DS2431TR"        /**< file magic */
+#define TRACE_VERSION            1                 /**< file version */
+#define TRACE_HEADER_SIZE        20                /**< file header size */
+#define TRACE_MAX_EVENT          4096              /**< max events in a file */
+
+/**
+ * @brief trace parser state enumeration definition
+ */
+typedef enum
+{
+    TRACE_STATE_IDLE              = 0x00,        /**< wait for a reset */
+    TRACE_STATE_ROM               = 0x01,        /**< rom command */
+    TRACE_STATE_MATCH             = 0x02,        /**< rom of a match rom */
+    TRACE_STATE_READ_ROM          = 0x03,        /**< rom of a read rom */
+    TRACE_STATE_SEARCH            = 0x04,        /**< search rom bits */
+    TRACE_STATE_FUNCTION          = 0x05,        /**< function command */
+    TRACE_STATE_READ_MEMORY       = 0x06,        /**< read memory */
+    TRACE_STATE_WRITE_SCRATCHPAD  = 0x07,        /**< write scratchpad */
+    TRACE_STATE_READ_SCRATCHPAD   = 0x08,        /**< read scratchpad */
+    TRACE_STATE_COPY_SCRATCHPAD   = 0x09,        /**< copy scratchpad */
+} trace_state_t;
+
+/**
+ * @brief trace file structure definition
+ */
+typedef struct trace_file_s
+{
+    uint8_t mode;                           /**< chip mode of the workload */
+    uint32_t lost;                          /**< events lost before the capture */
+    uint32_t count;                         /**< event count */
+    uint32_t event[TRACE_MAX_EVENT];        /**< events */
+} trace_file_t;
+
+/**
+ * @brief trace device structure definition
+ */
+typedef struct trace_device_s
+{
+    uint8_t rom[8];                                  /**< rom */
+    uint8_t rom_valid;                               /**< rom seen flag */
+    uint8_t memory[DS2431_MODEL_MEMORY_SIZE];        /**< memory before the capture */
+    uint8_t known[DS2431_MODEL_MEMORY_SIZE];         /**< byte seen before it was written */
+    uint8_t written[DS2431_MODEL_MEMORY_SIZE];       /**< byte copied during the capture */
+} trace_device_t;
+
+/**
+ * @brief trace parser structure definition
+ */
+typedef struct trace_parser_s
+{
+    uint8_t state;               /**< parser state */
+    uint8_t count;               /**< bytes in the state */
+    uint16_t address;            /**< target address */
+    uint8_t es;                  /**< ending offset */
+    uint8_t reads;               /**< bytes read after a write scratchpad */
+    uint8_t scratchpad[8];       /**< last scratchpad read */
+    uint16_t scratch_address;    /**< address of the last scratchpad read */
+    uint8_t search[8];           /**< search rom bits */
+} trace_parser_t;
+
+static const char *const gs_event_name[16] =        /**< event names */
+{
+    "?", "reset", "reset_od", "write", "write_od", "read", "read_od",
+    "write_bit", "read_2bit", "crc16", "?", "?", "?", "?", "?", "?",
+};
+static const uint8_t gs_serial[6] = {0x31, 0x24, 0x00, 0x17, 0x05, 0x26};        /**< recorded serial number */
+static const ds2431_ops_t gs_ops =                                              /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = ds2431_interface_debug_print,
+    .timestamp_us = ds2431_interface_timestamp_us,
+};
+static ds2431_trace_t gs_trace;        /**< driver trace ring */
+static trace_file_t gs_file;           /**< loaded trace */
+static trace_file_t gs_replay;         /**< replayed trace */
+
+/**
+ * @brief     run the traced workload
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] mode chip mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      record and replay must run the same calls
+ */
+static uint8_t a_trace_workload(ds2431_handle_t *handle, uint8_t mode)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t num;
+    uint8_t buf[16];
+    uint8_t rom[1][8];
+    uint16_t address;
+    uint16_t crc16;
+    ds2431_config_control_t config;
+    
+    res = 0;
+    if ((mode == DS2431_MODE_RESUME) || (mode == DS2431_MODE_OVERDRIVE_RESUME))
+    {
+        /* resume needs one match rom at the same speed */
+        res |= ds2431_set_mode(handle, (mode == DS2431_MODE_RESUME) ? DS2431_MODE_MATCH_ROM :
+                                                                      DS2431_MODE_OVERDRIVE_MATCH_ROM);
+        res |= ds2431_read(handle, 0x00, buf, 1);
+    }
+    res |= ds2431_set_mode(handle, (ds2431_mode_t)mode);
+    res |= ds2431_read(handle, 0x00, buf, 16);
+    for (i = 0; i < 8; i++)
+    {
+        buf[i] = (uint8_t)(0x11 * (i + 1));
+    }
+    res |= ds2431_write(handle, 0x20, buf, 8);
+    res |= ds2431_read_memory_config(handle, &config);
+    res |= ds2431_write_scratchpad(handle, 0x40, buf, &crc16);
+    res |= ds2431_read_scratchpad(handle, &address, buf, &crc16);
+    num = 1;
+    res |= ds2431_search_rom(handle, rom, &num);
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief      run the workload on a device model with the trace attached
+ * @param[in]  *model pointer to a ds2431 model structure
+ * @param[in]  mode chip mode
+ * @param[out] *file pointer to a trace file structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_trace_run(ds2431_model_t *model, uint8_t mode, trace_file_t *file)
+{
+    uint8_t res;
+    uint16_t len;
+    ds2431_handle_t handle;
+    ds2431_extension_t ext;
+    
+    (void)delay_init();
+    (void)wire_detach_all();
+    (void)wire_attach(model);
+    DRIVER_DS2431_LINK_INIT(&handle, ds2431_handle_t);
+    DRIVER_DS2431_LINK_OPS(&handle, &gs_ops);
+    (void)ds2431_set_extension(&handle, &ext);
+    (void)ds2431_set_trace(&handle, &gs_trace);
+    if (ds2431_init(&handle) != 0)
+    {
+        (void)wire_detach_all();
+        
+        return 1;
+    }
+    res = ds2431_set_rom(&handle, model->rom);
+    res |= a_trace_workload(&handle, mode);
+    (void)ds2431_deinit(&handle);
+    (void)wire_detach_all();
+    
+    len = TRACE_MAX_EVENT;
+    res |= ds2431_trace_read(&handle, file->event, &len, &file->lost);
+    file->count = len;
+    file->mode = mode;
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     save a trace file
+ * @param[in] *path pointer to a file path
+ * @param[in] *file pointer to a trace file structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 save failed
+ * @note      20 byte header then little endian 32 bit events
+ */
+static uint8_t a_trace_save(const char *path, const trace_file_t *file)
+{
+    uint32_t i;
+    uint8_t buf[TRACE_HEADER_SIZE];
+    FILE *fp;
+    
+    fp = fopen(path, "wb");
+    if (fp == NULL)
+    {
+        printf("ds2431_trace: can't create %s.\n", path);
+        
+        return 1;
+    }
+    memset(buf, 0, TRACE_HEADER_SIZE);
+    memcpy(buf, TRACE_MAGIC, 8);
+    buf[8] = TRACE_VERSION;
+    buf[9] = file->mode;
+    for (i = 0; i < 4; i++)
+    {
+        buf[12 + i] = (uint8_t)(file->lost >> (8 * i));
+        buf[16 + i] = (uint8_t)(file->count >> (8 * i));
+    }
+    (void)fwrite(buf, 1, TRACE_HEADER_SIZE, fp);
+    for (i = 0; i < file->count; i++)
+    {
+        buf[0] = (uint8_t)(file->event[i]);
+        buf[1] = (uint8_t)(file->event[i] >> 8);
+        buf[2] = (uint8_t)(file->event[i] >> 16);
+        buf[3] = (uint8_t)(file->event[i] >> 24);
+        (void)fwrite(buf, 1, 4, fp);
+    }
+    if (fclose(fp) != 0)
+    {
+        printf("ds2431_trace: can't write %s.\n", path);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      load a trace file
+ * @param[in]  *path pointer to a file path
+ * @param[out] *file pointer to a trace file structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       none
+ */
+static uint8_t a_trace_load(const char *path, trace_file_t *file)
+{
+    uint32_t i;
+    uint8_t buf[TRACE_HEADER_SIZE];
+    FILE *fp;
+    
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        printf("ds2431_trace: can't open %s.\n", path);
+        
+        return 1;
+    }
+    if ((fread(buf, 1, TRACE_HEADER_SIZE, fp) != TRACE_HEADER_SIZE) ||
+        (memcmp(buf, TRACE_MAGIC, 8) != 0) || (buf[8] != TRACE_VERSION))
+    {
+        printf("ds2431_trace: %s is not a trace file.\n", path);
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    file->mode = buf[9];
+    file->lost = 0;
+    file->count = 0;
+    for (i = 0; i < 4; i++)
+    {
+        file->lost |= (uint32_t)buf[12 + i] << (8 * i);
+        file->count |= (uint32_t)buf[16 + i] << (8 * i);
+    }
+    if ((file->count > TRACE_MAX_EVENT) || (file->mode > DS2431_MODE_OVERDRIVE_RESUME))
+    {
+        printf("ds2431_trace: %s header is invalid.\n", path);
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    for (i = 0; i < file->count; i++)
+    {
+        if (fread(buf, 1, 4, fp) != 4)
+        {
+            printf("ds2431_trace: %s is truncated.\n", path);
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        file->event[i] = (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+                         ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+    }
+    (void)fclose(fp);
+    
+    return 0;
+}
+
+/**
+ * @brief     get the unwrapped event times
+ * @param[in] *file pointer to a trace file structure
+ * @param[in] index event index
+ * @param[in] *last pointer to the unwrapped time of the previous event
+ * @return    time in us since the first event
+ * @note      a gap of more than 1.048576 s between two events is ambiguous
+ */
+static uint64_t a_trace_time(const trace_file_t *file, uint32_t index, uint64_t *last)
+{
+    uint32_t prev;
+    
+    if (index == 0)
+    {
+        *last = 0;
+        
+        return 0;
+    }
+    prev = DS2431_TRACE_GET_US(file->event[index - 1]);
+    *last += (DS2431_TRACE_GET_US(file->event[index]) - prev) & 0xFFFFFUL;
+    
+    return *last;
+}
+
+/**
+ * @brief     note a memory byte seen on the bus
+ * @param[in] *device pointer to a trace device structure
+ * @param[in] address byte address
+ * @param[in] value byte value
+ * @note      only the first look before any copy tells the memory before the capture
+ */
+static void a_trace_observe(trace_device_t *device, uint16_t address, uint8_t value)
+{
+    if ((address < DS2431_MODEL_MEMORY_SIZE) && (device->known[address] == 0) && (device->written[address] == 0))
+    {
+        device->memory[address] = value;
+        device->known[address] = 1;
+    }
+}
+
+/**
+ * @brief         parse one event
+ * @param[in,out] *parser pointer to a trace parser structure
+ * @param[in,out] *device pointer to a trace device structure
+ * @param[in]     event trace event
+ * @return        pointer to a note
+ * @note          follows the rom and function layer like the device does
+ */
+static const char *a_trace_parse(trace_parser_t *parser, trace_device_t *device, uint32_t event)
+{
+    uint8_t i;
+    uint8_t type;
+    uint8_t data;
+    uint8_t wr;
+    uint8_t rd;
+    
+    type = DS2431_TRACE_GET_EVENT(event);
+    data = DS2431_TRACE_GET_DATA(event);
+    wr = (type == DS2431_TRACE_WRITE) || (type == DS2431_TRACE_WRITE_OVERDRIVE);
+    rd = (type == DS2431_TRACE_READ) || (type == DS2431_TRACE_READ_OVERDRIVE);
+    if ((type == DS2431_TRACE_RESET) || (type == DS2431_TRACE_RESET_OVERDRIVE))
+    {
+        parser->state = (data == 0) ? TRACE_STATE_ROM : TRACE_STATE_IDLE;
+        parser->count = 0;
+        
+        return (data == 0) ? "presence" : "no presence";
+    }
+    if (type == DS2431_TRACE_CRC)
+    {
+        return (data == 0) ? "passed" : "failed";
+    }
+    switch (parser->state)
+    {
+        case TRACE_STATE_ROM :
+        {
+            parser->count = 0;
+            if (wr == 0)
+            {
+                break;
+            }
+            if ((data == 0x55) || (data == 0x69))
+            {
+                parser->state = TRACE_STATE_MATCH;
+                
+                return (data == 0x55) ? "match rom" : "overdrive match rom";
+            }
+            if ((data == 0xCC) || (data == 0x3C) || (data == 0xA5))
+            {
+                parser->state = TRACE_STATE_FUNCTION;
+                
+                return (data == 0xCC) ? "skip rom" : ((data == 0x3C) ? "overdrive skip rom" : "resume");
+            }
+            if (data == 0x33)
+            {
+                parser->state = TRACE_STATE_READ_ROM;
+                
+                return "read rom";
+            }
+            if (data == 0xF0)
+            {
+                parser->state = TRACE_STATE_SEARCH;
+                memset(parser->search, 0, 8);
+                
+                return "search rom";
+            }
+            parser->state = TRACE_STATE_IDLE;
+            
+            return "unknown rom command";
+        }
+        case TRACE_STATE_MATCH :
+        case TRACE_STATE_READ_ROM :
+        {
+            if ((wr == 0) && (rd == 0))
+            {
+                break;
+            }
+            device->rom[parser->count] = data;
+            parser->count++;
+            if (parser->count == 8)
+            {
+                device->rom_valid = 1;
+                parser->state = TRACE_STATE_FUNCTION;
+                parser->count = 0;
+            }
+            
+            return "rom";
+        }
+        case TRACE_STATE_SEARCH :
+        {
+            if (type != DS2431_TRACE_WRITE_BIT)
+            {
+                return "bit and complement";
+            }
+            if (data != 0)
+            {
+                parser->search[parser->count / 8] |= (uint8_t)(1 << (parser->count % 8));
+            }
+            parser->count++;
+            if (parser->count == 64)
+            {
+                for (i = 0; i < 8; i++)
+                {
+                    device->rom[i] = parser->search[i];
+                }
+                device->rom_valid = 1;
+                parser->state = TRACE_STATE_IDLE;
+            }
+            
+            return "direction";
+        }
+        case TRACE_STATE_FUNCTION :
+        {
+            if (wr == 0)
+            {
+                break;
+            }
+            parser->count = 0;
+            if (data == 0xF0)
+            {
+                parser->state = TRACE_STATE_READ_MEMORY;
+                
+                return "read memory";
+            }
+            if (data == 0x0F)
+            {
+                parser->state = TRACE_STATE_WRITE_SCRATCHPAD;
+                parser->reads = 0;
+                
+                return "write scratchpad";
+            }
+            if (data == 0xAA)
+            {
+                parser->state = TRACE_STATE_READ_SCRATCHPAD;
+                
+                return "read scratchpad";
+            }
+            if (data == 0x55)
+            {
+                parser->state = TRACE_STATE_COPY_SCRATCHPAD;
+                
+                return "copy scratchpad";
+            }
+            parser->state = TRACE_STATE_IDLE;
+            
+            return "unknown function command";
+        }
+        case TRACE_STATE_READ_MEMORY :
+        {
+            parser->count++;
+            if ((parser->count == 1) && (wr != 0))
+            {
+                parser->address = data;
+                
+                return "ta1";
+            }
+            if ((parser->count == 2) && (wr != 0))
+            {
+                parser->address |= (uint16_t)(data << 8);
+                
+                return "ta2";
+            }
+            if (rd != 0)
+            {
+                a_trace_observe(device, parser->address, data);
+                parser->address++;
+                
+                return "data";
+            }
+            break;
+        }
+        case TRACE_STATE_WRITE_SCRATCHPAD :
+        {
+            parser->count++;
+            if (parser->count <= 2)
+            {
+                return (parser->count == 1) ? "ta1" : "ta2";
+            }
+            if (wr != 0)
+            {
+                return "data";
+            }
+            parser->reads++;
+            
+            return (parser->reads <= 2) ? "crc16" : "status";
+        }
+        case TRACE_STATE_READ_SCRATCHPAD :
+        {
+            parser->count++;
+            if (parser->count == 1)
+            {
+                parser->scratch_address = data;
+                
+                return "ta1";
+            }
+            if (parser->count == 2)
+            {
+                parser->scratch_address |= (uint16_t)(data << 8);
+                
+                return "ta2";
+            }
+            if (parser->count == 3)
+            {
+                parser->es = data;
+                
+                return "es";
+            }
+            if (parser->count <= 11)
+            {
+                parser->scratchpad[parser->count - 4] = data;
+                
+                return "data";
+            }
+            
+            return (parser->count <= 13) ? "crc16" : "status";
+        }
+        case TRACE_STATE_COPY_SCRATCHPAD :
+        {
+            parser->count++;
+            if (wr != 0)
+            {
+                return (parser->count == 1) ? "ta1" : ((parser->count == 2) ? "ta2" : "es");
+            }
+            if ((parser->count == 4) && (data == 0xAA))
+            {
+                for (i = 0; i < 8; i++)
+                {
+                    if ((parser->scratch_address & ~7U) + i < DS2431_MODEL_MEMORY_SIZE)
+                    {
+                        device->written[(parser->scratch_address & ~7U) + i] = 1;
+                    }
+                }
+                
+                return "copied";
+            }
+            
+            return (parser->count == 4) ? "not copied" : "status";
+        }
+        default :
+        {
+            break;
+        }
+    }
+    
+    return "";
+}
+
+/**
+ * @brief     print the events
+ * @param[in] *file pointer to a trace file structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_trace_decode(const trace_file_t *file)
+{
+    uint32_t i;
+    uint64_t t;
+    uint64_t prev;
+    uint64_t last;
+    const char *note;
+    trace_parser_t parser;
+    trace_device_t device;
+    
+    memset(&parser, 0, sizeof(parser));
+    memset(&device, 0, sizeof(device));
+    printf("ds2431_trace: mode %d, %u events, %u lost before the capture.\n", file->mode, file->count, file->lost);
+    printf("%6s %10s %8s %-10s %4s %s\n", "index", "time_us", "delta", "event", "data", "note");
+    prev = 0;
+    for (i = 0; i < file->count; i++)
+    {
+        t = a_trace_time(file, i, &last);
+        note = a_trace_parse(&parser, &device, file->event[i]);
+        printf("%6u %10llu %8llu %-10s 0x%02X %s\n", i, (unsigned long long)t, (unsigned long long)(t - prev),
+               gs_event_name[DS2431_TRACE_GET_EVENT(file->event[i])], DS2431_TRACE_GET_DATA(file->event[i]), note);
+        prev = t;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     write a vcd level change
+ * @param[in] *fp pointer to a file
+ * @param[in] t time in us
+ * @param[in] *now pointer to the current vcd time
+ * @param[in] level line level
+ * @note      times never go back, so overlapping nominal slots are clamped
+ */
+static void a_trace_vcd_level(FILE *fp, uint64_t t, uint64_t *now, uint8_t level)
+{
+    if (t > *now)
+    {
+        *now = t;
+        fprintf(fp, "#%llu\n", (unsigned long long)t);
+    }
+    fprintf(fp, "%d!\n", level);
+}
+
+/**
+ * @brief     write one read or write slot
+ * @param[in] *fp pointer to a file
+ * @param[in] t slot start in us
+ * @param[in] *now pointer to the current vcd time
+ * @param[in] low master or slave low time in us
+ * @note      none
+ */
+static void a_trace_vcd_slot(FILE *fp, uint64_t t, uint64_t *now, uint32_t low)
+{
+    a_trace_vcd_level(fp, t, now, 0);
+    a_trace_vcd_level(fp, t + low, now, 1);
+}
+
+/**
+ * @brief     export the events as a vcd file
+ * @param[in] *file pointer to a trace file structure
+ * @param[in] *path pointer to a vcd file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 export failed
+ * @note      the owire signal is rebuilt from the event start times with the nominal
+ *            driver slot timing, so it can be fed to the sigrok onewire_link decoder
+ */
+static uint8_t a_trace_vcd(const trace_file_t *file, const char *path)
+{
+    uint8_t j;
+    uint8_t type;
+    uint8_t data;
+    uint8_t od;
+    uint32_t i;
+    uint64_t t;
+    uint64_t last;
+    uint64_t now;
+    FILE *fp;
+    
+    fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        printf("ds2431_trace: can't create %s.\n", path);
+        
+        return 1;
+    }
+    fprintf(fp, "$version ds2431_trace $end\n$timescale 1us $end\n$scope module ds2431 $end\n");
+    fprintf(fp, "$var wire 1 ! owire $end\n$var wire 4 \" event $end\n$var wire 8 # data $end\n");
+    fprintf(fp, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n1!\nb0 \"\nb0 #\n$end\n");
+    now = 0;
+    for (i = 0; i < file->count; i++)
+    {
+        t = a_trace_time(file, i, &last);
+        type = DS2431_TRACE_GET_EVENT(file->event[i]);
+        data = DS2431_TRACE_GET_DATA(file->event[i]);
+        od = (type == DS2431_TRACE_RESET_OVERDRIVE) || (type == DS2431_TRACE_WRITE_OVERDRIVE) ||
+             (type == DS2431_TRACE_READ_OVERDRIVE);
+        if (t > now)
+        {
+            now = t;
+            fprintf(fp, "#%llu\n", (unsigned long long)t);
+        }
+        fprintf(fp, "b");
+        for (j = 0; j < 4; j++)
+        {
+            fprintf(fp, "%d", (type >> (3 - j)) & 0x01);
+        }
+        fprintf(fp, " \"\nb");
+        for (j = 0; j < 8; j++)
+        {
+            fprintf(fp, "%d", (data >> (7 - j)) & 0x01);
+        }
+        fprintf(fp, " #\n");
+        switch (type)
+        {
+            case DS2431_TRACE_RESET :
+            case DS2431_TRACE_RESET_OVERDRIVE :
+            {
+                a_trace_vcd_slot(fp, t, &now, (od != 0) ? 70 : 550);
+                if (data == 0)
+                {
+                    t += (od != 0) ? (70 + DS2431_MODEL_PDH_OD_NS / 1000) : (550 + DS2431_MODEL_PDH_NS / 1000);
+                    a_trace_vcd_slot(fp, t, &now, (od != 0) ? (DS2431_MODEL_PDL_OD_NS / 1000) :
+                                                              (DS2431_MODEL_PDL_NS / 1000));
+                }
+                break;
+            }
+            case DS2431_TRACE_WRITE :
+            case DS2431_TRACE_WRITE_OVERDRIVE :
+            {
+                for (j = 0; j < 8; j++)
+                {
+                    if (((data >> j) & 0x01) != 0)
+                    {
+                        a_trace_vcd_slot(fp, t, &now, (od != 0) ? 1 : 6);
+                        t += (od != 0) ? 11 : 71;
+                    }
+                    else
+                    {
+                        a_trace_vcd_slot(fp, t, &now, (od != 0) ? 10 : 65);
+                        t += (od != 0) ? 12 : 71;
+                    }
+                }
+                break;
+            }
+            case DS2431_TRACE_READ :
+            case DS2431_TRACE_READ_OVERDRIVE :
+            {
+                for (j = 0; j < 8; j++)
+                {
+                    if (((data >> j) & 0x01) != 0)
+                    {
+                        a_trace_vcd_slot(fp, t, &now, (od != 0) ? 1 : 6);
+                    }
+                    else
+                    {
+                        a_trace_vcd_slot(fp, t, &now, (od != 0) ? (DS2431_MODEL_HOLD_OD_NS / 1000) :
+                                                                  (DS2431_MODEL_HOLD_NS / 1000));
+                    }
+                    t += (od != 0) ? 11 : 62;
+                }
+                break;
+            }
+            case DS2431_TRACE_READ_2BIT :
+            {
+                for (j = 0; j < 2; j++)
+                {
+                    a_trace_vcd_slot(fp, t, &now, (((data >> (1 - j)) & 0x01) != 0) ? 6 : (DS2431_MODEL_HOLD_NS / 1000));
+                    t += 62;
+                }
+                break;
+            }
+            case DS2431_TRACE_WRITE_BIT :
+            {
+                a_trace_vcd_slot(fp, t, &now, (data != 0) ? 12 : 65);
+                break;
+            }
+            default :
+            {
+                break;
+            }
+        }
+    }
+    if (fclose(fp) != 0)
+    {
+        printf("ds2431_trace: can't write %s.\n", path);
+        
+        return 1;
+    }
+    printf("ds2431_trace: wrote %u events to %s.\n", file->count, path);
+    
+    return 0;
+}
+
+/**
+ * @brief     record the workload on the device model
+ * @param[in] *path pointer to a trace file path
+ * @param[in] mode chip mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ * @note      none
+ */
+static uint8_t a_trace_record(const char *path, uint8_t mode)
+{
+    uint16_t i;
+    static ds2431_model_t model;
+    
+    ds2431_model_init(&model, gs_serial);
+    for (i = 0; i < 0x80; i++)
+    {
+        model.memory[i] = (uint8_t)(i * 7 + 3);
+    }
+    if (a_trace_run(&model, mode, &gs_file) != 0)
+    {
+        printf("ds2431_trace: workload failed.\n");
+        
+        return 1;
+    }
+    if (gs_file.lost != 0)
+    {
+        printf("ds2431_trace: %u events lost, DS2431_TRACE_SIZE is too small.\n", gs_file.lost);
+        
+        return 1;
+    }
+    if (a_trace_save(path, &gs_file) != 0)
+    {
+        return 1;
+    }
+    printf("ds2431_trace: recorded %u events in mode %d to %s.\n", gs_file.count, mode, path);
+    
+    return 0;
+}
+
+/**
+ * @brief     replay a trace against the driver
+ * @param[in] *file pointer to a trace file structure
+ * @return    status code
+ *            - 0 the replay matches and is not slower
+ *            - 1 the replay differs, is slower or failed
+ * @note      the rom and the memory read in the trace rebuild the device model,
+ *            then the workload runs again and its events are compared one by one
+ */
+static uint8_t a_trace_replay(const trace_file_t *file)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t n;
+    uint32_t diff;
+    uint32_t drift;
+    uint64_t t0;
+    uint64_t t1;
+    uint64_t last0;
+    uint64_t last1;
+    uint64_t bus0;
+    uint64_t bus1;
+    trace_parser_t parser;
+    static trace_device_t device;
+    static ds2431_model_t model;
+    
+    if (file->lost != 0)
+    {
+        printf("ds2431_trace: %u events were lost, the trace can't be replayed.\n", file->lost);
+        
+        return 1;
+    }
+    
+    /* rebuild the device from the trace */
+    memset(&parser, 0, sizeof(parser));
+    memset(&device, 0, sizeof(device));
+    for (i = 0; i < file->count; i++)
+    {
+        (void)a_trace_parse(&parser, &device, file->event[i]);
+    }
+    ds2431_model_init(&model, (device.rom_valid != 0) ? &device.rom[1] : gs_serial);
+    if ((device.rom_valid != 0) && (memcmp(model.rom, device.rom, 8) != 0))
+    {
+        printf("ds2431_trace: traced rom has a bad family code or crc8.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < DS2431_MODEL_MEMORY_SIZE; i++)
+    {
+        if (device.known[i] != 0)
+        {
+            model.memory[i] = device.memory[i];
+        }
+    }
+    
+    /* run again and compare */
+    res = a_trace_run(&model, file->mode, &gs_replay);
+    n = (file->count < gs_replay.count) ? file->count : gs_replay.count;
+    diff = n;
+    drift = n;
+    bus0 = 0;
+    bus1 = 0;
+    for (i = 0; i < n; i++)
+    {
+        t0 = a_trace_time(file, i, &last0);
+        t1 = a_trace_time(&gs_replay, i, &last1);
+        if ((diff == n) && ((file->event[i] & 0xFFF00000UL) != (gs_replay.event[i] & 0xFFF00000UL)))
+        {
+            diff = i;
+            printf("ds2431_trace: event %u differs, recorded %s 0x%02X at %llu us, replayed %s 0x%02X at %llu us.\n",
+                   i, gs_event_name[DS2431_TRACE_GET_EVENT(file->event[i])], DS2431_TRACE_GET_DATA(file->event[i]),
+                   (unsigned long long)t0, gs_event_name[DS2431_TRACE_GET_EVENT(gs_replay.event[i])],
+                   DS2431_TRACE_GET_DATA(gs_replay.event[i]), (unsigned long long)t1);
+        }
+        if ((diff == n) && (drift == n) && (t0 != t1))
+        {
+            drift = i;
+            printf("ds2431_trace: event %u %s starts at %llu us recorded and %llu us replayed.\n",
+                   i, gs_event_name[DS2431_TRACE_GET_EVENT(file->event[i])],
+                   (unsigned long long)t0, (unsigned long long)t1);
+        }
+    }
+    for (i = 0; i < file->count; i++)
+    {
+        bus0 = a_trace_time(file, i, &last0);
+    }
+    for (i = 0; i < gs_replay.count; i++)
+    {
+        bus1 = a_trace_time(&gs_replay, i, &last1);
+    }
+    printf("ds2431_trace: %u events recorded, %u replayed.\n", file->count, gs_replay.count);
+    printf("ds2431_trace: bus time %llu us recorded, %llu us replayed.\n",
+           (unsigned long long)bus0, (unsigned long long)bus1);
+    if ((res != 0) || (diff != n) || (file->count != gs_replay.count) || (bus1 > bus0))
+    {
+        printf("ds2431_trace: replay failed.\n");
+        
+        return 1;
+    }
+    printf("ds2431_trace: replay %s.\n", (bus1 == bus0) ? "matches" : "matches and is faster");
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      ds2431_trace record <file> [mode]
+ *            ds2431_trace decode <file>
+ *            ds2431_trace vcd <file> <vcd file>
+ *            ds2431_trace replay <file>
+ */
+int main(int argc, char **argv)
+{
+    uint8_t mode;
+    
+    if ((argc >= 3) && (strcmp(argv[1], "record") == 0))
+    {
+        mode = (argc > 3) ? (uint8_t)strtoul(argv[3], NULL, 0) : DS2431_MODE_MATCH_ROM;
+        if (mode > DS2431_MODE_OVERDRIVE_RESUME)
+        {
+            printf("ds2431_trace: mode must be 0 - 5.\n");
+            
+            return 1;
+        }
+        
+        return a_trace_record(argv[2], mode);
+    }
+    if ((argc == 3) && (strcmp(argv[1], "decode") == 0))
+    {
+        return (a_trace_load(argv[2], &gs_file) != 0) ? 1 : a_trace_decode(&gs_file);
+    }
+    if ((argc == 4) && (strcmp(argv[1], "vcd") == 0))
+    {
+        return (a_trace_load(argv[2], &gs_file) != 0) ? 1 : a_trace_vcd(&gs_file, argv[3]);
+    }
+    if ((argc == 3) && (strcmp(argv[1], "replay") == 0))
+    {
+        return (a_trace_load(argv[2], &gs_file) != 0) ? 1 : a_trace_replay(&gs_file);
+    }
+    printf("usage: ds2431_trace record <file> [mode]\n");
+    printf("       ds2431_trace decode <file>\n");
+    printf("       ds2431_trace vcd <file> <vcd file>\n");
+    printf("       ds2431_trace replay <file>\n");
+    
+    return 1;
+}
@@ -41,93 +41,136 @@
 #include <stdarg.h>
 
 /**
- * @brief  interface bus init
- * @return status code
- *         - 0 success
- *         - 1 bus init failed
- * @note   none
+ * @brief     interface bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus init failed
+ * @note      the board has one bus on PA8 and user is not used,
+ *            see the interface template for a board with several buses
  */
-uint8_t ds2431_interface_init(void)
+uint8_t ds2431_interface_init(void *user)
 {
     return wire_init();
 }
 
 /**
- * @brief  interface bus deinit
- * @return status code
- *         - 0 success
- *         - 1 bus deinit failed
- * @note   none
+ * @brief     interface bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus deinit failed
+ * @note      the board has one bus on PA8 and user is not used
  */
-uint8_t ds2431_interface_deinit(void)
+uint8_t ds2431_interface_deinit(void *user)
 {
     return wire_deinit();
 }
 
 /**
  * @brief      interface bus read
+ * @param[in]  *user pointer to a user context
  * @param[out] *value pointer to a value buffer
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       the board has one bus on PA8 and user is not used
  */
-uint8_t ds2431_interface_read(uint8_t *value)
+uint8_t ds2431_interface_read(void *user, uint8_t *value)
 {
     return wire_read(value);
 }
 
 /**
  * @brief     interface bus write
+ * @param[in] *user pointer to a user context
  * @param[in] value written value
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the board has one bus on PA8 and user is not used
  */
-uint8_t ds2431_interface_write(uint8_t value)
+uint8_t ds2431_interface_write(void *user, uint8_t value)
 {
     return wire_write(value);
 }
 
 /**
  * @brief     interface delay ms
+ * @param[in] *user pointer to a user context
  * @param[in] ms time
  * @note      none
  */
-void ds2431_interface_delay_ms(uint32_t ms)
+void ds2431_interface_delay_ms(void *user, uint32_t ms)
 {
     delay_ms(ms);
 }
 
 /**
  * @brief     interface delay us
+ * @param[in] *user pointer to a user context
  * @param[in] us time
  * @note      none
  */
-void ds2431_interface_delay_us(uint32_t us)
+void ds2431_interface_delay_us(void *user, uint32_t us)
 {
     delay_us(us);
 }
 
 /**
- * @brief interface enable the interrupt
- * @note  none
+ * @brief     interface enable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
  */
-void ds2431_interface_enable_irq(void)
+void ds2431_interface_enable_irq(void *user)
 {
     __enable_irq();
 }
 
 /**
- * @brief interface disable the interrupt
- * @note  none
+ * @brief     interface disable the interrupt
+ * @param[in] *user pointer to a user context
+ * @note      none
  */
-void ds2431_interface_disable_irq(void)
+void ds2431_interface_disable_irq(void *user)
 {
     __disable_irq();
 }
 
+/**
+ * @brief     interface get the timestamp
+ * @param[in] *user pointer to a user context
+ * @return    timestamp in us
+ * @note      the driver reads it with the irq disabled, so a systick reload whose interrupt
+ *            is still pending is counted here, the irq must not stay disabled for a whole tick
+ */
+uint32_t ds2431_interface_timestamp_us(void *user)
+{
+    uint32_t ms;
+    uint32_t val;
+    uint32_t pending;
+    
+    /* read the tick and the systick counter consistently */
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+        pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+        if (pending != 0)
+        {
+            /* the counter has reloaded, read it again after the reload */
+            val = SysTick->VAL;
+        }
+    } while (ms != HAL_GetTick());
+    if (pending != 0)
+    {
+        /* the tick of the reload is not counted yet */
+        ms++;
+    }
+    
+    return ms * 1000 + (SysTick->LOAD - val) / ((SysTick->LOAD + 1) / 1000);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -63,6 +63,438 @@
 #define DS2431_CMD_COPY_SCRATCHPAD            0x55        /**< copy scratchpad command */
 #define DS2431_CMD_READ_MEMORY                0xF0        /**< read memory command */
 
+/**
+ * @brief digest row definition
+ */
+#define DS2431_DIGEST_MAGIC        0x47        /**< generation row magic */
+
+/**
+ * @brief     get the stats timestamp
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    timestamp in us
+ * @note      0 without stats or a timestamp_us callback
+ */
+static uint32_t a_ds2431_stats_us(ds2431_handle_t *handle)
+{
+    if ((handle->ext == NULL) || (handle->ext->stats == NULL) ||
+        (handle->ops->timestamp_us == NULL))                                   /* check stats */
+    {
+        return 0;                                                              /* no timestamp */
+    }
+    
+    return handle->ops->timestamp_us(handle->user);                            /* return timestamp */
+}
+
+/**
+ * @brief     lock the bus
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] api stats api holding the bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      the hold time counts from before the lock, so it includes the wait for it,
+ *            the begin hook runs once the lock is taken and before any bus activity,
+ *            a handle without an extension skips the stats and the hooks
+ */
+static uint8_t a_ds2431_lock(ds2431_handle_t *handle, uint8_t api)
+{
+    ds2431_extension_t *ext;
+    uint32_t us;
+    
+    us = a_ds2431_stats_us(handle);                                                   /* hold start */
+    if (handle->ops->lock != NULL)                                                    /* check lock */
+    {
+        if (handle->ops->lock(handle->user) != 0)                                     /* lock */
+        {
+            handle->ops->debug_print("ds2431: lock failed.\n");                       /* lock failed */
+            
+            return 1;                                                                 /* return error */
+        }
+    }
+    ext = handle->ext;                                                                /* get extension */
+    if (ext == NULL)                                                                  /* check extension */
+    {
+        return 0;                                                                     /* plain handle */
+    }
+    ext->hold_api = api;                                                              /* save api */
+    ext->hold_start_us = us;                                                          /* save start */
+    ext->transaction.op = api;                                                        /* set operation */
+    ext->transaction.mode = handle->mode;                                             /* set mode */
+    memcpy(ext->transaction.rom, handle->rom, 8);                                     /* set target rom */
+    ext->transaction.byte_write = 0;                                                  /* init 0 */
+    ext->transaction.byte_read = 0;                                                   /* init 0 */
+    ext->transaction.result = 0;                                                      /* init 0 */
+    if (handle->ops->on_transaction_begin != NULL)                                    /* check begin hook */
+    {
+        handle->ops->on_transaction_begin(handle->user, &ext->transaction);           /* begin transaction */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     unlock the bus
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] res transaction status code
+ * @note      the end hook runs after the last bus activity and before the lock is released,
+ *            the hold time goes to the histogram bin of its bit length
+ */
+static void a_ds2431_unlock(ds2431_handle_t *handle, uint8_t res)
+{
+    ds2431_extension_t *ext;
+    ds2431_stats_t *stats;
+    uint32_t us;
+    uint32_t i;
+    uint8_t bin;
+    
+    ext = handle->ext;                                                              /* get extension */
+    stats = NULL;                                                                   /* init NULL */
+    if (ext != NULL)                                                                /* check extension */
+    {
+        ext->transaction.result = res;                                              /* set result */
+        if (handle->ops->on_transaction_end != NULL)                                /* check end hook */
+        {
+            handle->ops->on_transaction_end(handle->user, &ext->transaction);       /* end transaction */
+        }
+        stats = ext->stats;                                                         /* get stats */
+    }
+    if ((stats != NULL) && (handle->ops->timestamp_us != NULL) &&
+        (ext->hold_api < DS2431_STATS_API_NUM))                                     /* check stats */
+    {
+        us = handle->ops->timestamp_us(handle->user) - ext->hold_start_us;          /* hold time */
+        stats->total_us[ext->hold_api] += us;                                       /* add total */
+        bin = 0;                                                                    /* init 0 */
+        for (i = us; (i != 0) && (bin < (DS2431_STATS_BINS - 1)); i >>= 1)          /* bit length */
+        {
+            bin++;                                                                  /* next bin */
+        }
+        stats->histogram[ext->hold_api][bin]++;                                     /* add sample */
+    }
+    if (handle->ops->unlock != NULL)                                                /* check unlock */
+    {
+        handle->ops->unlock(handle->user);                                          /* unlock */
+    }
+}
+
+/**
+ * @brief     get the trace timestamp
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    timestamp in us
+ * @note      0 without a trace or a timestamp_us callback
+ */
+static uint32_t a_ds2431_trace_us(ds2431_handle_t *handle)
+{
+    if ((handle->ext == NULL) || (handle->ext->trace == NULL) ||
+        (handle->ops->timestamp_us == NULL))                                   /* check trace */
+    {
+        return 0;                                                              /* no timestamp */
+    }
+    
+    return handle->ops->timestamp_us(handle->user);                            /* return timestamp */
+}
+
+/**
+ * @brief     record a bus event
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] event trace event
+ * @param[in] data event data
+ * @param[in] us timestamp at the start of the event
+ * @note      the event goes to the transaction byte counts, the trace and the stats counters,
+ *            a handle without an extension records nothing
+ */
+static void a_ds2431_trace(ds2431_handle_t *handle, uint8_t event, uint8_t data, uint32_t us)
+{
+    ds2431_extension_t *ext;
+    ds2431_trace_t *trace;
+    ds2431_stats_t *stats;
+    
+    ext = handle->ext;                                                                               /* get extension */
+    if (ext == NULL)                                                                                 /* check extension */
+    {
+        return;                                                                                      /* plain handle */
+    }
+    if ((event == DS2431_TRACE_WRITE) || (event == DS2431_TRACE_WRITE_OVERDRIVE))                    /* check write byte */
+    {
+        ext->transaction.byte_write++;                                                               /* byte++ */
+    }
+    else if ((event == DS2431_TRACE_READ) || (event == DS2431_TRACE_READ_OVERDRIVE))                 /* check read byte */
+    {
+        ext->transaction.byte_read++;                                                                /* byte++ */
+    }
+    stats = ext->stats;                                                                              /* get stats */
+    if (stats != NULL)                                                                               /* check stats */
+    {
+        if ((event == DS2431_TRACE_RESET) || (event == DS2431_TRACE_RESET_OVERDRIVE))                /* check reset */
+        {
+            stats->reset++;                                                                          /* reset++ */
+            stats->presence_fail += data;                                                            /* no presence */
+        }
+        else if ((event == DS2431_TRACE_WRITE) || (event == DS2431_TRACE_WRITE_OVERDRIVE))           /* check write byte */
+        {
+            stats->byte_write++;                                                                     /* byte++ */
+            stats->bit_write += 8;                                                                   /* 8 slots */
+        }
+        else if ((event == DS2431_TRACE_READ) || (event == DS2431_TRACE_READ_OVERDRIVE))             /* check read byte */
+        {
+            stats->byte_read++;                                                                      /* byte++ */
+            stats->bit_read += 8;                                                                    /* 8 slots */
+        }
+        else if (event == DS2431_TRACE_WRITE_BIT)                                                    /* check write bit */
+        {
+            stats->bit_write++;                                                                      /* 1 slot */
+        }
+        else if (event == DS2431_TRACE_READ_2BIT)                                                    /* check read 2 bits */
+        {
+            stats->bit_read += 2;                                                                    /* 2 slots */
+        }
+        else                                                                                         /* crc16 */
+        {
+            stats->crc_error += data;                                                                /* crc16 error */
+        }
+    }
+    trace = ext->trace;                                                                              /* get trace */
+    if (trace == NULL)                                                                               /* check trace */
+    {
+        return;                                                                                      /* no trace */
+    }
+    trace->event[trace->head & (DS2431_TRACE_SIZE - 1)] = DS2431_TRACE_PACK(event, data, us);        /* save event */
+    trace->head++;                                                                                   /* next event */
+}
+
+/**
+ * @brief     record a crc16 check
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] crc crc16 residual
+ * @note      none
+ */
+static void a_ds2431_trace_crc(ds2431_handle_t *handle, uint16_t crc)
+{
+    if ((handle->ext == NULL) ||
+        ((handle->ext->trace == NULL) && (handle->ext->stats == NULL)))        /* check trace and stats */
+    {
+        return;                                                                /* nothing to record */
+    }
+    a_ds2431_trace(handle, DS2431_TRACE_CRC, (crc != 0xB001U) ? 1 : 0,
+                   a_ds2431_trace_us(handle));                                 /* record result */
+}
+
+/**
+ * @brief     disable irq
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @note      the window is timed for the stats when timestamp_us is linked
+ */
+static void a_ds2431_disable_irq(ds2431_handle_t *handle)
+{
+    handle->ops->disable_irq(handle->user);                                     /* disable irq */
+    if ((handle->ext != NULL) && (handle->ext->stats != NULL))                  /* check stats */
+    {
+        handle->ext->irq_start_us = a_ds2431_stats_us(handle);                  /* window start */
+    }
+}
+
+/**
+ * @brief     enable irq
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @note      none
+ */
+static void a_ds2431_enable_irq(ds2431_handle_t *handle)
+{
+    ds2431_stats_t *stats;
+    uint32_t us;
+    
+    stats = (handle->ext != NULL) ? handle->ext->stats : NULL;             /* get stats */
+    if (stats != NULL)                                                     /* check stats */
+    {
+        us = a_ds2431_stats_us(handle) - handle->ext->irq_start_us;        /* window length */
+        stats->irq_off_us += us;                                           /* add total */
+        if (us > stats->irq_max_us)                                        /* check max */
+        {
+            stats->irq_max_us = us;                                        /* save max */
+        }
+    }
+    handle->ops->enable_irq(handle->user);                                 /* enable irq */
+}
+
+/**
+ * @brief     wait for tPROG
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] ms wait time in ms
+ * @note      none
+ */
+static void a_ds2431_prog_wait(ds2431_handle_t *handle, uint32_t ms)
+{
+    if ((handle->ext != NULL) && (handle->ext->stats != NULL))        /* check stats */
+    {
+        handle->ext->stats->prog_wait++;                              /* wait++ */
+        handle->ext->stats->prog_ms += ms;                            /* add time */
+    }
+    handle->ops->delay_ms(handle->user, ms);                          /* delay */
+}
+
+/**
+ * @brief     get the attached cache
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    pointer to a ds2431 cache structure
+ * @note      NULL without an extension or a cache
+ */
+static ds2431_cache_t *a_ds2431_cache(ds2431_handle_t *handle)
+{
+    if (handle->ext == NULL)                  /* check extension */
+    {
+        return NULL;                          /* no cache */
+    }
+    
+    return handle->ext->cache;                /* return cache */
+}
+
+/**
+ * @brief     check the digest
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    1 if the digest is enabled, 0 if not
+ * @note      none
+ */
+static uint8_t a_ds2431_digest_on(ds2431_handle_t *handle)
+{
+    if (handle->ext == NULL)                   /* check extension */
+    {
+        return 0;                              /* no digest */
+    }
+    
+    return handle->ext->digest;                /* return digest */
+}
+
+/**
+ * @brief     drop the cached memory config
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @note      none
+ */
+static void a_ds2431_config_drop(ds2431_handle_t *handle)
+{
+    if (handle->ext != NULL)                /* check extension */
+    {
+        handle->ext->config_valid = 0;      /* drop cached config */
+    }
+}
+
+/**
+ * @brief     drop the state that belongs to the selected device
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @note      the cached config, the shadow rows and the digest row tracking
+ */
+static void a_ds2431_select_drop(ds2431_handle_t *handle)
+{
+    if (handle->ext == NULL)                       /* check extension */
+    {
+        return;                                    /* nothing to drop */
+    }
+    
+    a_ds2431_config_drop(handle);                  /* drop cached config */
+    if (handle->ext->cache != NULL)                /* check cache */
+    {
+        handle->ext->cache->valid = 0;             /* drop the shadow rows */
+        handle->ext->cache->dirty = 0;             /* drop pending data */
+        handle->ext->cache->count = 0;             /* clear write count */
+    }
+    handle->ext->digest = 0;                       /* disable digest */
+    handle->ext->digest_address = 0;               /* clear digest address */
+    handle->ext->generation = 0;                   /* clear generation */
+}
+
+/**
+ * @brief     get the control byte of a page
+ * @param[in] *config pointer to a ds2431 config control structure
+ * @param[in] page page index
+ * @return    page control byte
+ * @note      none
+ */
+static uint8_t a_ds2431_page_control(const ds2431_config_control_t *config, uint8_t page)
+{
+    if (page == 0)                                             /* page 0 */
+    {
+        return config->page0_protection_control;               /* return page0 control */
+    }
+    else if (page == 1)                                        /* page 1 */
+    {
+        return config->page1_protection_control;               /* return page1 control */
+    }
+    else if (page == 2)                                        /* page 2 */
+    {
+        return config->page2_protection_control;               /* return page2 control */
+    }
+    else                                                       /* page 3 */
+    {
+        return config->page3_protection_control;               /* return page3 control */
+    }
+}
+
+/**
+ * @brief     get the row mask of a range
+ * @param[in] address input address
+ * @param[in] len data length
+ * @return    row mask
+ * @note      none
+ */
+static uint32_t a_ds2431_cache_mask(uint16_t address, uint16_t len)
+{
+    uint16_t row;
+    uint32_t mask;
+    
+    mask = 0;                                                             /* init 0 */
+    if (len == 0)                                                         /* check length */
+    {
+        return mask;                                                      /* return mask */
+    }
+    for (row = address / 8; row <= (address + len - 1) / 8; row++)        /* every row */
+    {
+        mask |= 1UL << row;                                               /* set row */
+    }
+    
+    return mask;                                                          /* return mask */
+}
+
+/**
+ * @brief     update the cached row after a write
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address row address
+ * @param[in] *data pointer to the written data
+ * @param[in] res write result
+ * @note      the cached config is dropped for a write at or above 0x80, the row is invalidated
+ *            if the write failed or if the cached config is unknown or marks the page as protected or eprom mode
+ */
+static void a_ds2431_cache_update(ds2431_handle_t *handle, uint16_t address, uint8_t data[8], uint8_t res)
+{
+    uint8_t row;
+    uint8_t control;
+    ds2431_cache_t *cache;
+    
+    if (address >= DS2431_CACHE_SIZE)                                             /* check config row */
+    {
+        a_ds2431_config_drop(handle);                                             /* drop cached config */
+        
+        return;                                                                   /* not in the image */
+    }
+    cache = a_ds2431_cache(handle);                                               /* get cache */
+    if (cache == NULL)                                                            /* check cache */
+    {
+        return;                                                                   /* no cache */
+    }
+    row = (uint8_t)(address / 8);                                                 /* get row */
+    cache->valid &= ~(1UL << row);                                                /* invalidate row */
+    cache->dirty &= ~(1UL << row);                                                /* drop pending data */
+    if ((res != 0) || (handle->ext->config_valid == 0))                           /* check result and config */
+    {
+        return;                                                                   /* keep invalid */
+    }
+    control = a_ds2431_page_control(&handle->ext->config, row / 4);               /* get page control */
+    if ((control == DS2431_CONFIG_EPROM_MODE) ||
+        (control == DS2431_CONFIG_WRITE_PROTECT_MODE))                            /* check page control */
+    {
+        return;                                                                   /* keep invalid */
+    }
+    memcpy(&cache->image[row * 8], data, 8);                                      /* write through */
+    cache->valid |= 1UL << row;                                                   /* set valid */
+}
+
 /**
  * @brief     crc16 update
  * @param[in] input input crc16
@@ -104,41 +536,44 @@ static uint8_t a_ds2431_reset(ds2431_handle_t *handle)
 {
     uint8_t retry = 0;
     uint8_t res;
+    uint32_t us;
     
-    handle->disable_irq();                                              /* disable irq */
-    if (handle->bus_write(0) != 0)                                      /* write 0 */
+    us = a_ds2431_trace_us(handle);                                     /* trace start */
+    a_ds2431_disable_irq(handle);                                       /* disable irq */
+    if (handle->ops->bus_write(handle->user, 0) != 0)                   /* write 0 */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds2431: bus write failed.\n");             /* write failed */
+        a_ds2431_enable_irq(handle);                                    /* enable irq */
+        handle->ops->debug_print("ds2431: bus write failed.\n");        /* write failed */
         
         return 1;                                                       /* return error */
     }
-    handle->delay_us(550);                                              /* wait 550 us */
-    if (handle->bus_write(1) != 0)                                      /* write 1 */
+    handle->ops->delay_us(handle->user, DS2431_TIME_RSTL_US);           /* wait 550 us */
+    if (handle->ops->bus_write(handle->user, 1) != 0)                   /* write 1 */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds2431: bus write failed.\n");             /* write failed */
+        a_ds2431_enable_irq(handle);                                    /* enable irq */
+        handle->ops->debug_print("ds2431: bus write failed.\n");        /* write failed */
         
         return 1;                                                       /* return error */
     }
-    handle->delay_us(15);                                               /* wait 15 us */
+    handle->ops->delay_us(handle->user, DS2431_TIME_MSP_US);            /* wait 15 us */
     res = 1;                                                            /* reset res */
     while ((res != 0) && (retry < 200))                                 /* wait 200 us */
     {
-        if (handle->bus_read((uint8_t *)&res) != 0)                     /* read 1 bit */
+        if (handle->ops->bus_read(handle->user, (uint8_t *)&res) != 0)  /* read 1 bit */
         {
-            handle->enable_irq();                                       /* enable irq */
-            handle->debug_print("ds2431: bus read failed.\n");          /* read failed */
+            a_ds2431_enable_irq(handle);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus read failed.\n");     /* read failed */
             
             return 1;                                                   /* return error */
         }
         retry++;                                                        /* retry times++ */
-        handle->delay_us(1);                                            /* delay 1 us */
+        handle->ops->delay_us(handle->user, DS2431_TIME_POLL_US);       /* delay 1 us */
     }
     if (retry >= 200)                                                   /* if retry times is over 200 times */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds2431: bus read no response.\n");         /* no response */
+        a_ds2431_enable_irq(handle);                                    /* enable irq */
+        a_ds2431_trace(handle, DS2431_TRACE_RESET, 1, us);              /* no presence */
+        handle->ops->debug_print("ds2431: bus read no response.\n");    /* no response */
         
         return 1;                                                       /* return error */
     }
@@ -149,24 +584,26 @@ static uint8_t a_ds2431_reset(ds2431_handle_t *handle)
     res = 0;                                                            /* reset res */
     while ((res == 0)&& (retry < 240))                                  /* wait 240 us */
     {
-        if (handle->bus_read((uint8_t *)&res) != 0)                     /* read one bit */
+        if (handle->ops->bus_read(handle->user, (uint8_t *)&res) != 0)  /* read one bit */
         {
-            handle->enable_irq();                                       /* enable irq */
-            handle->debug_print("ds2431: bus read failed.\n");          /* read failed */
+            a_ds2431_enable_irq(handle);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus read failed.\n");     /* read failed */
             
             return 1;                                                   /* return error */
         }
         retry++;                                                        /* retry times++ */
-        handle->delay_us(1);                                            /* delay 1 us */
+        handle->ops->delay_us(handle->user, DS2431_TIME_POLL_US);       /* delay 1 us */
     }
     if (retry >= 240)                                                   /* if retry times is over 240 times */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds2431: bus read no response.\n");         /* no response */
+        a_ds2431_enable_irq(handle);                                    /* enable irq */
+        a_ds2431_trace(handle, DS2431_TRACE_RESET, 1, us);              /* no presence */
+        handle->ops->debug_print("ds2431: bus read no response.\n");    /* no response */
         
         return 1;                                                       /* return error */
     }
-    handle->enable_irq();                                               /* enable irq */
+    a_ds2431_trace(handle, DS2431_TRACE_RESET, 0, us);                  /* presence */
+    a_ds2431_enable_irq(handle);                                        /* enable irq */
     
     return 0;                                                           /* success return 0 */
 }
@@ -182,27 +619,27 @@ static uint8_t a_ds2431_reset(ds2431_handle_t *handle)
  */
 static uint8_t a_ds2431_read_bit(ds2431_handle_t *handle, uint8_t *data)
 {
-    if (handle->bus_write(0) != 0)                                  /* write 0 */
+    if (handle->ops->bus_write(handle->user, 0) != 0)               /* write 0 */
     {
-        handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+        handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(6);                                            /* wait 6 us */
-    if (handle->bus_write(1) != 0)                                  /* write 1 */
+    handle->ops->delay_us(handle->user, DS2431_TIME_RL_US);         /* wait 6 us */
+    if (handle->ops->bus_write(handle->user, 1) != 0)               /* write 1 */
     {
-        handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+        handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(6);                                            /* wait 6 us */
-    if (handle->bus_read(data) != 0)                                /* read 1 bit */
+    handle->ops->delay_us(handle->user, DS2431_TIME_MSR_US);        /* wait 6 us */
+    if (handle->ops->bus_read(handle->user, data) != 0)             /* read 1 bit */
     {
-        handle->debug_print("ds2431: bus read failed.\n");          /* read failed */
+        handle->ops->debug_print("ds2431: bus read failed.\n");     /* read failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(50);                                           /* wait 50 us */
+    handle->ops->delay_us(handle->user, DS2431_TIME_RREC_US);       /* wait 50 us */
     
     return 0;                                                       /* success return 0 */
 }
@@ -219,21 +656,24 @@ static uint8_t a_ds2431_read_bit(ds2431_handle_t *handle, uint8_t *data)
 static uint8_t a_ds2431_read_byte(ds2431_handle_t *handle, uint8_t *byte)
 {
     uint8_t i, j;
+    uint32_t us;
     
+    us = a_ds2431_trace_us(handle);                                         /* trace start */
     *byte = 0;                                                              /* set byte 0 */
-    handle->disable_irq();                                                  /* disable irq */
+    a_ds2431_disable_irq(handle);                                           /* disable irq */
     for (i = 0; i < 8; i++)                                                 /* 8 bits */
     {
         if (a_ds2431_read_bit(handle, (uint8_t *)&j) != 0)                  /* read 1 bit */
         {
-            handle->enable_irq();                                           /* enable irq */
-            handle->debug_print("ds2431: bus read byte failed.\n");         /* read byte failed */
+            a_ds2431_enable_irq(handle);                                    /* enable irq */
+            handle->ops->debug_print("ds2431: bus read byte failed.\n");    /* read byte failed */
             
             return 1;                                                       /* return error */
         }
         *byte = (j << 7) | ((*byte) >> 1);                                  /* set MSB */
     }
-    handle->enable_irq();                                                   /* enable irq */
+    a_ds2431_trace(handle, DS2431_TRACE_READ, *byte, us);                   /* trace byte */
+    a_ds2431_enable_irq(handle);                                            /* enable irq */
     
     return 0;                                                               /* success return 0 */
 }
@@ -251,52 +691,57 @@ static uint8_t a_ds2431_write_byte(ds2431_handle_t *handle, uint8_t byte)
 {
     uint8_t j;
     uint8_t test_b;
+    uint8_t data;
+    uint32_t us;
     
-    handle->disable_irq();                                                  /* disable irq */
+    us = a_ds2431_trace_us(handle);                                         /* trace start */
+    data = byte;                                                            /* save byte */
+    a_ds2431_disable_irq(handle);                                           /* disable irq */
     for (j = 0; j < 8; j++)                                                 /* run 8 times, 8 bits = 1 Byte */
     {
         test_b = byte & 0x01;                                               /* get 1 bit */
         byte = byte >> 1;                                                   /* right shift 1 bit */
         if (test_b != 0)                                                    /* write 1 */
         {
-            if (handle->bus_write(0) != 0)                                  /* write 0 */
+            if (handle->ops->bus_write(handle->user, 0) != 0)               /* write 0 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+                a_ds2431_enable_irq(handle);                                /* enable irq */
+                handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(6);                                            /* wait 6 us */
-            if (handle->bus_write(1) != 0)                                  /* write 1 */
+            handle->ops->delay_us(handle->user, DS2431_TIME_W1L_US);        /* wait 6 us */
+            if (handle->ops->bus_write(handle->user, 1) != 0)               /* write 1 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+                a_ds2431_enable_irq(handle);                                /* enable irq */
+                handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(65);                                           /* wait 65 us */
+            handle->ops->delay_us(handle->user, DS2431_TIME_W0L_US);        /* wait 65 us */
         }
         else                                                                /* write 0 */
         {
-            if (handle->bus_write(0) != 0)                                  /* write 0 */
+            if (handle->ops->bus_write(handle->user, 0) != 0)               /* write 0 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+                a_ds2431_enable_irq(handle);                                /* enable irq */
+                handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(65);                                           /* wait 65 us */
-            if (handle->bus_write(1) != 0)                                  /* write 1 */
+            handle->ops->delay_us(handle->user, DS2431_TIME_W0L_US);        /* wait 65 us */
+            if (handle->ops->bus_write(handle->user, 1) != 0)               /* write 1 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+                a_ds2431_enable_irq(handle);                                /* enable irq */
+                handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(6);                                            /* wait 6 us */
+            handle->ops->delay_us(handle->user, DS2431_TIME_REC_US);        /* wait 6 us */
         }
     }
-    handle->enable_irq();                                                   /* enable irq */
+    a_ds2431_trace(handle, DS2431_TRACE_WRITE, data, us);                   /* trace byte */
+    a_ds2431_enable_irq(handle);                                            /* enable irq */
     
     return 0;                                                               /* success return 0 */
 }
@@ -313,41 +758,44 @@ static uint8_t a_ds2431_reset_overdrive(ds2431_handle_t *handle)
 {
     uint8_t retry = 0;
     uint8_t res;
+    uint32_t us;
     
-    handle->disable_irq();                                              /* disable irq */
-    if (handle->bus_write(0) != 0)                                      /* write 0 */
+    us = a_ds2431_trace_us(handle);                                     /* trace start */
+    a_ds2431_disable_irq(handle);                                       /* disable irq */
+    if (handle->ops->bus_write(handle->user, 0) != 0)                   /* write 0 */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds2431: bus write failed.\n");             /* write failed */
+        a_ds2431_enable_irq(handle);                                    /* enable irq */
+        handle->ops->debug_print("ds2431: bus write failed.\n");        /* write failed */
         
         return 1;                                                       /* return error */
     }
-    handle->delay_us(70);                                               /* wait 70 us */
-    if (handle->bus_write(1) != 0)                                      /* write 1 */
+    handle->ops->delay_us(handle->user, DS2431_TIME_RSTL_OD_US);        /* wait 70 us */
+    if (handle->ops->bus_write(handle->user, 1) != 0)                   /* write 1 */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds2431: bus write failed.\n");             /* write failed */
+        a_ds2431_enable_irq(handle);                                    /* enable irq */
+        handle->ops->debug_print("ds2431: bus write failed.\n");        /* write failed */
         
         return 1;                                                       /* return error */
     }
-    handle->delay_us(2);                                                /* wait 2 us */
+    handle->ops->delay_us(handle->user, DS2431_TIME_MSP_OD_US);         /* wait 2 us */
     res = 1;                                                            /* reset res */
     while ((res != 0) && (retry < 30))                                  /* wait 30 us */
     {
-        if (handle->bus_read((uint8_t *)&res) != 0)                     /* read 1 bit */
+        if (handle->ops->bus_read(handle->user, (uint8_t *)&res) != 0)  /* read 1 bit */
         {
-            handle->enable_irq();                                       /* enable irq */
-            handle->debug_print("ds2431: bus read failed.\n");          /* read failed */
+            a_ds2431_enable_irq(handle);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus read failed.\n");     /* read failed */
             
             return 1;                                                   /* return error */
         }
         retry++;                                                        /* retry times++ */
-        handle->delay_us(1);                                            /* delay 1 us */
+        handle->ops->delay_us(handle->user, DS2431_TIME_POLL_US);       /* delay 1 us */
     }
     if (retry >= 30)                                                    /* if retry times is over 30 times */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds2431: bus read no response.\n");         /* no response */
+        a_ds2431_enable_irq(handle);                                    /* enable irq */
+        a_ds2431_trace(handle, DS2431_TRACE_RESET_OVERDRIVE, 1, us);    /* no presence */
+        handle->ops->debug_print("ds2431: bus read no response.\n");    /* no response */
         
         return 1;                                                       /* return error */
     }
@@ -358,24 +806,26 @@ static uint8_t a_ds2431_reset_overdrive(ds2431_handle_t *handle)
     res = 0;                                                            /* reset res */
     while ((res == 0)&& (retry < 30))                                   /* wait 30 us */
     {
-        if (handle->bus_read((uint8_t *)&res) != 0)                     /* read one bit */
+        if (handle->ops->bus_read(handle->user, (uint8_t *)&res) != 0)  /* read one bit */
         {
-            handle->enable_irq();                                       /* enable irq */
-            handle->debug_print("ds2431: bus read failed.\n");          /* read failed */
+            a_ds2431_enable_irq(handle);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus read failed.\n");     /* read failed */
             
             return 1;                                                   /* return error */
         }
         retry++;                                                        /* retry times++ */
-        handle->delay_us(1);                                            /* delay 1 us */
+        handle->ops->delay_us(handle->user, DS2431_TIME_POLL_US);       /* delay 1 us */
     }
     if (retry >= 30)                                                    /* if retry times is over 30 times */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds2431: bus read no response.\n");         /* no response */
+        a_ds2431_enable_irq(handle);                                    /* enable irq */
+        a_ds2431_trace(handle, DS2431_TRACE_RESET_OVERDRIVE, 1, us);    /* no presence */
+        handle->ops->debug_print("ds2431: bus read no response.\n");    /* no response */
         
         return 1;                                                       /* return error */
     }
-    handle->enable_irq();                                               /* enable irq */
+    a_ds2431_trace(handle, DS2431_TRACE_RESET_OVERDRIVE, 0, us);        /* presence */
+    a_ds2431_enable_irq(handle);                                        /* enable irq */
     
     return 0;                                                           /* success return 0 */
 }
@@ -391,26 +841,26 @@ static uint8_t a_ds2431_reset_overdrive(ds2431_handle_t *handle)
  */
 static uint8_t a_ds2431_read_bit_overdrive(ds2431_handle_t *handle, uint8_t *data)
 {
-    if (handle->bus_write(0) != 0)                                  /* write 0 */
+    if (handle->ops->bus_write(handle->user, 0) != 0)               /* write 0 */
     {
-        handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+        handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(1);                                            /* wait 1 us */
-    if (handle->bus_write(1) != 0)                                  /* write 1 */
+    handle->ops->delay_us(handle->user, DS2431_TIME_RL_OD_US);      /* wait 1 us */
+    if (handle->ops->bus_write(handle->user, 1) != 0)               /* write 1 */
     {
-        handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+        handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
         
         return 1;                                                   /* return error */
     }
-    if (handle->bus_read(data) != 0)                                /* read 1 bit */
+    if (handle->ops->bus_read(handle->user, data) != 0)             /* read 1 bit */
     {
-        handle->debug_print("ds2431: bus read failed.\n");          /* read failed */
+        handle->ops->debug_print("ds2431: bus read failed.\n");     /* read failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(10);                                           /* wait 10 us */
+    handle->ops->delay_us(handle->user, DS2431_TIME_RREC_OD_US);    /* wait 10 us */
     
     return 0;                                                       /* success return 0 */
 }
@@ -427,21 +877,24 @@ static uint8_t a_ds2431_read_bit_overdrive(ds2431_handle_t *handle, uint8_t *dat
 static uint8_t a_ds2431_read_byte_overdrive(ds2431_handle_t *handle, uint8_t *byte)
 {
     uint8_t i, j;
+    uint32_t us;
     
+    us = a_ds2431_trace_us(handle);                                         /* trace start */
     *byte = 0;                                                              /* set byte 0 */
-    handle->disable_irq();                                                  /* disable irq */
+    a_ds2431_disable_irq(handle);                                           /* disable irq */
     for (i = 0; i < 8; i++)                                                 /* 8 bits */
     {
         if (a_ds2431_read_bit_overdrive(handle, (uint8_t *)&j) != 0)        /* read 1 bit */
         {
-            handle->enable_irq();                                           /* enable irq */
-            handle->debug_print("ds2431: bus read byte failed.\n");         /* read byte failed */
+            a_ds2431_enable_irq(handle);                                    /* enable irq */
+            handle->ops->debug_print("ds2431: bus read byte failed.\n");    /* read byte failed */
             
             return 1;                                                       /* return error */
         }
         *byte = (j << 7) | ((*byte) >> 1);                                  /* set MSB */
     }
-    handle->enable_irq();                                                   /* enable irq */
+    a_ds2431_trace(handle, DS2431_TRACE_READ_OVERDRIVE, *byte, us);         /* trace byte */
+    a_ds2431_enable_irq(handle);                                            /* enable irq */
     
     return 0;                                                               /* success return 0 */
 }
@@ -459,52 +912,57 @@ static uint8_t a_ds2431_write_byte_overdrive(ds2431_handle_t *handle, uint8_t by
 {
     uint8_t j;
     uint8_t test_b;
+    uint8_t data;
+    uint32_t us;
     
-    handle->disable_irq();                                                  /* disable irq */
+    us = a_ds2431_trace_us(handle);                                         /* trace start */
+    data = byte;                                                            /* save byte */
+    a_ds2431_disable_irq(handle);                                           /* disable irq */
     for (j = 0; j < 8; j++)                                                 /* run 8 times, 8 bits = 1 Byte */
     {
         test_b = byte & 0x01;                                               /* get 1 bit */
         byte = byte >> 1;                                                   /* right shift 1 bit */
         if (test_b != 0)                                                    /* write 1 */
         {
-            if (handle->bus_write(0) != 0)                                  /* write 0 */
+            if (handle->ops->bus_write(handle->user, 0) != 0)               /* write 0 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+                a_ds2431_enable_irq(handle);                                /* enable irq */
+                handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(1);                                            /* wait 1 us */
-            if (handle->bus_write(1) != 0)                                  /* write 1 */
+            handle->ops->delay_us(handle->user, DS2431_TIME_W1L_OD_US);     /* wait 1 us */
+            if (handle->ops->bus_write(handle->user, 1) != 0)               /* write 1 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+                a_ds2431_enable_irq(handle);                                /* enable irq */
+                handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(10);                                           /* wait 10 us */
+            handle->ops->delay_us(handle->user, DS2431_TIME_W0L_OD_US);     /* wait 10 us */
         }
         else                                                                /* write 0 */
         {
-            if (handle->bus_write(0) != 0)                                  /* write 0 */
+            if (handle->ops->bus_write(handle->user, 0) != 0)               /* write 0 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+                a_ds2431_enable_irq(handle);                                /* enable irq */
+                handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(10);                                           /* wait 10 us */
-            if (handle->bus_write(1) != 0)                                  /* write 1 */
+            handle->ops->delay_us(handle->user, DS2431_TIME_W0L_OD_US);     /* wait 10 us */
+            if (handle->ops->bus_write(handle->user, 1) != 0)               /* write 1 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds2431: bus write failed.\n");         /* write failed */
+                a_ds2431_enable_irq(handle);                                /* enable irq */
+                handle->ops->debug_print("ds2431: bus write failed.\n");    /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(2);                                            /* wait 2 us */
+            handle->ops->delay_us(handle->user, DS2431_TIME_REC_OD_US);     /* wait 2 us */
         }
     }
-    handle->enable_irq();                                                   /* enable irq */
+    a_ds2431_trace(handle, DS2431_TRACE_WRITE_OVERDRIVE, data, us);         /* trace byte */
+    a_ds2431_enable_irq(handle);                                            /* enable irq */
     
     return 0;                                                               /* success return 0 */
 }
@@ -569,56 +1027,60 @@ uint8_t ds2431_get_mode(ds2431_handle_t *handle, ds2431_mode_t *mode)
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 cache has dirty rows
+ * @note      another rom drops the cached config, the shadow rows and the digest,
+ *            so ds2431_set_digest must run again for the new device,
+ *            dirty write back rows must be flushed to the old device first
  */
 uint8_t ds2431_set_rom(ds2431_handle_t *handle, uint8_t rom[8])
 {
-    if (handle == NULL)                  /* check handle */
+    if (handle == NULL)                          /* check handle */
     {
-        return 2;                        /* return error */
+        return 2;                                /* return error */
     }
-    if (handle->inited != 1)             /* check handle initialization */
+    if (handle->inited != 1)                     /* check handle initialization */
     {
-        return 3;                        /* return error */
+        return 3;                                /* return error */
     }
     
-    memcpy(handle->rom, rom , 8);        /* copy rom */
+    if (memcmp(handle->rom, rom, 8) != 0)        /* check rom */
+    {
+        if ((a_ds2431_cache(handle) != NULL) &&
+            (handle->ext->cache->dirty != 0))    /* check dirty rows */
+        {
+            handle->ops->debug_print("ds2431: cache has dirty rows.\n");
+            
+            return 4;                            /* return error */
+        }
+        a_ds2431_select_drop(handle);            /* another device is selected */
+    }
+    memcpy(handle->rom, rom , 8);                /* copy rom */
     
-    return 0;                            /* success return 0 */
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      get the chip rom
+ * @brief      read the chip rom
  * @param[in]  *handle pointer to a ds2431 handle structure
  * @param[out] *rom pointer to a rom buffer
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 1 get rom failed
+ * @note       the caller holds the bus lock
  */
-uint8_t ds2431_get_rom(ds2431_handle_t *handle, uint8_t rom[8])
+static uint8_t a_ds2431_get_rom(ds2431_handle_t *handle, uint8_t rom[8])
 {
     uint8_t i;
     
-    if (handle == NULL)                                                 /* check handle */
-    {
-        return 2;                                                       /* return error */
-    }
-    if (handle->inited != 1)                                            /* check handle initialization */
-    {
-        return 3;                                                       /* return error */
-    }
-    
     if (a_ds2431_reset(handle) != 0)                                    /* reset bus */
     {
-        handle->debug_print("ds2431: bus rest failed.\n");              /* reset bus failed */
+        handle->ops->debug_print("ds2431: bus rest failed.\n");         /* reset bus failed */
         
         return 1;                                                       /* return error */
     }
     if (a_ds2431_write_byte(handle, DS2431_CMD_READ_ROM) != 0)          /* write read rom command */
     {
-        handle->debug_print("ds2431: write command failed.\n");         /* write command failed */
+        handle->ops->debug_print("ds2431: write command failed.\n");    /* write command failed */
         
         return 1;                                                       /* return error */
     }
@@ -626,7 +1088,7 @@ uint8_t ds2431_get_rom(ds2431_handle_t *handle, uint8_t rom[8])
     {
         if (a_ds2431_read_byte(handle, (uint8_t *)&rom[i]) != 0)        /* read 1 byte */
         {
-            handle->debug_print("ds2431: read rom failed.\n");          /* read failed */
+            handle->ops->debug_print("ds2431: read rom failed.\n");     /* read failed */
             
             return 1;                                                   /* return error */
         }
@@ -636,22 +1098,56 @@ uint8_t ds2431_get_rom(ds2431_handle_t *handle, uint8_t rom[8])
 }
 
 /**
- * @brief     copy scratchpad
- * @param[in] *handle pointer to a ds2431 handle structure
- * @param[in] address input address
- * @return    status code
- *            - 0 success
- *            - 1 copy scratchpad failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 address >= 0x0080
- *            - 5 address is invalid
- * @note      none
+ * @brief      get the chip rom
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *rom pointer to a rom buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get rom failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
+uint8_t ds2431_get_rom(ds2431_handle_t *handle, uint8_t rom[8])
 {
-    uint8_t i;
-    uint8_t response;
+    uint8_t res;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_GET_ROM) != 0)           /* lock bus */
+    {
+        return 1;                                                       /* return error */
+    }
+    res = a_ds2431_get_rom(handle, rom);                                /* read rom */
+    a_ds2431_unlock(handle, res);                                       /* unlock bus */
+    
+    return res;                                                         /* return the result */
+}
+
+/**
+ * @brief     copy scratchpad
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address input address
+ * @return    status code
+ *            - 0 success
+ *            - 1 copy scratchpad failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address >= 0x0080
+ *            - 5 address is invalid
+ * @note      none
+ */
+static uint8_t a_ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
+{
+    uint8_t i;
+    uint8_t response;
     
     if (handle == NULL)                                                        /* check handle */
     {
@@ -663,13 +1159,13 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
     }
     if (address >= 0x0080)                                                     /* check address */
     {
-        handle->debug_print("ds2431: address >= 0x0080.\n");                   /* address >= 0x0080 */
+        handle->ops->debug_print("ds2431: address >= 0x0080.\n");              /* address >= 0x0080 */
         
         return 4;                                                              /* return error */
     }
     if ((address % 8) != 0)                                                    /* check address */
     {
-        handle->debug_print("ds2431: address is invalid.\n");                  /* address is invalid */
+        handle->ops->debug_print("ds2431: address is invalid.\n");             /* address is invalid */
         
         return 5;                                                              /* return error */
     }
@@ -678,51 +1174,51 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_SKIP_ROM) != 0)             /* send skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_COPY_SCRATCHPAD) != 0)      /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, 0x07) != 0)                            /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
-        handle->delay_ms(15);                                                  /* delay 15ms */
+        a_ds2431_prog_wait(handle, DS2431_TIME_COPY_MS);                       /* delay 15ms */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xAA)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
@@ -733,13 +1229,13 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_SKIP_ROM) != 0)   /* send overdrive skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -747,40 +1243,40 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_COPY_SCRATCHPAD) != 0)    /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, 0x07) != 0)                  /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
-        handle->delay_ms(15);                                                  /* delay 15ms */
+        a_ds2431_prog_wait(handle, DS2431_TIME_COPY_MS);                       /* delay 15ms */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xAA)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
@@ -791,13 +1287,13 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_MATCH_ROM) != 0)            /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -805,7 +1301,7 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
         {
             if (a_ds2431_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -813,38 +1309,38 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_COPY_SCRATCHPAD) != 0)      /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, 0x07) != 0)                            /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
-        handle->delay_ms(15);                                                  /* delay 15ms */
+        a_ds2431_prog_wait(handle, DS2431_TIME_COPY_MS);                       /* delay 15ms */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xAA)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
@@ -855,13 +1351,13 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_MATCH_ROM) != 0)  /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -869,7 +1365,7 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
         {
             if (a_ds2431_write_byte_overdrive(handle, handle->rom[i]) != 0)    /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -878,40 +1374,40 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_COPY_SCRATCHPAD) != 0)    /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, 0x07) != 0)                  /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
-        handle->delay_ms(15);                                                  /* delay 15ms */
+        a_ds2431_prog_wait(handle, DS2431_TIME_COPY_MS);                       /* delay 15ms */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xAA)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
@@ -922,51 +1418,51 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_RESUME) != 0)               /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_COPY_SCRATCHPAD) != 0)      /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, 0x07) != 0)                            /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
-        handle->delay_ms(15);                                                  /* delay 15ms */
+        a_ds2431_prog_wait(handle, DS2431_TIME_COPY_MS);                       /* delay 15ms */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xAA)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
@@ -977,13 +1473,13 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
     {
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, DS2431_CMD_RESUME) != 0)     /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -991,40 +1487,40 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_COPY_SCRATCHPAD) != 0)    /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, 0x07) != 0)                  /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
-        handle->delay_ms(15);                                                  /* delay 15ms */
+        a_ds2431_prog_wait(handle, DS2431_TIME_COPY_MS);                       /* delay 15ms */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xAA)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
@@ -1033,7 +1529,7 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
     }
     else
     {
-        handle->debug_print("ds2431: mode invalid.\n");                        /* ds2431 mode is invalid */
+        handle->ops->debug_print("ds2431: mode invalid.\n");                   /* ds2431 mode is invalid */
         
         return 1;                                                              /* return error */
     }
@@ -1055,7 +1551,7 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
  *             - 6 crc16 check error
  * @note       none
  */
-uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8_t data[8], uint16_t *crc16)
+static uint8_t a_ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8_t data[8], uint16_t *crc16)
 {
     uint8_t i;
     uint8_t response;
@@ -1072,13 +1568,13 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
     }
     if (address >= 0x0080)                                                     /* check address */
     {
-        handle->debug_print("ds2431: address >= 0x0080.\n");                   /* address >= 0x0080 */
+        handle->ops->debug_print("ds2431: address >= 0x0080.\n");              /* address >= 0x0080 */
         
         return 4;                                                              /* return error */
     }
     if ((address % 8) != 0)                                                    /* check address */
     {
-        handle->debug_print("ds2431: address is invalid.\n");                  /* address is invalid */
+        handle->ops->debug_print("ds2431: address is invalid.\n");             /* address is invalid */
         
         return 5;                                                              /* return error */
     }
@@ -1087,13 +1583,13 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_SKIP_ROM) != 0)             /* send skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1101,21 +1597,21 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_WRITE_SCRATCHPAD) != 0)     /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_WRITE_SCRATCHPAD);         /* calculate part 1 */
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, (address >> 0) & 0xFF);               /* calculate part 2 */
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1124,7 +1620,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         {
             if (a_ds2431_write_byte(handle, data[i]) != 0)                     /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1132,14 +1628,14 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1148,19 +1644,20 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 6;                                                          /* return error */
         }
@@ -1171,13 +1668,13 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_SKIP_ROM) != 0)   /* send overdrive skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1186,7 +1683,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_WRITE_SCRATCHPAD) != 0)   /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1194,7 +1691,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1202,7 +1699,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1211,7 +1708,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         {
             if (a_ds2431_write_byte_overdrive(handle, data[i]) != 0)           /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1219,14 +1716,14 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1235,19 +1732,20 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 6;                                                          /* return error */
         }
@@ -1258,13 +1756,13 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_MATCH_ROM) != 0)            /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -1272,7 +1770,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         {
             if (a_ds2431_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -1281,21 +1779,21 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_WRITE_SCRATCHPAD) != 0)     /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_WRITE_SCRATCHPAD);         /* calculate part 1 */
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, (address >> 0) & 0xFF);               /* calculate part 2 */
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1304,7 +1802,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         {
             if (a_ds2431_write_byte(handle, data[i]) != 0)                     /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1312,14 +1810,14 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1328,19 +1826,20 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 6;                                                          /* return error */
         }
@@ -1351,13 +1850,13 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_MATCH_ROM) != 0)  /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -1365,7 +1864,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         {
             if (a_ds2431_write_byte_overdrive(handle, handle->rom[i]) != 0)    /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -1375,7 +1874,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_WRITE_SCRATCHPAD) != 0)   /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1383,7 +1882,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1391,7 +1890,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1400,7 +1899,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         {
             if (a_ds2431_write_byte_overdrive(handle, data[i]) != 0)           /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1408,14 +1907,14 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1424,19 +1923,20 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 6;                                                          /* return error */
         }
@@ -1447,13 +1947,13 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_RESUME) != 0)               /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1461,21 +1961,21 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_WRITE_SCRATCHPAD) != 0)     /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_WRITE_SCRATCHPAD);         /* calculate part 1 */
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, (address >> 0) & 0xFF);               /* calculate part 2 */
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1484,7 +1984,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         {
             if (a_ds2431_write_byte(handle, data[i]) != 0)                     /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1492,14 +1992,14 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1508,19 +2008,20 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 6;                                                          /* return error */
         }
@@ -1531,13 +2032,13 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
     {
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, DS2431_CMD_RESUME) != 0)     /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1546,7 +2047,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_WRITE_SCRATCHPAD) != 0)   /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1554,7 +2055,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1562,7 +2063,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1571,7 +2072,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         {
             if (a_ds2431_write_byte_overdrive(handle, data[i]) != 0)           /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1579,14 +2080,14 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1595,19 +2096,20 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 6;                                                          /* return error */
         }
@@ -1616,12 +2118,59 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
     }
     else
     {
-        handle->debug_print("ds2431: mode invalid.\n");                        /* ds2431 mode is invalid */
+        handle->ops->debug_print("ds2431: mode invalid.\n");                   /* ds2431 mode is invalid */
         
         return 1;                                                              /* return error */
     }
 }
 
+/**
+ * @brief      write scratchpad
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  address input address
+ * @param[in]  *data pointer to a data buffer
+ * @param[out] *crc16 pointer to a crc16 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 write scratchpad failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address >= 0x0080
+ *             - 5 address is invalid
+ *             - 6 crc16 check error
+ *             - 7 address is reserved
+ * @note       the digest row is reserved while the digest is enabled
+ */
+uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8_t data[8], uint16_t *crc16)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (handle->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if ((a_ds2431_digest_on(handle) != 0) &&
+        (address == handle->ext->digest_address))                         /* check digest row */
+    {
+        handle->ops->debug_print("ds2431: address is reserved.\n");       /* address is reserved */
+        
+        return 7;                                                         /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_WRITE_SCRATCHPAD) != 0)    /* lock bus */
+    {
+        return 1;                                                         /* return error */
+    }
+    res = a_ds2431_write_scratchpad(handle, address, data, crc16);        /* write scratchpad */
+    a_ds2431_unlock(handle, res);                                         /* unlock bus */
+    
+    return res;                                                           /* return the result */
+}
+
 /**
  * @brief      read scratchpad
  * @param[in]  *handle pointer to a ds2431 handle structure
@@ -1637,7 +2186,7 @@ uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8
  *             - 5 crc16 check error
  * @note       none
  */
-uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8_t data[8], uint16_t *crc16)
+static uint8_t a_ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8_t data[8], uint16_t *crc16)
 {
     uint8_t i;
     uint8_t ta;
@@ -1658,13 +2207,13 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_SKIP_ROM) != 0)             /* send skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1672,28 +2221,28 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_SCRATCHPAD) != 0)      /* read scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_READ_SCRATCHPAD);          /* calculate part 1 */
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 2 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 3 */
         if (a_ds2431_read_byte(handle, &ta) != 0)                              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1701,7 +2250,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *address = (uint16_t)((uint16_t)(buf[1]) << 8) | buf[0];               /* set address */
         if (ta != 0x07)                                                        /* check status */
         {
-            handle->debug_print("ds2431: status is error.\n");                 /* status is error */
+            handle->ops->debug_print("ds2431: status is error.\n");            /* status is error */
             
             return 4;                                                          /* return error */
         }
@@ -1710,7 +2259,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1718,14 +2267,14 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 6 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1734,19 +2283,20 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 5;                                                          /* return error */
         }
@@ -1757,13 +2307,13 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_SKIP_ROM) != 0)   /* send overdrive skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -1772,28 +2322,28 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_SCRATCHPAD) != 0)    /* read scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_READ_SCRATCHPAD);          /* calculate part 1 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 2 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 3 */
         if (a_ds2431_read_byte_overdrive(handle, &ta) != 0)                    /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1801,7 +2351,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *address = (uint16_t)((uint16_t)(buf[1]) << 8) | buf[0];               /* set address */
         if (ta != 0x07)                                                        /* check status */
         {
-            handle->debug_print("ds2431: status is error.\n");                 /* status is error */
+            handle->ops->debug_print("ds2431: status is error.\n");            /* status is error */
             
             return 4;                                                          /* return error */
         }
@@ -1810,7 +2360,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1818,14 +2368,14 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 6 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1834,19 +2384,20 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 5;                                                          /* return error */
         }
@@ -1857,13 +2408,13 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_MATCH_ROM) != 0)            /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -1871,7 +2422,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         {
             if (a_ds2431_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -1880,28 +2431,28 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_SCRATCHPAD) != 0)      /* read scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_READ_SCRATCHPAD);          /* calculate part 1 */
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 2 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 3 */
         if (a_ds2431_read_byte(handle, &ta) != 0)                              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1909,7 +2460,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *address = (uint16_t)((uint16_t)(buf[1]) << 8) | buf[0];               /* set address */
         if (ta != 0x07)                                                        /* check status */
         {
-            handle->debug_print("ds2431: status is error.\n");                 /* status is error */
+            handle->ops->debug_print("ds2431: status is error.\n");            /* status is error */
             
             return 4;                                                          /* return error */
         }
@@ -1918,7 +2469,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -1926,14 +2477,14 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 6 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -1942,19 +2493,20 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 5;                                                          /* return error */
         }
@@ -1965,13 +2517,13 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_MATCH_ROM) != 0)  /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -1979,7 +2531,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         {
             if (a_ds2431_write_byte_overdrive(handle, handle->rom[i]) != 0)    /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -1989,28 +2541,28 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_SCRATCHPAD) != 0)    /* read scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_READ_SCRATCHPAD);          /* calculate part 1 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 2 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 3 */
         if (a_ds2431_read_byte_overdrive(handle, &ta) != 0)                    /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -2018,7 +2570,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *address = (uint16_t)((uint16_t)(buf[1]) << 8) | buf[0];               /* set address */
         if (ta != 0x07)                                                        /* check status */
         {
-            handle->debug_print("ds2431: status is error.\n");                 /* status is error */
+            handle->ops->debug_print("ds2431: status is error.\n");            /* status is error */
             
             return 4;                                                          /* return error */
         }
@@ -2027,7 +2579,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2035,14 +2587,14 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 6 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -2051,19 +2603,20 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 5;                                                          /* return error */
         }
@@ -2074,13 +2627,13 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_RESUME) != 0)               /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2088,28 +2641,28 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_SCRATCHPAD) != 0)      /* read scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_READ_SCRATCHPAD);          /* calculate part 1 */
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 2 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 3 */
         if (a_ds2431_read_byte(handle, &ta) != 0)                              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -2117,7 +2670,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *address = (uint16_t)((uint16_t)(buf[1]) << 8) | buf[0];               /* set address */
         if (ta != 0x07)                                                        /* check status */
         {
-            handle->debug_print("ds2431: status is error.\n");                 /* status is error */
+            handle->ops->debug_print("ds2431: status is error.\n");            /* status is error */
             
             return 4;                                                          /* return error */
         }
@@ -2126,7 +2679,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2134,14 +2687,14 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 6 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -2150,19 +2703,20 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 5;                                                          /* return error */
         }
@@ -2173,13 +2727,13 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
     {
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, DS2431_CMD_RESUME) != 0)     /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2188,28 +2742,28 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_SCRATCHPAD) != 0)    /* read scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_READ_SCRATCHPAD);          /* calculate part 1 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 2 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 3 */
         if (a_ds2431_read_byte_overdrive(handle, &ta) != 0)                    /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -2217,7 +2771,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *address = (uint16_t)((uint16_t)(buf[1]) << 8) | buf[0];               /* set address */
         if (ta != 0x07)                                                        /* check status */
         {
-            handle->debug_print("ds2431: status is error.\n");                 /* status is error */
+            handle->ops->debug_print("ds2431: status is error.\n");            /* status is error */
             
             return 4;                                                          /* return error */
         }
@@ -2226,7 +2780,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2234,14 +2788,14 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 6 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
@@ -2250,19 +2804,20 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
         *crc16 = ~(*crc16);                                                    /* invert */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 5;                                                          /* return error */
         }
@@ -2271,12 +2826,50 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
     }
     else
     {
-        handle->debug_print("ds2431: mode invalid.\n");                        /* ds2431 mode is invalid */
+        handle->ops->debug_print("ds2431: mode invalid.\n");                   /* ds2431 mode is invalid */
         
         return 1;                                                              /* return error */
     }
 }
 
+/**
+ * @brief      read scratchpad
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *address pointer to an address buffer
+ * @param[out] *data pointer to a data buffer
+ * @param[out] *crc16 pointer to a crc16 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read scratchpad failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 status is error
+ *             - 5 crc16 check error
+ * @note       none
+ */
+uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8_t data[8], uint16_t *crc16)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_READ_SCRATCHPAD) != 0)    /* lock bus */
+    {
+        return 1;                                                        /* return error */
+    }
+    res = a_ds2431_read_scratchpad(handle, address, data, crc16);        /* read scratchpad */
+    a_ds2431_unlock(handle, res);                                        /* unlock bus */
+    
+    return res;                                                          /* return the result */
+}
+
 /**
  * @brief      read memory
  * @param[in]  *handle pointer to a ds2431 handle structure
@@ -2291,7 +2884,7 @@ uint8_t ds2431_read_scratchpad(ds2431_handle_t *handle, uint16_t *address, uint8
  *             - 4 address and len are invalid
  * @note       none
  */
-uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *data, uint16_t len)
+static uint8_t a_ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *data, uint16_t len)
 {
     uint16_t i;
     
@@ -2305,7 +2898,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
     }
     if ((address + len) > 0x0080)                                              /* check address */
     {
-        handle->debug_print("ds2431: address and len are invalid.\n");         /* address and len are invalid */
+        handle->ops->debug_print("ds2431: address and len are invalid.\n");    /* address and len are invalid */
         
         return 4;                                                              /* return error */
     }
@@ -2314,32 +2907,32 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_SKIP_ROM) != 0)             /* send skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_MEMORY) != 0)          /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2347,7 +2940,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2359,13 +2952,13 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_SKIP_ROM) != 0)   /* send overdrive skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2373,21 +2966,21 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_MEMORY) != 0)        /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2395,7 +2988,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2407,13 +3000,13 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_MATCH_ROM) != 0)            /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -2421,7 +3014,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         {
             if (a_ds2431_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -2429,19 +3022,19 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_MEMORY) != 0)          /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2449,7 +3042,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2461,13 +3054,13 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_MATCH_ROM) != 0)  /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -2475,7 +3068,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         {
             if (a_ds2431_write_byte_overdrive(handle, handle->rom[i]) != 0)    /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -2484,21 +3077,21 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_MEMORY) != 0)        /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2506,7 +3099,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2518,32 +3111,32 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_RESUME) != 0)               /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_MEMORY) != 0)          /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2551,7 +3144,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2563,13 +3156,13 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
     {
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, DS2431_CMD_RESUME) != 0)     /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2577,21 +3170,21 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_MEMORY) != 0)        /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2599,7 +3192,7 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2609,12 +3202,49 @@ uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *d
     }
     else
     {
-        handle->debug_print("ds2431: mode invalid.\n");                        /* ds2431 mode is invalid */
+        handle->ops->debug_print("ds2431: mode invalid.\n");                   /* ds2431 mode is invalid */
         
         return 1;                                                              /* return error */
     }
 }
 
+/**
+ * @brief      read memory
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  address input address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read memory failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address and len are invalid
+ * @note       none
+ */
+uint8_t ds2431_read_memory(ds2431_handle_t *handle, uint16_t address, uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_READ_MEMORY) != 0)        /* lock bus */
+    {
+        return 1;                                                        /* return error */
+    }
+    res = a_ds2431_read_memory(handle, address, data, len);              /* read memory */
+    a_ds2431_unlock(handle, res);                                        /* unlock bus */
+    
+    return res;                                                          /* return the result */
+}
+
 /**
  * @brief      ds2431 read
  * @param[in]  *handle pointer to a ds2431 handle structure
@@ -2634,32 +3264,32 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_SKIP_ROM) != 0)             /* send skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_MEMORY) != 0)          /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2667,7 +3297,7 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2679,13 +3309,13 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_SKIP_ROM) != 0)   /* send overdrive skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2693,21 +3323,21 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_MEMORY) != 0)        /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2715,7 +3345,7 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2727,13 +3357,13 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_MATCH_ROM) != 0)            /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -2741,7 +3371,7 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -2749,19 +3379,19 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_MEMORY) != 0)          /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2769,7 +3399,7 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2781,13 +3411,13 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_MATCH_ROM) != 0)  /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -2795,7 +3425,7 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte_overdrive(handle, handle->rom[i]) != 0)    /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -2804,21 +3434,21 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_MEMORY) != 0)        /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2826,7 +3456,7 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2838,32 +3468,32 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_RESUME) != 0)               /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_READ_MEMORY) != 0)          /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2871,7 +3501,7 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_read_byte(handle, &data[i]) != 0)                     /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2883,13 +3513,13 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, DS2431_CMD_RESUME) != 0)     /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2897,21 +3527,21 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_READ_MEMORY) != 0)        /* read memory command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2919,7 +3549,7 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_read_byte_overdrive(handle, &data[i]) != 0)           /* read data */
             {
-                handle->debug_print("ds2431: read data failed.\n");            /* read data failed */
+                handle->ops->debug_print("ds2431: read data failed.\n");       /* read data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -2929,23 +3559,23 @@ static uint8_t a_ds2431_read(ds2431_handle_t *handle, uint16_t address, uint8_t
     }
     else
     {
-        handle->debug_print("ds2431: mode invalid.\n");                        /* ds2431 mode is invalid */
+        handle->ops->debug_print("ds2431: mode invalid.\n");                   /* ds2431 mode is invalid */
         
         return 1;                                                              /* return error */
     }
 }
 
 /**
- * @brief     ds2431 write
+ * @brief     ds2431 write start
  * @param[in] *handle pointer to a ds2431 handle structure
  * @param[in] address input address
  * @param[in] *data pointer to a data buffer
  * @return    status code
  *            - 0 success
- *            - 1 write failed
- * @note      none
+ *            - 1 write start failed
+ * @note      returns right after the copy scratchpad authorization, the chip is programming
  */
-static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t data[8])
+static uint8_t a_ds2431_write_start(ds2431_handle_t *handle, uint16_t address, uint8_t data[8])
 {
     uint8_t i;
     uint8_t response;
@@ -2956,13 +3586,13 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_SKIP_ROM) != 0)             /* send skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2970,21 +3600,21 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_WRITE_SCRATCHPAD) != 0)     /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_WRITE_SCRATCHPAD);         /* calculate part 1 */
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, (address >> 0) & 0xFF);               /* calculate part 2 */
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -2993,7 +3623,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte(handle, data[i]) != 0)                     /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -3001,84 +3631,72 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 6 */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_SKIP_ROM) != 0)             /* send skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_COPY_SCRATCHPAD) != 0)      /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, 0x07) != 0)                            /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                          /* return error */
-        }
-        handle->delay_ms(10);                                                  /* delay 10ms */
-        if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
-        {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
-            
-            return 1;                                                          /* return error */
-        }
-        if (response != 0xAA)                                                  /* check response */
-        {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3089,13 +3707,13 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_SKIP_ROM) != 0)   /* send overdrive skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3104,7 +3722,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_WRITE_SCRATCHPAD) != 0)   /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3112,7 +3730,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3120,7 +3738,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3129,7 +3747,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte_overdrive(handle, data[i]) != 0)           /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -3137,47 +3755,48 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 6 */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_OVERDRIVE_SKIP_ROM) != 0) /* send overdrive skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3185,40 +3804,27 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_COPY_SCRATCHPAD) != 0)    /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, 0x07) != 0)                  /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                          /* return error */
-        }
-        handle->delay_ms(10);                                                  /* delay 10ms */
-        if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
-        {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
-            
-            return 1;                                                          /* return error */
-        }
-        if (response != 0xAA)                                                  /* check response */
-        {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3229,13 +3835,13 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_MATCH_ROM) != 0)            /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -3243,7 +3849,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -3252,21 +3858,21 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_WRITE_SCRATCHPAD) != 0)     /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_WRITE_SCRATCHPAD);         /* calculate part 1 */
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, (address >> 0) & 0xFF);               /* calculate part 2 */
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3275,7 +3881,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte(handle, data[i]) != 0)                     /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -3283,46 +3889,47 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 6 */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_MATCH_ROM) != 0)            /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3330,7 +3937,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -3338,38 +3945,25 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_COPY_SCRATCHPAD) != 0)      /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, 0x07) != 0)                            /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                          /* return error */
-        }
-        handle->delay_ms(10);                                                  /* delay 10ms */
-        if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
-        {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
-            
-            return 1;                                                          /* return error */
-        }
-        if (response != 0xAA)                                                  /* check response */
-        {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3380,13 +3974,13 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_MATCH_ROM) != 0)  /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -3394,7 +3988,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte_overdrive(handle, handle->rom[i]) != 0)    /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -3404,7 +3998,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_WRITE_SCRATCHPAD) != 0)   /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3412,7 +4006,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3420,7 +4014,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3429,7 +4023,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte_overdrive(handle, data[i]) != 0)           /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -3437,47 +4031,48 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 6 */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_OVERDRIVE_SKIP_ROM) != 0) /* send overdrive skip rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3485,40 +4080,27 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_COPY_SCRATCHPAD) != 0)    /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, 0x07) != 0)                  /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                          /* return error */
-        }
-        handle->delay_ms(10);                                                  /* delay 10ms */
-        if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
-        {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
-            
-            return 1;                                                          /* return error */
-        }
-        if (response != 0xAA)                                                  /* check response */
-        {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3529,13 +4111,13 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_RESUME) != 0)               /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3543,21 +4125,21 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         crc = 0;                                                               /* crc init 0 */
         if (a_ds2431_write_byte(handle, DS2431_CMD_WRITE_SCRATCHPAD) != 0)     /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, DS2431_CMD_WRITE_SCRATCHPAD);         /* calculate part 1 */
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, (address >> 0) & 0xFF);               /* calculate part 2 */
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3566,7 +4148,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte(handle, data[i]) != 0)                     /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -3574,84 +4156,72 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         }
         if (a_ds2431_read_byte(handle, &buf[0]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte(handle, &buf[1]) != 0)                          /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 6 */
         if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_RESUME) != 0)               /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_write_byte(handle, DS2431_CMD_COPY_SCRATCHPAD) != 0)      /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 0) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, (address >> 8) & 0xFF) != 0)           /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, 0x07) != 0)                            /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                          /* return error */
-        }
-        handle->delay_ms(10);                                                  /* delay 10ms */
-        if (a_ds2431_read_byte(handle, &response) != 0)                        /* read byte */
-        {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
-            
-            return 1;                                                          /* return error */
-        }
-        if (response != 0xAA)                                                  /* check response */
-        {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3662,13 +4232,13 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
     {
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, DS2431_CMD_RESUME) != 0)     /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3677,7 +4247,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_WRITE_SCRATCHPAD) != 0)   /* write scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3685,7 +4255,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3693,7 +4263,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3702,7 +4272,7 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         {
             if (a_ds2431_write_byte_overdrive(handle, data[i]) != 0)           /* write data */
             {
-                handle->debug_print("ds2431: write data failed.\n");           /* write data failed */
+                handle->ops->debug_print("ds2431: write data failed.\n");      /* write data failed */
                 
                 return 1;                                                      /* return error */
             }
@@ -3710,46 +4280,47 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         }
         if (a_ds2431_read_byte_overdrive(handle, &buf[0]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[0]);                              /* calculate part 5 */
         if (a_ds2431_read_byte_overdrive(handle, &buf[1]) != 0)                /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         crc = a_ds2431_crc16_update(crc, buf[1]);                              /* calculate part 6 */
         if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
         {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
+            handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
             
             return 1;                                                          /* return error */
         }
         if (response != 0xFF)                                                  /* check response */
         {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: response error.\n");             /* response error */
             
             return 1;                                                          /* return error */
         }
+        a_ds2431_trace_crc(handle, crc);                                       /* trace crc16 */
         if (crc != 0xB001U)                                                    /* check crc16 */
         {
-            handle->debug_print("ds2431: crc16 check error.\n");               /* crc16 check error */
+            handle->ops->debug_print("ds2431: crc16 check error.\n");          /* crc16 check error */
             
             return 1;                                                          /* return error */
         }
         
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* reset bus failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* reset bus failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, DS2431_CMD_RESUME) != 0)     /* send resume command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3757,40 +4328,27 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
         if (a_ds2431_write_byte_overdrive(handle,
                                           DS2431_CMD_COPY_SCRATCHPAD) != 0)    /* write copy scratchpad command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 0) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle,
                                          (address >> 8) & 0xFF) != 0)          /* write address lsb */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte_overdrive(handle, 0x07) != 0)                  /* write es */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                          /* return error */
-        }
-        handle->delay_ms(10);                                                  /* delay 10ms */
-        if (a_ds2431_read_byte_overdrive(handle, &response) != 0)              /* read byte */
-        {
-            handle->debug_print("ds2431: read data failed.\n");                /* read data failed */
-            
-            return 1;                                                          /* return error */
-        }
-        if (response != 0xAA)                                                  /* check response */
-        {
-            handle->debug_print("ds2431: response error.\n");                  /* response error */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }
@@ -3799,98 +4357,102 @@ static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t
     }
     else
     {
-        handle->debug_print("ds2431: mode invalid.\n");                        /* ds2431 mode is invalid */
+        handle->ops->debug_print("ds2431: mode invalid.\n");                   /* ds2431 mode is invalid */
         
         return 1;                                                              /* return error */
     }
 }
 
 /**
- * @brief      read memory config
- * @param[in]  *handle pointer to a ds2431 handle structure
- * @param[out] *config pointer to a ds2431 config control structure
- * @return     status code
- *             - 0 success
- *             - 1 read memory config failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     ds2431 write finish
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write finish failed
+ * @note      call it after the programming time has passed
  */
-uint8_t ds2431_read_memory_config(ds2431_handle_t *handle, ds2431_config_control_t *config)
+static uint8_t a_ds2431_write_finish(ds2431_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[8];
+    uint8_t response;
     
-    if (handle == NULL)                               /* check handle */
+    if ((handle->mode == DS2431_MODE_OVERDRIVE_SKIP_ROM) ||
+        (handle->mode == DS2431_MODE_OVERDRIVE_MATCH_ROM) ||
+        (handle->mode == DS2431_MODE_OVERDRIVE_RESUME))                    /* overdrive mode */
     {
-        return 2;                                     /* return error */
+        res = a_ds2431_read_byte_overdrive(handle, &response);             /* read byte */
     }
-    if (handle->inited != 1)                          /* check handle initialization */
+    else
     {
-        return 3;                                     /* return error */
+        res = a_ds2431_read_byte(handle, &response);                       /* read byte */
     }
-    
-    res = a_ds2431_read(handle, 0x80, buf, 8);        /* read config */
-    if (res != 0)                                     /* check the result */
+    if (res != 0)                                                          /* check the result */
     {
-        return 1;                                     /* return error */
+        handle->ops->debug_print("ds2431: read data failed.\n");           /* read data failed */
+        
+        return 1;                                                          /* return error */
+    }
+    if (response != 0xAA)                                                  /* check response */
+    {
+        handle->ops->debug_print("ds2431: response error.\n");             /* response error */
+        
+        return 1;                                                          /* return error */
     }
-    config->page0_protection_control = buf[0];        /* set page0 protection control */
-    config->page1_protection_control = buf[1];        /* set page1 protection control */
-    config->page2_protection_control = buf[2];        /* set page2 protection control */
-    config->page3_protection_control = buf[3];        /* set page3 protection control */
-    config->copy_protection = buf[4];                 /* set copy protection */
-    config->factory_byte = buf[5];                    /* set factory byte */
-    config->user_byte_0 = buf[6];                     /* set user byte 0 */
-    config->user_byte_1 = buf[7];                     /* set user byte 1 */
     
-    return 0;                                         /* success return 0 */
+    return 0;                                                              /* success return 0 */
 }
 
 /**
- * @brief     write memory config
+ * @brief     fill the invalid cached rows of a range from the chip
  * @param[in] *handle pointer to a ds2431 handle structure
- * @param[in] *config pointer to a ds2431 config control structure
+ * @param[in] address input address
+ * @param[in] len data length
  * @return    status code
  *            - 0 success
- *            - 1 write memory config failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 fill failed
+ * @note      the bus must be locked, valid rows are never overwritten
  */
-uint8_t ds2431_write_memory_config(ds2431_handle_t *handle, ds2431_config_control_t *config)
+static uint8_t a_ds2431_cache_fill(ds2431_handle_t *handle, uint16_t address, uint16_t len)
 {
-    uint8_t res;
-    uint8_t buf[8];
-    
-    if (handle == NULL)                               /* check handle */
-    {
-        return 2;                                     /* return error */
-    }
-    if (handle->inited != 1)                          /* check handle initialization */
-    {
-        return 3;                                     /* return error */
-    }
+    uint8_t row;
+    uint8_t end;
+    uint32_t miss;
+    ds2431_cache_t *cache;
     
-    buf[0] = config->page0_protection_control;        /* set page0 protection control */
-    buf[1] = config->page1_protection_control;        /* set page1 protection control */
-    buf[2] = config->page2_protection_control;        /* set page2 protection control */
-    buf[3] = config->page3_protection_control;        /* set page3 protection control */
-    buf[4] = config->copy_protection;                 /* set copy protection */
-    buf[5] = config->factory_byte;                    /* set factory byte */
-    buf[6] = config->user_byte_0;                     /* set user byte 0 */
-    buf[7] = config->user_byte_1;                     /* set user byte 1 */
-    res = a_ds2431_write(handle, 0x80, buf);          /* write config */
-    if (res != 0)                                     /* check the result */
+    cache = a_ds2431_cache(handle);                                             /* get cache */
+    miss = a_ds2431_cache_mask(address, len) & (~cache->valid);                 /* get missed rows */
+    row = 0;                                                                    /* init 0 */
+    while (miss != 0)                                                           /* read every run */
     {
-        return 1;                                     /* return error */
+        if ((miss & (1UL << row)) == 0)                                         /* check row */
+        {
+            row++;                                                              /* next row */
+            
+            continue;                                                           /* continue */
+        }
+        end = row;                                                              /* run start */
+        while ((end < DS2431_CACHE_ROW) && ((miss & (1UL << end)) != 0))        /* find run end */
+        {
+            end++;                                                              /* next row */
+        }
+        if (a_ds2431_read(handle, (uint16_t)(row * 8),
+                          &cache->image[row * 8],
+                          (uint16_t)((end - row) * 8)) != 0)                    /* read the run */
+        {
+            return 1;                                                           /* return error */
+        }
+        for (; row < end; row++)                                                /* mark the run */
+        {
+            cache->valid |= 1UL << row;                                         /* set valid */
+            miss &= ~(1UL << row);                                              /* clear miss */
+        }
     }
     
-    return 0;                                         /* success return 0 */
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief      read data
+ * @brief      read data through the cache
  * @param[in]  *handle pointer to a ds2431 handle structure
  * @param[in]  address input address
  * @param[out] *data pointer to a data buffer
@@ -3898,135 +4460,2143 @@ uint8_t ds2431_write_memory_config(ds2431_handle_t *handle, ds2431_config_contro
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 address and len are invalid
- * @note       none
+ * @note       the bus is locked only when a row is missed
  */
-uint8_t ds2431_read(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len)
+static uint8_t a_ds2431_cache_read(ds2431_handle_t *handle, uint16_t address, uint8_t *data, uint16_t len, uint8_t api)
 {
     uint8_t res;
+    uint32_t mask;
     
-    if (handle == NULL)                                                       /* check handle */
+    mask = a_ds2431_cache_mask(address, len);                   /* get rows */
+    if ((handle->ext->cache->valid & mask) != mask)             /* check miss */
     {
-        return 2;                                                             /* return error */
+        if (a_ds2431_lock(handle, api) != 0)                    /* lock bus */
+        {
+            return 1;                                           /* return error */
+        }
+        res = a_ds2431_cache_fill(handle, address, len);        /* fill rows */
+        a_ds2431_unlock(handle, res);                           /* unlock bus */
+        if (res != 0)                                           /* check the result */
+        {
+            return 1;                                           /* return error */
+        }
     }
-    if (handle->inited != 1)                                                  /* check handle initialization */
+    memcpy(data, &handle->ext->cache->image[address], len);     /* copy data */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      read a row through the cache if attached
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  address row address
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the bus must be locked
+ */
+static uint8_t a_ds2431_read_row(ds2431_handle_t *handle, uint16_t address, uint8_t data[8])
+{
+    if (a_ds2431_cache(handle) == NULL)                              /* check cache */
+    {
+        return a_ds2431_read(handle, address, data, 8);              /* read from the chip */
+    }
+    if (a_ds2431_cache_fill(handle, address, 8) != 0)                /* fill the row */
+    {
+        return 1;                                                    /* return error */
+    }
+    memcpy(data, &handle->ext->cache->image[address], 8);            /* copy data */
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     ds2431 write
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address input address
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds2431_write(ds2431_handle_t *handle, uint16_t address, uint8_t data[8])
+{
+    uint8_t res;
+    
+    if (a_ds2431_write_start(handle, address, data) != 0)        /* start programming */
+    {
+        a_ds2431_cache_update(handle, address, data, 1);         /* invalidate row */
+        
+        return 1;                                                /* return error */
+    }
+    a_ds2431_prog_wait(handle, DS2431_TIME_PROG_MS);             /* delay 10ms */
+    res = a_ds2431_write_finish(handle);                         /* finish programming */
+    a_ds2431_cache_update(handle, address, data, res);           /* update row */
+    
+    return res;                                                  /* return the result */
+}
+
+/**
+ * @brief      pack a digest row
+ * @param[in]  generation input generation
+ * @param[out] *buf pointer to a row buffer
+ * @note       none
+ */
+static void a_ds2431_digest_pack(uint32_t generation, uint8_t buf[8])
+{
+    uint8_t i;
+    uint16_t crc;
+    
+    buf[0] = (uint8_t)((generation >> 0) & 0xFF);         /* generation byte 0 */
+    buf[1] = (uint8_t)((generation >> 8) & 0xFF);         /* generation byte 1 */
+    buf[2] = (uint8_t)((generation >> 16) & 0xFF);        /* generation byte 2 */
+    buf[3] = (uint8_t)((generation >> 24) & 0xFF);        /* generation byte 3 */
+    buf[4] = DS2431_DIGEST_MAGIC;                         /* magic */
+    buf[5] = (uint8_t)(~DS2431_DIGEST_MAGIC);             /* inverted magic */
+    crc = 0;                                              /* crc init 0 */
+    for (i = 0; i < 6; i++)                               /* 6 bytes */
+    {
+        crc = a_ds2431_crc16_update(crc, buf[i]);         /* update crc */
+    }
+    buf[6] = (uint8_t)((crc >> 0) & 0xFF);                /* crc lsb */
+    buf[7] = (uint8_t)((crc >> 8) & 0xFF);                /* crc msb */
+}
+
+/**
+ * @brief      parse a digest row
+ * @param[in]  *buf pointer to a row buffer
+ * @param[out] *generation pointer to a generation buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 row is invalid
+ * @note       none
+ */
+static uint8_t a_ds2431_digest_parse(uint8_t buf[8], uint32_t *generation)
+{
+    uint8_t check[8];
+    uint32_t value;
+    
+    value = ((uint32_t)buf[0] << 0) | ((uint32_t)buf[1] << 8) |
+            ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);        /* get generation */
+    a_ds2431_digest_pack(value, check);                                 /* pack again */
+    if (memcmp(buf, check, 8) != 0)                                     /* check row */
+    {
+        return 1;                                                       /* return error */
+    }
+    *generation = value;                                                /* set generation */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     start programming the next generation into the digest row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 digest update failed
+ * @note      the bus must be locked
+ */
+static uint8_t a_ds2431_digest_bump_start(ds2431_handle_t *handle)
+{
+    uint8_t buf[8];
+    
+    handle->ext->generation++;                                                  /* next generation */
+    a_ds2431_digest_pack(handle->ext->generation, buf);                         /* pack row */
+    if (a_ds2431_write_start(handle, handle->ext->digest_address, buf) != 0)    /* start programming */
+    {
+        a_ds2431_cache_update(handle, handle->ext->digest_address, buf, 1);     /* invalidate row */
+        handle->ops->debug_print("ds2431: digest update failed.\n");            /* digest update failed */
+        
+        return 1;                                                               /* return error */
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     finish programming the digest row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 digest update failed
+ * @note      the bus must be locked
+ */
+static uint8_t a_ds2431_digest_bump_finish(ds2431_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t buf[8];
+    
+    res = a_ds2431_write_finish(handle);                                      /* finish programming */
+    a_ds2431_digest_pack(handle->ext->generation, buf);                       /* pack row */
+    a_ds2431_cache_update(handle, handle->ext->digest_address, buf, res);     /* update row */
+    if (res != 0)                                                             /* check the result */
+    {
+        handle->ops->debug_print("ds2431: digest update failed.\n");          /* digest update failed */
+        
+        return 1;                                                             /* return error */
+    }
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     program the next generation into the digest row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 digest update failed
+ * @note      the bus must be locked
+ */
+static uint8_t a_ds2431_digest_bump(ds2431_handle_t *handle)
+{
+    if (a_ds2431_digest_bump_start(handle) != 0)          /* start programming */
+    {
+        return 1;                                         /* return error */
+    }
+    a_ds2431_prog_wait(handle, DS2431_TIME_PROG_MS);      /* delay 10ms */
+    
+    return a_ds2431_digest_bump_finish(handle);           /* finish programming */
+}
+
+/**
+ * @brief     lock the bus and update the digest row if it is enabled
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 digest update failed
+ * @note      none
+ */
+static uint8_t a_ds2431_digest_sync(ds2431_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (a_ds2431_digest_on(handle) == 0)                           /* check digest */
+    {
+        return 0;                                                  /* disabled */
+    }
+    if (a_ds2431_lock(handle, DS2431_STATS_API_WRITE) != 0)        /* lock bus */
+    {
+        return 1;                                                  /* return error */
+    }
+    res = a_ds2431_digest_bump(handle);                            /* update digest */
+    a_ds2431_unlock(handle, res);                                  /* unlock bus */
+    
+    return res;                                                    /* return the result */
+}
+
+/**
+ * @brief      parse a memory config row
+ * @param[in]  *buf pointer to a row buffer
+ * @param[out] *config pointer to a ds2431 config control structure
+ * @note       none
+ */
+static void a_ds2431_config_parse(uint8_t buf[8], ds2431_config_control_t *config)
+{
+    config->page0_protection_control = buf[0];        /* set page0 protection control */
+    config->page1_protection_control = buf[1];        /* set page1 protection control */
+    config->page2_protection_control = buf[2];        /* set page2 protection control */
+    config->page3_protection_control = buf[3];        /* set page3 protection control */
+    config->copy_protection = buf[4];                 /* set copy protection */
+    config->factory_byte = buf[5];                    /* set factory byte */
+    config->user_byte_0 = buf[6];                     /* set user byte 0 */
+    config->user_byte_1 = buf[7];                     /* set user byte 1 */
+}
+
+/**
+ * @brief      load the memory config
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *config pointer to a ds2431 config control structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read memory config failed
+ * @note       the bus must be locked, protection bytes can only be set once on the chip
+ *             so the copy kept in the extension stays valid until the rom or the config is written,
+ *             it is the only cached copy of the config row, the shadow cache holds the data memory only,
+ *             a handle without an extension reads the config row every time
+ */
+static uint8_t a_ds2431_config_load(ds2431_handle_t *handle, ds2431_config_control_t *config)
+{
+    uint8_t buf[8];
+    
+    if ((handle->ext != NULL) && (handle->ext->config_valid != 0))    /* check cached config */
+    {
+        *config = handle->ext->config;                                /* no bus traffic */
+        
+        return 0;                                                     /* success return 0 */
+    }
+    if (a_ds2431_read(handle, 0x80, buf, 8) != 0)                     /* read config row */
+    {
+        handle->ops->debug_print("ds2431: read config failed.\n");    /* read config failed */
+        
+        return 1;                                                     /* return error */
+    }
+    a_ds2431_config_parse(buf, config);                               /* parse config */
+    if (handle->ext != NULL)                                          /* check extension */
+    {
+        handle->ext->config = *config;                                /* save config */
+        handle->ext->config_valid = 1;                                /* set valid */
+    }
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief      check a range against the page controls
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  address input address
+ * @param[in]  len data length
+ * @param[out] *config pointer to a ds2431 config control structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read memory config failed
+ *             - 6 page is write protected
+ * @note       the bus must be locked unless the config is cached in the extension,
+ *             config is left untouched when len is 0 or the handle has no extension,
+ *             so a plain handle writes like the original driver without reading the config row
+ */
+static uint8_t a_ds2431_config_check(ds2431_handle_t *handle, uint8_t address, uint8_t len,
+                                     ds2431_config_control_t *config)
+{
+    uint8_t page;
+    
+    if ((len == 0) || (handle->ext == NULL))                                               /* check length and extension */
+    {
+        return 0;                                                                          /* nothing to check */
+    }
+    if (a_ds2431_config_load(handle, config) != 0)                                         /* load config */
+    {
+        return 1;                                                                          /* return error */
+    }
+    for (page = address / 32; page <= (address + len - 1) / 32; page++)                    /* every page */
+    {
+        if (a_ds2431_page_control(config, page) == DS2431_CONFIG_WRITE_PROTECT_MODE)       /* check control */
+        {
+            handle->ops->debug_print("ds2431: page is write protected.\n");                /* page is write protected */
+            
+            return 6;                                                                      /* return error */
+        }
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     check the write back policy
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    1 if a flush is due, 0 if not
+ * @note      none
+ */
+static uint8_t a_ds2431_write_back_due(ds2431_handle_t *handle)
+{
+    ds2431_cache_t *cache;
+    
+    cache = a_ds2431_cache(handle);                                               /* get cache */
+    if (cache->dirty == 0)                                                        /* check dirty */
+    {
+        return 0;                                                                 /* nothing to flush */
+    }
+    if ((cache->flush_count != 0) && (cache->count >= cache->flush_count))        /* check count */
+    {
+        return 1;                                                                 /* due */
+    }
+    if ((cache->flush_us != 0) &&
+        ((uint32_t)(handle->ops->timestamp_us(handle->user) - cache->dirty_us)
+         >= cache->flush_us))                                                     /* check age */
+    {
+        return 1;                                                                 /* due */
+    }
+    
+    return 0;                                                                     /* not due */
+}
+
+/**
+ * @brief     program every dirty row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      the bus must be locked
+ */
+static uint8_t a_ds2431_flush(ds2431_handle_t *handle)
+{
+    uint8_t row;
+    uint8_t mode;
+    uint8_t res;
+    uint8_t buf[8];
+    uint32_t dirty;
+    ds2431_cache_t *cache;
+    
+    cache = a_ds2431_cache(handle);                                      /* get cache */
+    dirty = cache->dirty;                                                /* save dirty rows */
+    mode = handle->mode;                                                 /* save mode */
+    res = 0;                                                             /* init 0 */
+    for (row = 0; row < 16; row++)                                       /* address order */
+    {
+        if ((cache->dirty & (1UL << row)) == 0)                          /* check dirty */
+        {
+            continue;                                                    /* next row */
+        }
+        memcpy(buf, &cache->image[row * 8], 8);                          /* copy row */
+        cache->dirty &= ~(1UL << row);                                   /* clear dirty */
+        res = a_ds2431_write(handle, row * 8, buf);                      /* program row */
+        if (handle->mode == DS2431_MODE_MATCH_ROM)                       /* match rom selected the chip */
+        {
+            handle->mode = DS2431_MODE_RESUME;                           /* resume the next rows */
+        }
+        else
+        {
+            /* the overdrive copy step ends with a skip rom, which clears the resume flag */
+        }
+        if (res != 0)                                                    /* check the result */
+        {
+            memcpy(&cache->image[row * 8], buf, 8);                      /* keep the row */
+            cache->valid |= 1UL << row;                                  /* set valid */
+            cache->dirty |= 1UL << row;                                  /* set dirty */
+            
+            break;                                                       /* stop */
+        }
+    }
+    handle->mode = mode;                                                 /* restore mode */
+    if ((dirty != 0) && (a_ds2431_digest_on(handle) != 0))               /* rows were programmed */
+    {
+        if (a_ds2431_digest_bump(handle) != 0)                           /* update digest */
+        {
+            res = 1;                                                     /* set error */
+        }
+    }
+    if (res != 0)                                                        /* check the result */
+    {
+        return 1;                                                        /* return error */
+    }
+    cache->count = 0;                                                    /* reset count */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     write data into the write back image
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address input address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      only partial rows that are not cached are read from the chip
+ */
+static uint8_t a_ds2431_write_back(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len)
+{
+    uint8_t res;
+    uint32_t mask;
+    uint32_t part;
+    ds2431_cache_t *cache;
+    
+    cache = a_ds2431_cache(handle);                                              /* get cache */
+    mask = a_ds2431_cache_mask(address, len);                                    /* get rows */
+    part = 0;                                                                    /* init 0 */
+    if ((len != 0) && ((address % 8) != 0))                                      /* check the first row */
+    {
+        part |= 1UL << (address / 8);                                            /* partial row */
+    }
+    if ((len != 0) && (((address + len) % 8) != 0))                              /* check the last row */
+    {
+        part |= 1UL << ((address + len) / 8);                                    /* partial row */
+    }
+    part &= ~cache->valid;                                                       /* missed partial rows */
+    if (part != 0)                                                               /* check missed */
+    {
+        if (a_ds2431_lock(handle, DS2431_STATS_API_WRITE) != 0)                  /* lock bus */
+        {
+            return 1;                                                            /* return error */
+        }
+        res = 0;                                                                 /* init 0 */
+        if ((part & (1UL << (address / 8))) != 0)                                /* first row */
+        {
+            res = a_ds2431_cache_fill(handle, address, 1);                       /* fill row */
+        }
+        if ((res == 0) && ((part & (1UL << ((address + len) / 8))) != 0))        /* last row */
+        {
+            res = a_ds2431_cache_fill(handle, address + len, 1);                 /* fill row */
+        }
+        a_ds2431_unlock(handle, res);                                            /* unlock bus */
+        if (res != 0)                                                            /* check the result */
+        {
+            return 1;                                                            /* return error */
+        }
+    }
+    
+    if ((cache->dirty == 0) && (handle->ops->timestamp_us != NULL))              /* first dirty row */
+    {
+        cache->dirty_us = handle->ops->timestamp_us(handle->user);               /* save age */
+    }
+    memcpy(&cache->image[address], data, len);                                   /* update image */
+    cache->valid |= mask;                                                        /* set valid */
+    cache->dirty |= mask;                                                        /* set dirty */
+    if (cache->count < 0xFF)                                                     /* check count */
+    {
+        cache->count++;                                                          /* count++ */
+    }
+    if (a_ds2431_write_back_due(handle) != 0)                                    /* check policy */
+    {
+        if (a_ds2431_lock(handle, DS2431_STATS_API_WRITE) != 0)                  /* lock bus */
+        {
+            return 1;                                                            /* return error */
+        }
+        res = a_ds2431_flush(handle);                                            /* flush */
+        a_ds2431_unlock(handle, res);                                            /* unlock bus */
+        if (res != 0)                                                            /* check the result */
+        {
+            return 1;                                                            /* return error */
+        }
+    }
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     copy scratchpad
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address input address
+ * @return    status code
+ *            - 0 success
+ *            - 1 copy scratchpad failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address >= 0x0080
+ *            - 5 address is invalid
+ *            - 6 address is reserved
+ * @note      with the digest enabled the digest row can't be copied and
+ *            a successful copy programs the next generation before the bus is unlocked
+ */
+uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    if ((a_ds2431_digest_on(handle) != 0) &&
+        (address == handle->ext->digest_address))                            /* check digest row */
+    {
+        handle->ops->debug_print("ds2431: address is reserved.\n");          /* address is reserved */
+        
+        return 6;                                                            /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_COPY_SCRATCHPAD) != 0)        /* lock bus */
+    {
+        return 1;                                                            /* return error */
+    }
+    res = a_ds2431_copy_scratchpad(handle, address);                         /* copy scratchpad */
+    a_ds2431_cache_update(handle, address, NULL, 1);                         /* invalidate row or config */
+    if ((res == 0) && (a_ds2431_digest_on(handle) != 0))                     /* data memory changed */
+    {
+        res = a_ds2431_digest_bump(handle);                                  /* update digest */
+    }
+    a_ds2431_unlock(handle, res);                                            /* unlock bus */
+    
+    return res;                                                              /* return the result */
+}
+
+/**
+ * @brief      read memory config
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *config pointer to a ds2431 config control structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read memory config failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       with a shadow cache the memory config kept in the extension is returned without bus traffic,
+ *             the result also refreshes the memory config kept in the extension
+ */
+uint8_t ds2431_read_memory_config(ds2431_handle_t *handle, ds2431_config_control_t *config)
+{
+    uint8_t res;
+    uint8_t buf[8];
+    
+    if (handle == NULL)                                                                              /* check handle */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                                         /* check handle initialization */
+    {
+        return 3;                                                                                    /* return error */
+    }
+    
+    if ((a_ds2431_cache(handle) != NULL) && (handle->ext->config_valid != 0))                        /* check cached config */
+    {
+        *config = handle->ext->config;                                                               /* no bus traffic */
+        
+        return 0;                                                                                    /* success return 0 */
+    }
+    if (a_ds2431_lock(handle, DS2431_STATS_API_READ_MEMORY_CONFIG) != 0)                             /* lock bus */
+    {
+        return 1;                                                                                    /* return error */
+    }
+    res = a_ds2431_read(handle, 0x80, buf, 8);                                                       /* read config */
+    a_ds2431_unlock(handle, res);                                                                    /* unlock bus */
+    if (res != 0)                                                                                    /* check the result */
+    {
+        return 1;                                                                                    /* return error */
+    }
+    config->page0_protection_control = buf[0];                                                       /* set page0 protection control */
+    config->page1_protection_control = buf[1];                                                       /* set page1 protection control */
+    config->page2_protection_control = buf[2];                                                       /* set page2 protection control */
+    config->page3_protection_control = buf[3];                                                       /* set page3 protection control */
+    config->copy_protection = buf[4];                                                                /* set copy protection */
+    config->factory_byte = buf[5];                                                                   /* set factory byte */
+    config->user_byte_0 = buf[6];                                                                    /* set user byte 0 */
+    config->user_byte_1 = buf[7];                                                                    /* set user byte 1 */
+    if (handle->ext != NULL)                                                                         /* check extension */
+    {
+        handle->ext->config = *config;                                                               /* refresh cached config */
+        handle->ext->config_valid = 1;                                                               /* set valid */
+    }
+    
+    return 0;                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     write memory config
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *config pointer to a ds2431 config control structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write memory config failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 config is copy protected
+ * @note      the cached memory config is dropped and reloaded on the next write
+ */
+uint8_t ds2431_write_memory_config(ds2431_handle_t *handle, ds2431_config_control_t *config)
+{
+    uint8_t res;
+    uint8_t buf[8];
+    ds2431_config_control_t current;
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    buf[0] = config->page0_protection_control;                                       /* set page0 protection control */
+    buf[1] = config->page1_protection_control;                                       /* set page1 protection control */
+    buf[2] = config->page2_protection_control;                                       /* set page2 protection control */
+    buf[3] = config->page3_protection_control;                                       /* set page3 protection control */
+    buf[4] = config->copy_protection;                                                /* set copy protection */
+    buf[5] = config->factory_byte;                                                   /* set factory byte */
+    buf[6] = config->user_byte_0;                                                    /* set user byte 0 */
+    buf[7] = config->user_byte_1;                                                    /* set user byte 1 */
+    if (a_ds2431_lock(handle, DS2431_STATS_API_WRITE_MEMORY_CONFIG) != 0)            /* lock bus */
+    {
+        return 1;                                                                    /* return error */
+    }
+    if (a_ds2431_config_load(handle, &current) != 0)                                 /* load config */
+    {
+        a_ds2431_unlock(handle, 1);                                                  /* unlock bus */
+        
+        return 1;                                                                    /* return error */
+    }
+    if ((current.copy_protection == DS2431_CONFIG_EPROM_MODE) ||
+        (current.copy_protection == DS2431_CONFIG_WRITE_PROTECT_MODE))               /* check copy protection */
+    {
+        a_ds2431_unlock(handle, 4);                                                  /* unlock bus */
+        handle->ops->debug_print("ds2431: config is copy protected.\n");             /* config is copy protected */
+        
+        return 4;                                                                    /* return error */
+    }
+    res = a_ds2431_write(handle, 0x80, buf);                                         /* write config and drop the cached one */
+    a_ds2431_unlock(handle, res);                                                    /* unlock bus */
+    if (res != 0)                                                                    /* check the result */
+    {
+        return 1;                                                                    /* return error */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      read data
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  address input address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address and len are invalid
+ * @note       none
+ */
+uint8_t ds2431_read(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    if ((address + len) > 0x80)                                                              /* check address */
+    {
+        handle->ops->debug_print("ds2431: address and len are invalid.\n");                  /* address and len are invalid */
+        
+        return 4;                                                                            /* return error */
+    }
+    
+    if (a_ds2431_cache(handle) != NULL)                                                      /* check cache */
+    {
+        res = a_ds2431_cache_read(handle, address, data, len, DS2431_STATS_API_READ);        /* read through the cache */
+    }
+    else
+    {
+        if (a_ds2431_lock(handle, DS2431_STATS_API_READ) != 0)                               /* lock bus */
+        {
+            return 1;                                                                        /* return error */
+        }
+        res = a_ds2431_read(handle, address, data, len);                                     /* read data */
+        a_ds2431_unlock(handle, res);                                                        /* unlock bus */
+    }
+    if (res != 0)                                                                            /* check the result */
+    {
+        return 1;                                                                            /* return error */
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     write data
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address input address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address and len are invalid
+ *            - 5 range covers the digest row
+ *            - 6 page is write protected
+ * @note      the digest row is programmed once after the data if it is enabled,
+ *            with an extension page controls are checked against the cached memory config before any row is sent,
+ *            the config is read once and the bus is only locked for that check when it has to be read,
+ *            rows of eprom mode pages are programmed with the bitwise and of the old and the new data
+ *            and skipped if that changes nothing, a handle without an extension never reads the config
+ */
+uint8_t ds2431_write(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t eprom;
+    uint8_t same;
+    uint8_t value;
+    uint8_t written;
+    uint8_t fetch;
+    uint32_t pos;
+    uint32_t off;
+    uint32_t remain;
+    uint8_t buffer[8 + 1];
+    ds2431_config_control_t config;
+    
+    if (handle == NULL)                                                       /* check handle */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                  /* check handle initialization */
+    {
+        return 3;                                                             /* return error */
+    }
+    if ((address + len) > 0x80)                                               /* check address */
+    {
+        handle->ops->debug_print("ds2431: address and len are invalid.\n");   /* address and len are invalid */
+        
+        return 4;                                                             /* return error */
+    }
+    if ((a_ds2431_digest_on(handle) != 0) && (len != 0) &&
+        (address < (handle->ext->digest_address + 8)) &&
+        ((address + len) > handle->ext->digest_address))                      /* check digest row */
+    {
+        handle->ops->debug_print("ds2431: range covers the digest row.\n");   /* range covers the digest row */
+        
+        return 5;                                                             /* return error */
+    }
+    fetch = ((len != 0) && (handle->ext != NULL) &&
+             (handle->ext->config_valid == 0)) ? 1 : 0;                       /* config must be read */
+    if (fetch != 0)                                                           /* check fetch */
+    {
+        if (a_ds2431_lock(handle, DS2431_STATS_API_WRITE) != 0)               /* lock bus */
+        {
+            return 1;                                                         /* return error */
+        }
+    }
+    memset(&config, 0, sizeof(ds2431_config_control_t));                     /* clear config */
+    res = a_ds2431_config_check(handle, address, len, &config);               /* check page controls */
+    if (fetch != 0)                                                           /* check fetch */
+    {
+        a_ds2431_unlock(handle, res);                                         /* unlock bus */
+    }
+    if (res != 0)                                                             /* check the result */
+    {
+        return res;                                                           /* return error */
+    }
+    
+    if ((a_ds2431_cache(handle) != NULL) &&
+        (handle->ext->cache->write_back != 0))                                /* check write back */
+    {
+        if (a_ds2431_write_back(handle, address, data, len) != 0)             /* write the image */
+        {
+            return 1;                                                         /* return error */
+        }
+        
+        return 0;                                                             /* success return 0 */
+    }
+    
+    written = 0;                                                              /* init 0 */
+    pos = address / 8;                                                        /* set pos */
+    off = address % 8;                                                        /* set off */
+    remain = 8 - off;                                                         /* set remain */
+    if (len <= remain)                                                        /* check length */
+    {
+        remain = len;                                                         /* set remain */
+    }
+    while(1)                                                                  /* loop */
+    {    
+        if (a_ds2431_lock(handle, DS2431_STATS_API_WRITE) != 0)               /* lock bus per row */
+        {
+            return 1;                                                         /* return error */
+        }
+        eprom = (a_ds2431_page_control(&config, (uint8_t)(pos / 4)) ==
+                 DS2431_CONFIG_EPROM_MODE) ? 1 : 0;                           /* check eprom mode */
+        if ((remain != 8) || (eprom != 0))                                    /* check remain and eprom mode */
+        {
+            res = a_ds2431_read_row(handle, pos * 8, buffer);                 /* read data */
+            if (res == 0)                                                     /* check the result */
+            {
+                same = 1;                                                     /* init 1 */
+                for (i = 0; i < remain; i++)                                  /* write remain */
+                {
+                    value = (eprom != 0) ? (buffer[i + off] & data[i]) :
+                                           data[i];                           /* bits can only be cleared */
+                    if (buffer[i + off] != value)                             /* check change */
+                    {
+                        same = 0;                                             /* row changes */
+                    }
+                    buffer[i + off] = value;                                  /* copy data */
+                }
+                if ((eprom == 0) || (same == 0))                              /* skip no-op eprom rows */
+                {
+                    res = a_ds2431_write(handle, pos * 8, buffer);            /* write data */
+                    written = 1;                                              /* programmed */
+                }
+            }
+        }
+        else
+        {
+            res = a_ds2431_write(handle, address, data);                      /* write data */
+            written = 1;                                                      /* programmed */
+        } 
+        a_ds2431_unlock(handle, res);                                         /* unlock bus */
+        if (res != 0)                                                         /* check the result */
+        {
+            (void)a_ds2431_digest_sync(handle);                               /* rows may have changed */
+            
+            return 1;                                                         /* return error */
+        }
+        
+        if (len == remain)                                                    /* check length length*/
+        {
+            break;                                                            /* break loop */
+        }
+        else
+        {
+            pos++;                                                            /* position++ */
+            off = 0;                                                          /* set offset */
+            data += remain;                                                   /* data + remain */
+            address += remain;                                                /* addr + remain */
+            len -= remain;                                                    /* len - remain */
+            if (len > 8)                                                      /* check length */
+            {
+                remain = 8;                                                   /* set 8 */
+            }
+            else
+            {
+                remain = len;                                                 /* set length */
+            }
+        }
+    }
+    if ((written != 0) && (a_ds2431_digest_sync(handle) != 0))                /* update digest */
+    {
+        return 1;                                                             /* return error */
+    }
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     start a row write without waiting for the programming time
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address row address
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write row start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address is invalid
+ *            - 5 address is the digest row
+ *            - 6 page is write protected
+ *            - 7 a row is pending
+ * @note      address must be a multiple of 8 and not over 0x78,
+ *            the chip is programming for 10ms after success and the bus must not be used
+ *            until ds2431_write_row_finish is called, other buses are free,
+ *            the bus lock is held until the row is no longer pending,
+ *            the page control is only checked for a handle with an extension
+ */
+uint8_t ds2431_write_row_start(ds2431_handle_t *handle, uint8_t address, uint8_t data[8])
+{
+    uint8_t res;
+    ds2431_config_control_t config;
+    
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if ((address > 0x78) || ((address % 8) != 0))                          /* check address */
+    {
+        handle->ops->debug_print("ds2431: address is invalid.\n");         /* address is invalid */
+        
+        return 4;                                                          /* return error */
+    }
+    if ((a_ds2431_digest_on(handle) != 0) &&
+        (address == handle->ext->digest_address))                          /* check digest row */
+    {
+        handle->ops->debug_print("ds2431: address is reserved.\n");        /* address is reserved */
+        
+        return 5;                                                          /* return error */
+    }
+    if (handle->row_pending != 0)                                          /* check pending row */
+    {
+        handle->ops->debug_print("ds2431: a row is pending.\n");           /* a row is pending */
+        
+        return 7;                                                          /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_WRITE_ROW) != 0)            /* lock bus until finish */
+    {
+        return 1;                                                          /* return error */
+    }
+    res = a_ds2431_config_check(handle, address, 8, &config);              /* check page control */
+    if (res != 0)                                                          /* check the result */
+    {
+        a_ds2431_unlock(handle, res);                                      /* unlock bus */
+        
+        return res;                                                        /* return error */
+    }
+    a_ds2431_cache_update(handle, address, data, 1);                       /* invalidate row */
+    if (a_ds2431_write_start(handle, address, data) != 0)                  /* start programming */
+    {
+        a_ds2431_unlock(handle, 1);                                        /* unlock bus */
+        
+        return 1;                                                          /* return error */
+    }
+    handle->row_pending = 1;                                               /* data row is pending */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     finish a row write started by ds2431_write_row_start
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write row finish failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no row is pending
+ * @note      call it at least 10ms after ds2431_write_row_start,
+ *            with the digest enabled the first call starts programming the digest row and
+ *            the row stays pending, call it once more at least 10ms later,
+ *            the bus lock is released when the row is no longer pending
+ */
+uint8_t ds2431_write_row_finish(ds2431_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                            /* check handle */
+    {
+        return 2;                                                  /* return error */
+    }
+    if (handle->inited != 1)                                       /* check handle initialization */
+    {
+        return 3;                                                  /* return error */
+    }
+    if (handle->row_pending == 0)                                  /* check pending row */
+    {
+        handle->ops->debug_print("ds2431: no row is pending.\n");  /* no row is pending */
+        
+        return 4;                                                  /* return error */
+    }
+    
+    if (handle->row_pending == 1)                                  /* data row */
+    {
+        res = a_ds2431_write_finish(handle);                       /* finish programming */
+        if ((res == 0) && (a_ds2431_digest_on(handle) != 0))       /* check digest */
+        {
+            res = a_ds2431_digest_bump_start(handle);              /* start digest update */
+            if (res == 0)                                          /* check the result */
+            {
+                handle->row_pending = 2;                           /* digest row is pending */
+                
+                return 0;                                          /* success return 0 */
+            }
+        }
+    }
+    else                                                           /* digest row */
+    {
+        res = a_ds2431_digest_bump_finish(handle);                 /* finish digest update */
+    }
+    handle->row_pending = 0;                                       /* clear pending row */
+    a_ds2431_unlock(handle, res);                                  /* unlock bus */
+    if (res != 0)                                                  /* check the result */
+    {
+        return 1;                                                  /* return error */
+    }
+    
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the pending row state
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *pending pointer to a pending buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       true until ds2431_write_row_finish has released the bus lock
+ */
+uint8_t ds2431_get_row_pending(ds2431_handle_t *handle, ds2431_bool_t *pending)
+{
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    *pending = (handle->row_pending != 0) ? DS2431_BOOL_TRUE :
+                                            DS2431_BOOL_FALSE;          /* get pending */
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     link an extension
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *ext pointer to a ds2431 extension structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      NULL unlinks the extension and everything attached to it,
+ *            the extension is cleared and may be linked before ds2431_init,
+ *            the cache, the digest, the trace, the stats and the transaction hooks need one
+ */
+uint8_t ds2431_set_extension(ds2431_handle_t *handle, ds2431_extension_t *ext)
+{
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    if (ext != NULL)                                         /* check extension */
+    {
+        memset(ext, 0, sizeof(ds2431_extension_t));          /* clear extension */
+    }
+    handle->ext = ext;                                       /* set extension */
+    
+    return 0;                                                /* success return 0 */
+}
+
+/**
+ * @brief     attach a shadow cache
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *cache pointer to a ds2431 cache structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 extension is NULL
+ * @note      NULL detaches the cache, every row starts invalid and fills on first access,
+ *            ds2431_read is served from valid rows and ds2431_read_memory_config from the
+ *            memory config kept in the extension, which is the only cached copy of the config row,
+ *            successful writes update the image unless the page is protected or in eprom mode
+ */
+uint8_t ds2431_set_cache(ds2431_handle_t *handle, ds2431_cache_t *cache)
+{
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if ((cache != NULL) && (handle->ext == NULL))        /* check extension */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    if (cache != NULL)                                   /* check cache */
+    {
+        cache->valid = 0;                                /* invalidate all */
+        cache->dirty = 0;                                /* clear dirty */
+        cache->write_back = 0;                           /* write through */
+        cache->count = 0;                                /* clear count */
+    }
+    if (handle->ext != NULL)                             /* check extension */
+    {
+        handle->ext->cache = cache;                      /* set cache */
+    }
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     invalidate the cached rows of a range
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address input address
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 cache is NULL
+ *            - 4 address and len are invalid
+ * @note      address + len must not be over 0x80
+ */
+uint8_t ds2431_cache_invalidate(ds2431_handle_t *handle, uint8_t address, uint8_t len)
+{
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (a_ds2431_cache(handle) == NULL)                                        /* check cache */
+    {
+        return 3;                                                              /* return error */
+    }
+    if ((address + len) > DS2431_CACHE_SIZE)                                   /* check address */
+    {
+        handle->ops->debug_print("ds2431: address and len are invalid.\n");    /* address and len are invalid */
+        
+        return 4;                                                              /* return error */
+    }
+    
+    handle->ext->cache->valid &= ~a_ds2431_cache_mask(address, len);           /* clear valid */
+    handle->ext->cache->dirty &= ~a_ds2431_cache_mask(address, len);           /* drop pending data */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     reload the whole shadow image from the chip
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cache is NULL
+ * @note      the memory config kept in the extension is reloaded as well
+ */
+uint8_t ds2431_cache_refresh(ds2431_handle_t *handle)
+{
+    uint8_t res;
+    ds2431_config_control_t config;
+    
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if (a_ds2431_cache(handle) == NULL)                                    /* check cache */
+    {
+        handle->ops->debug_print("ds2431: cache is null.\n");              /* cache is null */
+        
+        return 4;                                                          /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_CACHE_REFRESH) != 0)        /* lock bus */
+    {
+        return 1;                                                          /* return error */
+    }
+    handle->ext->cache->valid = handle->ext->cache->dirty;                 /* keep dirty rows */
+    res = a_ds2431_cache_fill(handle, 0x00, DS2431_CACHE_SIZE);            /* read all rows */
+    if (res == 0)                                                          /* check the result */
+    {
+        a_ds2431_config_drop(handle);                                      /* drop cached config */
+        res = a_ds2431_config_load(handle, &config);                       /* reload config */
+    }
+    a_ds2431_unlock(handle, res);                                          /* unlock bus */
+    if (res != 0)                                                          /* check the result */
+    {
+        return 1;                                                          /* return error */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the valid row mask
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *valid pointer to a valid mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 cache is NULL
+ * @note       bit n is row n at address n * 8
+ */
+uint8_t ds2431_cache_get_valid(ds2431_handle_t *handle, uint32_t *valid)
+{
+    if (handle == NULL)                      /* check handle */
+    {
+        return 2;                            /* return error */
+    }
+    if (a_ds2431_cache(handle) == NULL)      /* check cache */
+    {
+        return 3;                            /* return error */
+    }
+    
+    *valid = handle->ext->cache->valid;      /* get valid */
+    
+    return 0;                                /* success return 0 */
+}
+
+/**
+ * @brief      get the dirty row mask
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *dirty pointer to a dirty mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 cache is NULL
+ * @note       bit n is row n at address n * 8
+ */
+uint8_t ds2431_cache_get_dirty(ds2431_handle_t *handle, uint32_t *dirty)
+{
+    if (handle == NULL)                      /* check handle */
+    {
+        return 2;                            /* return error */
+    }
+    if (a_ds2431_cache(handle) == NULL)      /* check cache */
+    {
+        return 3;                            /* return error */
+    }
+    
+    *dirty = handle->ext->cache->dirty;      /* get dirty */
+    
+    return 0;                                /* success return 0 */
+}
+
+/**
+ * @brief     set the write back policy
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] enable bool value
+ * @param[in] flush_count flush after this many writes, 0 is disabled
+ * @param[in] flush_us flush once the oldest dirty row is this old, 0 is disabled
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 cache is NULL
+ *            - 4 timestamp_us is NULL
+ *            - 5 dirty rows must be flushed first
+ * @note      with write back enabled ds2431_write only updates the cached image and marks
+ *            the rows dirty, ds2431_flush programs them, flush_us is checked by
+ *            ds2431_write and ds2431_write_back_poll and needs the timestamp_us callback
+ */
+uint8_t ds2431_set_write_back(ds2431_handle_t *handle, ds2431_bool_t enable, uint8_t flush_count, uint32_t flush_us)
+{
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (a_ds2431_cache(handle) == NULL)                                            /* check cache */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if ((flush_us != 0) && (handle->ops->timestamp_us == NULL))                    /* check timestamp_us */
+    {
+        handle->ops->debug_print("ds2431: timestamp_us is null.\n");               /* timestamp_us is null */
+        
+        return 4;                                                                  /* return error */
+    }
+    if ((enable == DS2431_BOOL_FALSE) && (handle->ext->cache->dirty != 0))         /* check dirty */
+    {
+        handle->ops->debug_print("ds2431: dirty rows must be flushed first.\n");   /* dirty rows must be flushed first */
+        
+        return 5;                                                                  /* return error */
+    }
+    
+    handle->ext->cache->write_back = (uint8_t)enable;                              /* set write back */
+    handle->ext->cache->flush_count = flush_count;                                 /* set flush count */
+    handle->ext->cache->flush_us = flush_us;                                       /* set flush time */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     program every dirty row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cache is NULL
+ * @note      rows are programmed in address order under one bus lock,
+ *            in match rom modes the rows after the first are selected with resume,
+ *            a row that fails stays dirty
+ */
+uint8_t ds2431_flush(ds2431_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                          /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (handle->inited != 1)                                     /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    if (a_ds2431_cache(handle) == NULL)                          /* check cache */
+    {
+        handle->ops->debug_print("ds2431: cache is null.\n");    /* cache is null */
+        
+        return 4;                                                /* return error */
+    }
+    
+    if (handle->ext->cache->dirty == 0)                          /* check dirty */
+    {
+        handle->ext->cache->count = 0;                           /* reset count */
+        
+        return 0;                                                /* nothing to flush */
+    }
+    if (a_ds2431_lock(handle, DS2431_STATS_API_FLUSH) != 0)      /* lock bus */
+    {
+        return 1;                                                /* return error */
+    }
+    res = a_ds2431_flush(handle);                                /* flush */
+    a_ds2431_unlock(handle, res);                                /* unlock bus */
+    
+    return res;                                                  /* return the result */
+}
+
+/**
+ * @brief     flush if the write back policy is due
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cache is NULL
+ * @note      call it periodically so an idle burst is flushed after flush_us
+ */
+uint8_t ds2431_write_back_poll(ds2431_handle_t *handle)
+{
+    if (handle == NULL)                                          /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (handle->inited != 1)                                     /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    if (a_ds2431_cache(handle) == NULL)                          /* check cache */
+    {
+        handle->ops->debug_print("ds2431: cache is null.\n");    /* cache is null */
+        
+        return 4;                                                /* return error */
+    }
+    
+    if (a_ds2431_write_back_due(handle) == 0)                    /* check policy */
+    {
+        return 0;                                                /* not due */
+    }
+    
+    return ds2431_flush(handle);                                 /* flush */
+}
+
+/**
+ * @brief     enable or disable the digest row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] enable bool value
+ * @param[in] address digest row address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set digest failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address is invalid
+ *            - 5 extension is NULL
+ * @note      address must be a multiple of 8 and not over 0x78,
+ *            the row holds a 32 bit generation, a magic byte and a crc16,
+ *            a blank or corrupted row is written with generation 0,
+ *            every later write through ds2431_write, ds2431_write_row_finish or ds2431_flush
+ *            programs the row once more with the next generation,
+ *            ds2431_write refuses ranges that cover the row
+ */
+uint8_t ds2431_set_digest(ds2431_handle_t *handle, ds2431_bool_t enable, uint8_t address)
+{
+    uint8_t res;
+    uint8_t buf[8];
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if ((address > 0x78) || ((address % 8) != 0))                                    /* check address */
+    {
+        handle->ops->debug_print("ds2431: address is invalid.\n");                   /* address is invalid */
+        
+        return 4;                                                                    /* return error */
+    }
+    if (enable == DS2431_BOOL_FALSE)                                                 /* check enable */
+    {
+        if (handle->ext != NULL)                                                     /* check extension */
+        {
+            handle->ext->digest = 0;                                                 /* disable digest */
+        }
+        
+        return 0;                                                                    /* success return 0 */
+    }
+    if (handle->ext == NULL)                                                         /* check extension */
+    {
+        handle->ops->debug_print("ds2431: extension is null.\n");                    /* extension is null */
+        
+        return 5;                                                                    /* return error */
+    }
+    
+    handle->ext->digest = 0;                                                         /* disable first */
+    if (a_ds2431_lock(handle, DS2431_STATS_API_SET_DIGEST) != 0)                     /* lock bus */
+    {
+        return 1;                                                                    /* return error */
+    }
+    res = a_ds2431_read(handle, address, buf, 8);                                    /* read row from the chip */
+    if ((res == 0) &&
+        (a_ds2431_digest_parse(buf, &handle->ext->generation) != 0))                 /* check row */
+    {
+        a_ds2431_digest_pack(0, buf);                                                /* generation 0 */
+        res = a_ds2431_write(handle, address, buf);                                  /* program row */
+        handle->ext->generation = 0;                                                 /* set generation */
+    }
+    a_ds2431_unlock(handle, res);                                                    /* unlock bus */
+    if (res != 0)                                                                    /* check the result */
+    {
+        handle->ops->debug_print("ds2431: set digest failed.\n");                    /* set digest failed */
+        
+        return 1;                                                                    /* return error */
+    }
+    handle->ext->digest_address = address;                                           /* set address */
+    handle->ext->digest = 1;                                                         /* enable digest */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      get the last known digest
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *digest pointer to a digest buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 digest is disabled
+ * @note       no bus traffic
+ */
+uint8_t ds2431_get_digest(ds2431_handle_t *handle, uint32_t *digest)
+{
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    if (a_ds2431_digest_on(handle) == 0)                             /* check digest */
+    {
+        handle->ops->debug_print("ds2431: digest is disabled.\n");   /* digest is disabled */
+        
+        return 4;                                                    /* return error */
+    }
+    
+    *digest = handle->ext->generation;                               /* get digest */
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief      check if the memory changed since a known digest
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  known_digest digest saved by the caller
+ * @param[out] *changed pointer to a bool value buffer
+ * @param[out] *digest pointer to a current digest buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 digest is disabled
+ * @note       only the 8 byte digest row is read from the chip, never from the cache,
+ *             a corrupted row reads as changed,
+ *             if it changed the clean rows of an attached cache are invalidated
+ */
+uint8_t ds2431_is_changed(ds2431_handle_t *handle, uint32_t known_digest, ds2431_bool_t *changed, uint32_t *digest)
+{
+    uint8_t res;
+    uint8_t buf[8];
+    uint32_t generation;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if (a_ds2431_digest_on(handle) == 0)                                    /* check digest */
+    {
+        handle->ops->debug_print("ds2431: digest is disabled.\n");          /* digest is disabled */
+        
+        return 4;                                                           /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_IS_CHANGED) != 0)            /* lock bus */
+    {
+        return 1;                                                           /* return error */
+    }
+    res = a_ds2431_read(handle, handle->ext->digest_address, buf, 8);       /* read digest row */
+    a_ds2431_unlock(handle, res);                                           /* unlock bus */
+    if (res != 0)                                                           /* check the result */
+    {
+        handle->ops->debug_print("ds2431: read failed.\n");                 /* read failed */
+        
+        return 1;                                                           /* return error */
+    }
+    if (a_ds2431_digest_parse(buf, &generation) != 0)                       /* check row */
+    {
+        *changed = DS2431_BOOL_TRUE;                                        /* unknown is changed */
+        *digest = handle->ext->generation;                                  /* keep the last digest */
+    }
+    else
+    {
+        *changed = (generation != known_digest) ? DS2431_BOOL_TRUE :
+                                                  DS2431_BOOL_FALSE;        /* compare */
+        *digest = generation;                                               /* set digest */
+        handle->ext->generation = generation;                               /* follow the chip */
+    }
+    if ((*changed == DS2431_BOOL_TRUE) &&
+        (a_ds2431_cache(handle) != NULL))                                   /* check cache */
+    {
+        handle->ext->cache->valid &= handle->ext->cache->dirty;             /* drop clean rows */
+    }
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     attach a bus trace
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *trace pointer to a ds2431 trace structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 extension is NULL
+ * @note      NULL detaches the trace, it may be attached before ds2431_init,
+ *            every reset, byte, search bit and crc16 check is recorded as one 32 bit event,
+ *            the timestamps need the timestamp_us callback and are 0 without it,
+ *            once the ring is full the oldest events are overwritten
+ */
+uint8_t ds2431_set_trace(ds2431_handle_t *handle, ds2431_trace_t *trace)
+{
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if ((trace != NULL) && (handle->ext == NULL))        /* check extension */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    if (trace != NULL)                                   /* check trace */
+    {
+        trace->head = 0;                                 /* clear head */
+        trace->tail = 0;                                 /* clear tail */
+    }
+    if (handle->ext != NULL)                             /* check extension */
+    {
+        handle->ext->trace = trace;                      /* set trace */
+    }
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief         take the oldest events from the trace
+ * @param[in]     *handle pointer to a ds2431 handle structure
+ * @param[out]    *event pointer to an event buffer
+ * @param[in,out] *len pointer to an event length buffer
+ * @param[out]    *lost pointer to a lost event number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 trace is NULL
+ * @note          len is the buffer size on input and the number of events taken on output,
+ *                lost is the number of events overwritten since the last call
+ */
+uint8_t ds2431_trace_read(ds2431_handle_t *handle, uint32_t *event, uint16_t *len, uint32_t *lost)
+{
+    uint16_t i;
+    ds2431_trace_t *trace;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if ((handle->ext == NULL) || (handle->ext->trace == NULL))                 /* check trace */
+    {
+        handle->ops->debug_print("ds2431: trace is null.\n");                 /* trace is null */
+        
+        return 3;                                                              /* return error */
+    }
+    
+    trace = handle->ext->trace;                                                /* get trace */
+    *lost = 0;                                                                 /* init 0 */
+    if ((uint32_t)(trace->head - trace->tail) > DS2431_TRACE_SIZE)             /* check overwritten events */
+    {
+        *lost = trace->head - trace->tail - DS2431_TRACE_SIZE;                 /* set lost */
+        trace->tail = trace->head - DS2431_TRACE_SIZE;                         /* skip them */
+    }
+    for (i = 0; (i < *len) && (trace->tail != trace->head); i++)               /* copy the oldest first */
+    {
+        event[i] = trace->event[trace->tail & (DS2431_TRACE_SIZE - 1)];        /* copy event */
+        trace->tail++;                                                         /* next event */
+    }
+    *len = i;                                                                  /* set length */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     attach the performance counters
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *stats pointer to a ds2431 stats structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 extension is NULL
+ * @note      NULL detaches the counters, attaching clears them and it may be done before ds2431_init,
+ *            the irq off times and the histograms need the timestamp_us callback,
+ *            one histogram sample is the time from taking the bus lock to releasing it,
+ *            so calls served from the cache add none and ds2431_write adds one per row
+ */
+uint8_t ds2431_set_stats(ds2431_handle_t *handle, ds2431_stats_t *stats)
+{
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if ((stats != NULL) && (handle->ext == NULL))        /* check extension */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    if (stats != NULL)                                   /* check stats */
+    {
+        memset(stats, 0, sizeof(ds2431_stats_t));        /* clear counters */
+    }
+    if (handle->ext != NULL)                             /* check extension */
+    {
+        handle->ext->stats = stats;                      /* set stats */
+    }
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     estimate a reset
+ * @param[in] od overdrive speed flag
+ * @return    bus time in us
+ * @note      the presence pulse is taken at its longest
+ */
+static uint32_t a_ds2431_estimate_reset(uint8_t od)
+{
+    if (od != 0)                                                                              /* check speed */
+    {
+        return DS2431_TIME_RSTL_OD_US + DS2431_TIME_PRESENCE_OD_US + DS2431_TIME_POLL_US;     /* overdrive reset */
+    }
+    
+    return DS2431_TIME_RSTL_US + DS2431_TIME_PRESENCE_US + DS2431_TIME_POLL_US;               /* standard reset */
+}
+
+/**
+ * @brief     estimate a written byte
+ * @param[in] od overdrive speed flag
+ * @param[in] byte written byte
+ * @return    bus time in us
+ * @note      pass 0x00 for unknown data, a 0 bit is never shorter than a 1 bit
+ */
+static uint32_t a_ds2431_estimate_write(uint8_t od, uint8_t byte)
+{
+    uint8_t i;
+    uint32_t us;
+    
+    us = 0;                                                                        /* init 0 */
+    for (i = 0; i < 8; i++)                                                        /* 8 bits */
+    {
+        if (((byte >> i) & 0x01) != 0)                                             /* write 1 */
+        {
+            us += (od != 0) ? (DS2431_TIME_W1L_OD_US + DS2431_TIME_W0L_OD_US) :
+                              (DS2431_TIME_W1L_US + DS2431_TIME_W0L_US);           /* write 1 slot */
+        }
+        else                                                                       /* write 0 */
+        {
+            us += (od != 0) ? (DS2431_TIME_W0L_OD_US + DS2431_TIME_REC_OD_US) :
+                              (DS2431_TIME_W0L_US + DS2431_TIME_REC_US);           /* write 0 slot */
+        }
+    }
+    
+    return us;                                                                     /* return time */
+}
+
+/**
+ * @brief     estimate read bytes
+ * @param[in] od overdrive speed flag
+ * @param[in] len byte number
+ * @return    bus time in us
+ * @note      none
+ */
+static uint32_t a_ds2431_estimate_read(uint8_t od, uint32_t len)
+{
+    if (od != 0)                                                                  /* check speed */
+    {
+        return len * 8 * (DS2431_TIME_RL_OD_US + DS2431_TIME_RREC_OD_US);         /* overdrive slots */
+    }
+    
+    return len * 8 * (DS2431_TIME_RL_US + DS2431_TIME_MSR_US +
+                      DS2431_TIME_RREC_US);                                       /* standard slots */
+}
+
+/**
+ * @brief     check the data speed of a mode
+ * @param[in] mode chip mode
+ * @return    1 overdrive, 0 standard
+ * @note      none
+ */
+static uint8_t a_ds2431_estimate_od(uint8_t mode)
+{
+    if ((mode == DS2431_MODE_OVERDRIVE_SKIP_ROM) ||
+        (mode == DS2431_MODE_OVERDRIVE_MATCH_ROM) ||
+        (mode == DS2431_MODE_OVERDRIVE_RESUME))        /* check overdrive */
+    {
+        return 1;                                      /* overdrive */
+    }
+    
+    return 0;                                          /* standard */
+}
+
+/**
+ * @brief     estimate the reset and the rom function of a command
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] mode chip mode
+ * @param[in] again 1 for the copy step of a row write, when the chip already runs at the data speed
+ * @return    bus time in us
+ * @note      none
+ */
+static uint32_t a_ds2431_estimate_select(ds2431_handle_t *handle, uint8_t mode, uint8_t again)
+{
+    uint8_t i;
+    uint32_t us;
+    
+    if (mode == DS2431_MODE_SKIP_ROM)                                                     /* skip rom mode */
+    {
+        return a_ds2431_estimate_reset(0) +
+               a_ds2431_estimate_write(0, DS2431_CMD_SKIP_ROM);                           /* skip rom */
+    }
+    else if (mode == DS2431_MODE_OVERDRIVE_SKIP_ROM)                                      /* overdrive skip rom mode */
     {
-        return 3;                                                             /* return error */
+        return a_ds2431_estimate_reset(again) +
+               a_ds2431_estimate_write(again, DS2431_CMD_OVERDRIVE_SKIP_ROM);             /* overdrive skip rom */
     }
-    if ((address + len) > 0x80)                                               /* check address */
+    else if (mode == DS2431_MODE_MATCH_ROM)                                               /* match rom mode */
     {
-        handle->debug_print("ds2431: address and len are invalid.\n");        /* address and len are invalid */
+        us = a_ds2431_estimate_reset(0) +
+             a_ds2431_estimate_write(0, DS2431_CMD_MATCH_ROM);                            /* match rom */
+        for (i = 0; i < 8; i++)                                                           /* 8 bytes */
+        {
+            us += a_ds2431_estimate_write(0, handle->rom[i]);                             /* rom */
+        }
         
-        return 4;                                                             /* return error */
+        return us;                                                                        /* return time */
+    }
+    else if (mode == DS2431_MODE_OVERDRIVE_MATCH_ROM)                                     /* overdrive match rom mode */
+    {
+        if (again != 0)                                                                   /* check again */
+        {
+            return a_ds2431_estimate_reset(1) +
+                   a_ds2431_estimate_write(1, DS2431_CMD_OVERDRIVE_SKIP_ROM);             /* overdrive skip rom */
+        }
+        us = a_ds2431_estimate_reset(0) +
+             a_ds2431_estimate_write(0, DS2431_CMD_OVERDRIVE_MATCH_ROM);                  /* overdrive match rom */
+        for (i = 0; i < 8; i++)                                                           /* 8 bytes */
+        {
+            us += a_ds2431_estimate_write(1, handle->rom[i]);                             /* rom */
+        }
+        
+        return us;                                                                        /* return time */
+    }
+    else if (mode == DS2431_MODE_RESUME)                                                  /* resume mode */
+    {
+        return a_ds2431_estimate_reset(0) +
+               a_ds2431_estimate_write(0, DS2431_CMD_RESUME);                             /* resume */
+    }
+    else                                                                                  /* overdrive resume mode */
+    {
+        return a_ds2431_estimate_reset(1) +
+               a_ds2431_estimate_write(1, DS2431_CMD_RESUME);                             /* resume */
     }
+}
+
+/**
+ * @brief     estimate a read memory command
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] mode chip mode
+ * @param[in] address input address
+ * @param[in] len data length
+ * @return    bus time in us
+ * @note      none
+ */
+static uint32_t a_ds2431_estimate_read_memory(ds2431_handle_t *handle, uint8_t mode, uint16_t address, uint16_t len)
+{
+    uint8_t od;
     
-    res = a_ds2431_read(handle, address, data, len);                          /* read data */
-    if (res != 0)                                                             /* check the result */
+    od = a_ds2431_estimate_od(mode);                                             /* get speed */
+    
+    return a_ds2431_estimate_select(handle, mode, 0) +
+           a_ds2431_estimate_write(od, DS2431_CMD_READ_MEMORY) +
+           a_ds2431_estimate_write(od, (address >> 0) & 0xFF) +
+           a_ds2431_estimate_write(od, (address >> 8) & 0xFF) +
+           a_ds2431_estimate_read(od, len);                                      /* read memory */
+}
+
+/**
+ * @brief     estimate a row write
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] mode chip mode
+ * @param[in] address row address
+ * @return    bus time in us
+ * @note      write scratchpad, copy scratchpad, tPROG and the copy response
+ */
+static uint32_t a_ds2431_estimate_row(ds2431_handle_t *handle, uint8_t mode, uint16_t address)
+{
+    uint8_t od;
+    uint32_t us;
+    
+    od = a_ds2431_estimate_od(mode);                                             /* get speed */
+    us = a_ds2431_estimate_select(handle, mode, 0) +
+         a_ds2431_estimate_write(od, DS2431_CMD_WRITE_SCRATCHPAD) +
+         a_ds2431_estimate_write(od, (address >> 0) & 0xFF) +
+         a_ds2431_estimate_write(od, (address >> 8) & 0xFF) +
+         8 * a_ds2431_estimate_write(od, 0x00) +
+         a_ds2431_estimate_read(od, 3);                                          /* write scratchpad */
+    us += a_ds2431_estimate_select(handle, mode, 1) +
+          a_ds2431_estimate_write(od, DS2431_CMD_COPY_SCRATCHPAD) +
+          a_ds2431_estimate_write(od, (address >> 0) & 0xFF) +
+          a_ds2431_estimate_write(od, (address >> 8) & 0xFF) +
+          a_ds2431_estimate_write(od, 0x07);                                     /* copy scratchpad */
+    us += DS2431_TIME_PROG_MS * 1000 + a_ds2431_estimate_read(od, 1);            /* tPROG and the response */
+    
+    return us;                                                                   /* return time */
+}
+
+/**
+ * @brief     estimate a read that goes through the cache
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address input address
+ * @param[in] len data length
+ * @return    bus time in us
+ * @note      every run of missed rows is one read memory command, without a cache the range is one
+ */
+static uint32_t a_ds2431_estimate_fill(ds2431_handle_t *handle, uint16_t address, uint16_t len)
+{
+    uint8_t row;
+    uint8_t end;
+    uint32_t miss;
+    uint32_t us;
+    
+    if (a_ds2431_cache(handle) == NULL)                                                    /* check cache */
     {
-        return 1;                                                             /* return error */
+        return a_ds2431_estimate_read_memory(handle, handle->mode, address, len);          /* read the range */
+    }
+    us = 0;                                                                                /* init 0 */
+    miss = a_ds2431_cache_mask(address, len) & (~handle->ext->cache->valid);               /* get missed rows */
+    for (row = 0; row < DS2431_CACHE_ROW; row = end)                                       /* every run */
+    {
+        end = row + 1;                                                                     /* next row */
+        if ((miss & (1UL << row)) == 0)                                                    /* check miss */
+        {
+            continue;                                                                      /* hit */
+        }
+        while ((end < DS2431_CACHE_ROW) && ((miss & (1UL << end)) != 0))                   /* find the run end */
+        {
+            end++;                                                                         /* end++ */
+        }
+        us += a_ds2431_estimate_read_memory(handle, handle->mode, (uint16_t)(row * 8),
+                                            (uint16_t)((end - row) * 8));                  /* read the run */
     }
     
-    return 0;                                                                 /* success return 0 */
+    return us;                                                                             /* return time */
 }
 
 /**
- * @brief     write data
+ * @brief     estimate a ds2431_write
  * @param[in] *handle pointer to a ds2431 handle structure
  * @param[in] address input address
- * @param[in] *data pointer to a data buffer
  * @param[in] len data length
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 address and len are invalid
- * @note      none
+ * @return    bus time in us
+ * @note      pages count as eprom mode while the memory config is not loaded,
+ *            a handle without an extension never loads it and writes every page as open
  */
-uint8_t ds2431_write(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len)
+static uint32_t a_ds2431_estimate_write_range(ds2431_handle_t *handle, uint16_t address, uint16_t len)
 {
-    uint8_t res;
-    uint8_t i;
-    uint32_t pos;
-    uint32_t off;
-    uint32_t remain;
-    uint8_t buffer[8 + 1];
+    uint8_t eprom;
+    uint16_t pos;
+    uint16_t off;
+    uint16_t remain;
+    uint32_t us;
     
-    if (handle == NULL)                                                       /* check handle */
+    us = 0;                                                                                /* init 0 */
+    if (len == 0)                                                                          /* check length */
     {
-        return 2;                                                             /* return error */
+        return us;                                                                         /* no rows */
     }
-    if (handle->inited != 1)                                                  /* check handle initialization */
+    if ((handle->ext != NULL) && (handle->ext->config_valid == 0))                         /* check config */
     {
-        return 3;                                                             /* return error */
+        us += a_ds2431_estimate_read_memory(handle, handle->mode, 0x80, 8);                /* load config */
     }
-    if ((address + len) > 0x80)                                               /* check address */
+    if ((a_ds2431_cache(handle) != NULL) && (handle->ext->cache->write_back != 0))         /* check write back */
     {
-        handle->debug_print("ds2431: address and len are invalid.\n");        /* address and len are invalid */
+        if ((address % 8) != 0)                                                            /* partial first row */
+        {
+            us += a_ds2431_estimate_fill(handle, address, 1);                              /* fill row */
+        }
+        if ((((address + len) % 8) != 0) &&
+            (((address + len) / 8) != (address / 8) || ((address % 8) == 0)))            /* partial last row */
+        {
+            us += a_ds2431_estimate_fill(handle, address + len, 1);                        /* fill row */
+        }
         
-        return 4;                                                             /* return error */
+        return us;                                                                         /* the flush is separate */
+    }
+    pos = address / 8;                                                                     /* set pos */
+    off = address % 8;                                                                     /* set off */
+    remain = ((8 - off) < len) ? (8 - off) : len;                                          /* set remain */
+    while (len != 0)                                                                       /* every row */
+    {
+        eprom = (handle->ext != NULL) && ((handle->ext->config_valid == 0) ||
+                (a_ds2431_page_control(&handle->ext->config, (uint8_t)(pos / 4)) ==
+                 DS2431_CONFIG_EPROM_MODE));                                               /* check eprom mode */
+        if ((remain != 8) || (eprom != 0))                                                 /* check remain and eprom mode */
+        {
+            us += a_ds2431_estimate_fill(handle, pos * 8, 8);                              /* read row */
+        }
+        us += a_ds2431_estimate_row(handle, handle->mode, pos * 8);                        /* write row */
+        len -= remain;                                                                     /* len - remain */
+        pos++;                                                                             /* position++ */
+        remain = (len > 8) ? 8 : len;                                                      /* set remain */
+    }
+    if (a_ds2431_digest_on(handle) != 0)                                                   /* check digest */
+    {
+        us += a_ds2431_estimate_row(handle, handle->mode, handle->ext->digest_address);    /* bump digest */
     }
     
-    pos = address / 8;                                                        /* set pos */
-    off = address % 8;                                                        /* set off */
-    remain = 8 - off;                                                         /* set remain */
-    if (len <= remain)                                                        /* check length */
+    return us;                                                                             /* return time */
+}
+
+/**
+ * @brief     estimate a flush
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    bus time in us
+ * @note      match rom mode selects the chip once and resumes for the later rows
+ */
+static uint32_t a_ds2431_estimate_flush(ds2431_handle_t *handle)
+{
+    uint8_t row;
+    uint8_t mode;
+    uint32_t us;
+    
+    us = 0;                                                                    /* init 0 */
+    if ((a_ds2431_cache(handle) == NULL) ||
+        (handle->ext->cache->dirty == 0))                                      /* check dirty rows */
     {
-        remain = len;                                                         /* set remain */
+        return us;                                                             /* nothing to flush */
     }
-    while(1)                                                                  /* loop */
-    {    
-        if (remain != 8)                                                      /* check remain */
+    mode = handle->mode;                                                       /* get mode */
+    for (row = 0; row < 16; row++)                                             /* every memory row */
+    {
+        if ((handle->ext->cache->dirty & (1UL << row)) == 0)                   /* check dirty */
         {
-            res = a_ds2431_read(handle, pos * 8, buffer, 8);                  /* read data */
-            if (res != 0)                                                     /* check the result */
-            {
-                return 1;                                                     /* return error */
-            }
-            for (i = 0; i < remain; i++)                                      /* write remain */
-            {
-                buffer[i + off] = data[i];                                    /* copy data */
-            }
-            res = a_ds2431_write(handle, pos * 8, buffer);                    /* write data */
-            if (res != 0)                                                     /* check the result */
-            {
-                return 1;                                                     /* return error */
-            }
+            continue;                                                          /* skip */
         }
-        else
+        us += a_ds2431_estimate_row(handle, mode, row * 8);                    /* write row */
+        if (mode == DS2431_MODE_MATCH_ROM)                                     /* match rom */
         {
-            res = a_ds2431_write(handle, address, data);                      /* write data */
-            if (res != 0)                                                     /* check the result */
-            {
-                return 1;                                                     /* return error */
-            }
-        } 
-   
-        if (len == remain)                                                    /* check length length*/
+            mode = DS2431_MODE_RESUME;                                         /* resume the next rows */
+        }
+    }
+    if (a_ds2431_digest_on(handle) != 0)                                       /* check digest */
+    {
+        us += a_ds2431_estimate_row(handle, handle->mode,
+                                    handle->ext->digest_address);              /* bump digest */
+    }
+    
+    return us;                                                                 /* return time */
+}
+
+/**
+ * @brief      estimate the bus time of an api call
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  op operation id
+ * @param[in]  address input address
+ * @param[in]  len data length
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address and len are invalid
+ *             - 5 op is not supported
+ * @note       none
+ */
+uint8_t ds2431_estimate_us(ds2431_handle_t *handle, ds2431_stats_api_t op, uint16_t address, uint16_t len, uint32_t *us)
+{
+    uint8_t od;
+    
+    if (handle == NULL)                                                                            /* check handle */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    if ((address + len) > ((op == DS2431_STATS_API_WRITE_SCRATCHPAD) ||
+                           (op == DS2431_STATS_API_COPY_SCRATCHPAD) ? 0x90 : 0x80))                /* check address */
+    {
+        handle->ops->debug_print("ds2431: address and len are invalid.\n");                      /* address and len are invalid */
+        
+        return 4;                                                                                  /* return error */
+    }
+    
+    od = a_ds2431_estimate_od(handle->mode);                                                       /* get speed */
+    if ((op == DS2431_STATS_API_READ) || (op == DS2431_STATS_API_READ_MEMORY_CONFIG))              /* read through the cache */
+    {
+        *us = (op == DS2431_STATS_API_READ) ? a_ds2431_estimate_fill(handle, address, len) :
+              ((a_ds2431_cache(handle) != NULL) && (handle->ext->config_valid != 0)) ? 0 :
+              a_ds2431_estimate_read_memory(handle, handle->mode, 0x80, 8);                        /* fill */
+    }
+    else if (op == DS2431_STATS_API_READ_MEMORY)                                                   /* read memory */
+    {
+        *us = a_ds2431_estimate_read_memory(handle, handle->mode, address, len);                   /* read memory */
+    }
+    else if (op == DS2431_STATS_API_WRITE)                                                         /* write */
+    {
+        *us = a_ds2431_estimate_write_range(handle, address, len);                                 /* write range */
+    }
+    else if ((op == DS2431_STATS_API_WRITE_ROW) || (op == DS2431_STATS_API_WRITE_MEMORY_CONFIG))   /* row write */
+    {
+        if ((op == DS2431_STATS_API_WRITE_ROW) && ((address % 8) != 0))                            /* check row address */
         {
-            break;                                                            /* break loop */
+            handle->ops->debug_print("ds2431: address and len are invalid.\n");                  /* address and len are invalid */
+            
+            return 4;                                                                              /* return error */
         }
-        else
+        *us = (((handle->ext == NULL) && (op == DS2431_STATS_API_WRITE_MEMORY_CONFIG)) ||
+               ((handle->ext != NULL) && (handle->ext->config_valid == 0))) ?
+              a_ds2431_estimate_read_memory(handle, handle->mode, 0x80, 8) : 0;                    /* load config */
+        *us += a_ds2431_estimate_row(handle, handle->mode,
+                                     (op == DS2431_STATS_API_WRITE_ROW) ? address : 0x80);         /* write row */
+        if ((op == DS2431_STATS_API_WRITE_ROW) && (a_ds2431_digest_on(handle) != 0))               /* check digest */
         {
-            pos++;                                                            /* position++ */
-            off = 0;                                                          /* set offset */
-            data += remain;                                                   /* data + remain */
-            address += remain;                                                /* addr + remain */
-            len -= remain;                                                    /* len - remain */
-            if (len > 8)                                                      /* check length */
-            {
-                remain = 8;                                                   /* set 8 */
-            }
-            else
-            {
-                remain = len;                                                 /* set length */
-            }
+            *us += a_ds2431_estimate_row(handle, handle->mode, handle->ext->digest_address);       /* bump digest */
+        }
+    }
+    else if (op == DS2431_STATS_API_WRITE_SCRATCHPAD)                                              /* write scratchpad */
+    {
+        *us = a_ds2431_estimate_select(handle, handle->mode, 0) +
+              a_ds2431_estimate_write(od, DS2431_CMD_WRITE_SCRATCHPAD) +
+              a_ds2431_estimate_write(od, (address >> 0) & 0xFF) +
+              a_ds2431_estimate_write(od, (address >> 8) & 0xFF) +
+              8 * a_ds2431_estimate_write(od, 0x00) + a_ds2431_estimate_read(od, 3);               /* command, data and crc16 */
+    }
+    else if (op == DS2431_STATS_API_READ_SCRATCHPAD)                                               /* read scratchpad */
+    {
+        *us = a_ds2431_estimate_select(handle, handle->mode, 0) +
+              a_ds2431_estimate_write(od, DS2431_CMD_READ_SCRATCHPAD) +
+              a_ds2431_estimate_read(od, 14);                                                      /* command, data and crc16 */
+    }
+    else if (op == DS2431_STATS_API_COPY_SCRATCHPAD)                                               /* copy scratchpad */
+    {
+        *us = a_ds2431_estimate_select(handle, handle->mode, 0) +
+              a_ds2431_estimate_write(od, DS2431_CMD_COPY_SCRATCHPAD) +
+              a_ds2431_estimate_write(od, (address >> 0) & 0xFF) +
+              a_ds2431_estimate_write(od, (address >> 8) & 0xFF) +
+              a_ds2431_estimate_write(od, 0x07) +
+              DS2431_TIME_COPY_MS * 1000 + a_ds2431_estimate_read(od, 1);                          /* command, wait and response */
+        if ((address < 0x80) && (a_ds2431_digest_on(handle) != 0))                                 /* check digest */
+        {
+            *us += a_ds2431_estimate_row(handle, handle->mode, handle->ext->digest_address);       /* bump digest */
         }
     }
+    else if (op == DS2431_STATS_API_FLUSH)                                                         /* flush */
+    {
+        *us = a_ds2431_estimate_flush(handle);                                                     /* flush */
+    }
+    else
+    {
+        handle->ops->debug_print("ds2431: op is not supported.\n");                              /* op is not supported */
+        
+        return 5;                                                                                  /* return error */
+    }
     
-    return 0;                                                                 /* success return 0 */
+    return 0;                                                                                      /* success return 0 */
 }
 
 /**
@@ -4041,7 +6611,7 @@ uint8_t ds2431_write(ds2431_handle_t *handle, uint8_t address, uint8_t *data, ui
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t rom[8])
+static uint8_t a_ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t rom[8])
 {
     uint8_t i;
     
@@ -4058,13 +6628,13 @@ uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t ro
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_MATCH_ROM) != 0)            /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -4072,7 +6642,7 @@ uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t ro
         {
             if (a_ds2431_write_byte(handle, rom[i]) != 0)                      /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -4080,7 +6650,7 @@ uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t ro
         
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
@@ -4089,13 +6659,13 @@ uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t ro
     {
         if (a_ds2431_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
         if (a_ds2431_write_byte(handle, DS2431_CMD_OVERDRIVE_MATCH_ROM) != 0)  /* write match rom command */
         {
-            handle->debug_print("ds2431: write command failed.\n");            /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");       /* write command failed */
             
             return 1;                                                          /* return error */
         }    
@@ -4103,7 +6673,7 @@ uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t ro
         {
             if (a_ds2431_write_byte_overdrive(handle, rom[i]) != 0)            /* send rom */
             {
-                handle->debug_print("ds2431: write command failed.\n");        /* write command */
+                handle->ops->debug_print("ds2431: write command failed.\n");   /* write command */
                 
                 return 1;                                                      /* return error */
             }
@@ -4111,7 +6681,7 @@ uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t ro
         
         if (a_ds2431_reset_overdrive(handle) != 0)                             /* reset bus */
         {
-            handle->debug_print("ds2431: bus reset failed.\n");                /* bus reset failed */
+            handle->ops->debug_print("ds2431: bus reset failed.\n");           /* bus reset failed */
             
             return 1;                                                          /* return error */
         }
@@ -4120,6 +6690,41 @@ uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t ro
     return 0;                                                                  /* success return 0 */
 }
 
+/**
+ * @brief     run rom match
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] type match type
+ * @param[in] *rom pointer to a rom buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 match failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t rom[8])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    if (a_ds2431_lock(handle, DS2431_STATS_API_ROM_MATCH) != 0)        /* lock bus */
+    {
+        return 1;                                                      /* return error */
+    }
+    res = a_ds2431_rom_match(handle, type, rom);                       /* run rom match */
+    a_ds2431_unlock(handle, res);                                      /* unlock bus */
+    
+    return res;                                                        /* return the result */
+}
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to a ds2431 handle structure
@@ -4133,76 +6738,98 @@ uint8_t ds2431_rom_match(ds2431_handle_t *handle, ds2431_type_t type, uint8_t ro
  */
 uint8_t ds2431_init(ds2431_handle_t *handle)
 {
+    uint8_t res;
+    
     if (handle == NULL)                                                /* check handle */
     {
         return 2;                                                      /* return error */
     }
-    if (handle->debug_print == NULL)                                   /* check debug_print */
+    if (handle->ops == NULL)                                           /* check ops */
+    {
+        return 3;                                                      /* return error */
+    }
+    if (handle->ops->debug_print == NULL)                              /* check debug_print */
     {
         return 3;                                                      /* return error */
     }
-    if (handle->bus_init == NULL)                                      /* check bus_init */
+    if (handle->ops->bus_init == NULL)                                 /* check bus_init */
     {
-        handle->debug_print("ds2431: bus_init is null.\n");            /* bus_init is null */
+        handle->ops->debug_print("ds2431: bus_init is null.\n");       /* bus_init is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->bus_deinit == NULL)                                    /* check bus_deinit */
+    if (handle->ops->bus_deinit == NULL)                               /* check bus_deinit */
     {
-        handle->debug_print("ds2431: bus_deinit is null.\n");          /* bus_read is null */
+        handle->ops->debug_print("ds2431: bus_deinit is null.\n");     /* bus_read is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->bus_read == NULL)                                      /* check bus_read */
+    if (handle->ops->bus_read == NULL)                                 /* check bus_read */
     {
-        handle->debug_print("ds2431: bus_read is null.\n");            /* bus_read is null */
+        handle->ops->debug_print("ds2431: bus_read is null.\n");       /* bus_read is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->bus_write == NULL)                                     /* check bus_write */
+    if (handle->ops->bus_write == NULL)                                /* check bus_write */
     {
-        handle->debug_print("ds2431: bus_write is null.\n");           /* bus_write is null */
+        handle->ops->debug_print("ds2431: bus_write is null.\n");      /* bus_write is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->delay_ms == NULL)                                      /* check delay_ms */
+    if (handle->ops->delay_ms == NULL)                                 /* check delay_ms */
     {
-        handle->debug_print("ds2431: delay_ms is null.\n");            /* delay_ms is null */
+        handle->ops->debug_print("ds2431: delay_ms is null.\n");       /* delay_ms is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->delay_us == NULL)                                      /* check delay_us */
+    if (handle->ops->delay_us == NULL)                                 /* check delay_us */
     {
-        handle->debug_print("ds2431: delay_us is null.\n");            /* delay_us is null */
-       
+        handle->ops->debug_print("ds2431: delay_us is null.\n");       /* delay_us is null */
+        
+        return 3;                                                      /* return error */
+    }
+    if (handle->ops->enable_irq == NULL)                               /* check enable_irq */
+    {
+        handle->ops->debug_print("ds2431: enable_irq is null.\n");     /* enable_irq is null */
+        
         return 3;                                                      /* return error */
     }
-    if (handle->enable_irq == NULL)                                    /* check enable_irq */
+    if (handle->ops->disable_irq == NULL)                              /* check disable_irq */
     {
-        handle->debug_print("ds2431: enable_irq is null.\n");          /* enable_irq is null */
+        handle->ops->debug_print("ds2431: disable_irq is null.\n");    /* disable_irq is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->disable_irq == NULL)                                   /* check disable_irq */
+    if ((handle->ops->lock == NULL) != (handle->ops->unlock == NULL))  /* check lock and unlock */
     {
-        handle->debug_print("ds2431: disable_irq is null.\n");         /* disable_irq is null */
+        handle->ops->debug_print("ds2431: lock and unlock are not paired.\n");
         
         return 3;                                                      /* return error */
     }
     
-    if (handle->bus_init() != 0)                                       /* initialize bus */
+    if (handle->ops->bus_init(handle->user) != 0)                      /* initialize bus */
+    {
+        handle->ops->debug_print("ds2431: bus init failed.\n");        /* bus innit failed */
+        
+        return 1;                                                      /* return error */
+    }
+    if (a_ds2431_lock(handle, DS2431_STATS_API_INIT) != 0)             /* lock bus */
     {
-        handle->debug_print("ds2431: bus init failed.\n");             /* bus innit failed */
+        (void)handle->ops->bus_deinit(handle->user);                   /* close bus */
         
         return 1;                                                      /* return error */
     }
-    if (a_ds2431_reset(handle) != 0)                                   /* reset chip */
+    res = a_ds2431_reset(handle);                                      /* reset chip */
+    a_ds2431_unlock(handle, res);                                      /* unlock bus */
+    if (res != 0)                                                      /* check the result */
     {
-        handle->debug_print("ds2431: reset failed.\n");                /* reset chip failed */
-        (void)handle->bus_deinit();                                    /* close bus */
+        handle->ops->debug_print("ds2431: reset failed.\n");           /* reset chip failed */
+        (void)handle->ops->bus_deinit(handle->user);                   /* close bus */
         
         return 4;                                                      /* return error */
     }
+    a_ds2431_select_drop(handle);                                      /* drop the device state, the config is loaded on the first write */
+    handle->row_pending = 0;                                           /* no pending row */
     handle->inited = 1;                                                /* flag finish initialization */
     
     return 0;                                                          /* success return 0 */
@@ -4229,9 +6856,9 @@ uint8_t ds2431_deinit(ds2431_handle_t *handle)
         return 3;                                                /* return error */
     }
     
-    if (handle->bus_deinit() != 0)                               /* close bus */
+    if (handle->ops->bus_deinit(handle->user) != 0)              /* close bus */
     {
-        handle->debug_print("ds2431: deinit failed.\n");         /* deinit failed */
+        handle->ops->debug_print("ds2431: deinit failed.\n");    /* deinit failed */
         
         return 1;                                                /* return error */
     }   
@@ -4253,22 +6880,25 @@ static uint8_t a_ds2431_read_2bit(ds2431_handle_t *handle, uint8_t *data)
 {
     uint8_t i;
     uint8_t res;
+    uint32_t us;
     
+    us = a_ds2431_trace_us(handle);                                     /* trace start */
     *data = 0;                                                          /* reset data */
-    handle->disable_irq();                                              /* disable irq */
+    a_ds2431_disable_irq(handle);                                       /* disable irq */
     for (i = 0; i < 2; i++)                                             /* read 2 bit */
     {
         *data <<= 1;                                                    /* left shift 1 */
         if (a_ds2431_read_bit(handle, (uint8_t *)&res) != 0)            /* read one bit */
         {
-            handle->enable_irq();                                       /* enable irq */
-            handle->debug_print("ds2431: read bit failed.\n");          /* read a bit failed */
+            a_ds2431_enable_irq(handle);                                /* enable irq */
+            handle->ops->debug_print("ds2431: read bit failed.\n");     /* read a bit failed */
             
             return 1;                                                   /* return error */
         }
         *data = (*data) | res;                                          /* get 1 bit */
     }
-    handle->enable_irq();                                               /* enable irq */
+    a_ds2431_trace(handle, DS2431_TRACE_READ_2BIT, *data, us);          /* trace bits */
+    a_ds2431_enable_irq(handle);                                        /* enable irq */
     
     return 0;                                                           /* success return 0 */
 }
@@ -4280,38 +6910,36 @@ static uint8_t a_ds2431_read_2bit(ds2431_handle_t *handle, uint8_t *data)
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the slot is the one a_ds2431_write_byte uses for the same bit
  */
 static uint8_t a_ds2431_write_bit(ds2431_handle_t *handle, uint8_t bit)
-{    
-    handle->disable_irq();                                          /* disable irq */
-    if (handle->bus_write(0) != 0)                                  /* write 0 */
+{
+    uint32_t us;
+    
+    us = a_ds2431_trace_us(handle);                                              /* trace start */
+    a_ds2431_disable_irq(handle);                                                /* disable irq */
+    if (handle->ops->bus_write(handle->user, 0) != 0)                            /* write 0 */
     {
-        handle->enable_irq();                                       /* enable irq */
-        handle->debug_print("ds2431: write bit failed.\n");         /* write bit failed */
+        a_ds2431_enable_irq(handle);                                             /* enable irq */
+        handle->ops->debug_print("ds2431: write bit failed.\n");                 /* write bit failed */
         
-        return 1;                                                   /* return error */
+        return 1;                                                                /* return error */
     }
-    handle->delay_us(12);                                           /* wait 12 us */
-    if (handle->bus_write(bit) != 0)                                /* write bit */
-    {
-        handle->enable_irq();                                       /* enable irq */
-        handle->debug_print("ds2431: write bit failed.\n");         /* write bit failed */
-        
-        return 1;                                                   /* return error */
-    } 
-    handle->delay_us(30);                                           /* wait 30 us */
-    if (handle->bus_write(1) != 0)                                  /* write 1 */
+    handle->ops->delay_us(handle->user, (bit != 0) ? DS2431_TIME_W1L_US :
+                                                     DS2431_TIME_W0L_US);        /* wait 6 us or 65 us */
+    if (handle->ops->bus_write(handle->user, 1) != 0)                            /* write 1 */
     {
-        handle->enable_irq();                                       /* enable irq */
-        handle->debug_print("ds2431: write bit failed.\n");         /* write bit failed */
+        a_ds2431_enable_irq(handle);                                             /* enable irq */
+        handle->ops->debug_print("ds2431: write bit failed.\n");                 /* write bit failed */
         
-        return 1;                                                   /* return error */
+        return 1;                                                                /* return error */
     }
-    handle->delay_us(5);                                            /* wait 5 us */
-    handle->enable_irq();                                           /* enable irq */
+    handle->ops->delay_us(handle->user, (bit != 0) ? DS2431_TIME_W0L_US :
+                                                     DS2431_TIME_REC_US);        /* wait 65 us or 6 us */
+    a_ds2431_trace(handle, DS2431_TRACE_WRITE_BIT, bit, us);                     /* trace bit */
+    a_ds2431_enable_irq(handle);                                                 /* enable irq */
     
-    return 0;                                                       /* success return 0 */
+    return 0;                                                                    /* success return 0 */
 }
 
 /**
@@ -4323,35 +6951,40 @@ static uint8_t a_ds2431_write_bit(ds2431_handle_t *handle, uint8_t bit)
  * @return        status code
  *                - 0 success
  *                - 1 search failed
- * @note          none
+ * @note          the conflict stack holds at most one entry per rom bit plus the bottom,
+ *                whatever the array size is
  */
 static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8_t cmd, uint8_t *number)
 {     
     uint8_t k, l = 0, conflict_bit, m, n;
-    uint8_t buffer[DS2431_MAX_SEARCH_SIZE];
+    uint8_t buffer[65];
     uint8_t ss[64];
     uint8_t s = 0;
     uint8_t num = 0;
     
     if ((*number) > DS2431_MAX_SEARCH_SIZE)                                               /* check number */
     {
-        handle->debug_print("ds2431: number is over DS2431_MAX_SEARCH_SIZE.\n");          /* number is over */
+        handle->ops->debug_print("ds2431: number is over DS2431_MAX_SEARCH_SIZE.\n");     /* number is over */
         
         return 1;                                                                         /* return error */
     }
-    memset((uint8_t *)buffer, 0, DS2431_MAX_SEARCH_SIZE);                                 /* clear buffer */
+    if ((*number) == 0)                                                                   /* check number */
+    {
+        return 0;                                                                         /* nothing to find */
+    }
+    memset((uint8_t *)buffer, 0, sizeof(uint8_t) * 65);                                   /* clear buffer */
     memset((uint8_t *)ss, 0, sizeof(uint8_t) * 64);                                       /* clear buffer */
     do
     {
         if (a_ds2431_reset(handle) != 0)                                                  /* reset bus */
         {
-            handle->debug_print("ds2431: reset failed.\n");                               /* reset bus failed */
+            handle->ops->debug_print("ds2431: reset failed.\n");                          /* reset bus failed */
             
             return 1;                                                                     /* return error */
         }
         if (a_ds2431_write_byte(handle, cmd) != 0)                                        /* write 1 byte */
         {
-            handle->debug_print("ds2431: write command failed.\n");                       /* write command failed */
+            handle->ops->debug_print("ds2431: write command failed.\n");                  /* write command failed */
             
             return 1;                                                                     /* return error */
         }
@@ -4361,7 +6994,7 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
             {
                 if (a_ds2431_read_2bit(handle, (uint8_t *)&k) != 0)                       /* read 2 bit */
                 {
-                    handle->debug_print("ds2431: read 2bit failed.\n");                   /* read 2 bit failed */
+                    handle->ops->debug_print("ds2431: read 2bit failed.\n");              /* read 2 bit failed */
                     
                     return 1;                                                             /* return error */
                 }
@@ -4371,7 +7004,7 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
                 {
                     if (a_ds2431_write_bit(handle, 0) != 0)                               /* write 0 */
                     {
-                        handle->debug_print("ds2431: write bit failed.\n");               /* write bit failed */
+                        handle->ops->debug_print("ds2431: write bit failed.\n");          /* write bit failed */
                         
                         return 1;                                                         /* return error */
                     }
@@ -4382,7 +7015,7 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
                     s = s | 0x80;                                                         /* set 7 bit */
                     if (a_ds2431_write_bit(handle, 1) != 0)                               /* write 1 */
                     {
-                        handle->debug_print("ds2431: write bit failed.\n");               /* write bit failed */
+                        handle->ops->debug_print("ds2431: write bit failed.\n");          /* write bit failed */
                         
                         return 1;                                                         /* return error */
                     }
@@ -4395,7 +7028,7 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
                     {
                         if (a_ds2431_write_bit(handle, 0) != 0)                           /* write 0 */
                         {
-                            handle->debug_print("ds2431: write bit failed.\n");           /* write bit failed */
+                            handle->ops->debug_print("ds2431: write bit failed.\n");      /* write bit failed */
                             
                             return 1;                                                     /* return error */
                         }
@@ -4407,7 +7040,7 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
                         s = s|((ss[(m * 8 + n)] & 0x01) << 7);                            /* get s */
                         if (a_ds2431_write_bit(handle, ss[(m*8+n)]) != 0)                 /* write data */
                         {
-                            handle->debug_print("ds2431: write bit failed.\n");           /* write bit failed */
+                            handle->ops->debug_print("ds2431: write bit failed.\n");      /* write bit failed */
                             
                             return 1;                                                     /* return error */
                         }
@@ -4417,7 +7050,7 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
                         s = s | 0x80;                                                     /* set 7 bit */
                         if (a_ds2431_write_bit(handle, 1) != 0)                           /* write 1 */
                         {
-                            handle->debug_print("ds2431: write bit failed.\n");           /* write bit failed */
+                            handle->ops->debug_print("ds2431: write bit failed.\n");      /* write bit failed */
                             
                             return 1;                                                     /* return error */
                         }
@@ -4426,7 +7059,7 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
                     }
                     else
                     {
-                        
+                    
                     }
                 }
                 else
@@ -4435,13 +7068,12 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
                     
                     return 0;                                                             /* success return 0 */
                 }
-                handle->delay_us(5);                                                      /* delay 5 us */
             }
             pid[num][m] = s;                                                              /* save s */
             s = 0;                                                                        /* reset s */
         }
         num++;                                                                            /* num++ */
-        if (num > (*number))                                                              /* check num range */
+        if (num >= (*number))                                                             /* check num range */
         {
             break;                                                                        /* break */
         }
@@ -4463,6 +7095,8 @@ static uint8_t a_ds2431_search(ds2431_handle_t *handle, uint8_t (*pid)[8], uint8
  */
 uint8_t ds2431_search_rom(ds2431_handle_t *handle, uint8_t (*rom)[8], uint8_t *num)
 {
+    uint8_t res;
+    
     if (handle == NULL)                                                    /* check handle */
     {
         return 2;                                                          /* return error */
@@ -4472,7 +7106,34 @@ uint8_t ds2431_search_rom(ds2431_handle_t *handle, uint8_t (*rom)[8], uint8_t *n
         return 3;                                                          /* return error */
     }
     
-    return a_ds2431_search(handle, rom, DS2431_CMD_SEARCH_ROM, num);       /* return search result */
+    if (a_ds2431_lock(handle, DS2431_STATS_API_SEARCH_ROM) != 0)           /* lock bus */
+    {
+        return 1;                                                          /* return error */
+    }
+    res = a_ds2431_search(handle, rom, DS2431_CMD_SEARCH_ROM, num);        /* search rom */
+    a_ds2431_unlock(handle, res);                                          /* unlock bus */
+    
+    return res;                                                            /* return search result */
+}
+
+/**
+ * @brief     calculate the 1-wire crc16
+ * @param[in] crc initial crc16
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    updated crc16
+ * @note      polynomial x^16 + x^15 + x^2 + 1, not inverted, start with 0
+ */
+uint16_t ds2431_crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; i < len; i++)                              /* all bytes */
+    {
+        crc = a_ds2431_crc16_update(crc, data[i]);         /* update crc16 */
+    }
+    
+    return crc;                                            /* return crc16 */
 }
 
 /**
@@ -63,6 +63,66 @@ extern "C"{
     #define DS2431_MAX_SEARCH_SIZE        64        /**< max 64 devices */
 #endif
 
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup ds2431_trace_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 trace size definition
+ */
+#ifndef DS2431_TRACE_SIZE
+    #define DS2431_TRACE_SIZE        256        /**< 256 events, must be a power of 2 */
+#endif
+#if ((DS2431_TRACE_SIZE & (DS2431_TRACE_SIZE - 1)) != 0)
+    #error "DS2431_TRACE_SIZE must be a power of 2"
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup ds2431_stats_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 stats bins definition
+ */
+#ifndef DS2431_STATS_BINS
+    #define DS2431_STATS_BINS        24        /**< bin 0 is 0 us, bin n is 2^(n-1) to 2^n - 1 us, the last bin is open */
+#endif
+
+/**
+ * @brief ds2431 timing definition
+ * @note  shared by the driver modules so every bus waveform uses the same slot timings
+ */
+#define DS2431_TIME_RSTL_US            550        /**< reset low time */
+#define DS2431_TIME_MSP_US             15         /**< wait before the presence poll */
+#define DS2431_TIME_PRESENCE_US        300        /**< longest presence end after the release, tPDH + tPDL max */
+#define DS2431_TIME_W1L_US             6          /**< write 1 low time */
+#define DS2431_TIME_W0L_US             65         /**< write 0 low time, also the rest of a write 1 slot */
+#define DS2431_TIME_REC_US             6          /**< write 0 recovery time */
+#define DS2431_TIME_RL_US              6          /**< read low time */
+#define DS2431_TIME_MSR_US             6          /**< read sample time */
+#define DS2431_TIME_RREC_US            50         /**< rest of a read slot */
+#define DS2431_TIME_RSTL_OD_US         70         /**< overdrive reset low time */
+#define DS2431_TIME_MSP_OD_US          2          /**< overdrive wait before the presence poll */
+#define DS2431_TIME_PRESENCE_OD_US     30         /**< overdrive longest presence end after the release */
+#define DS2431_TIME_W1L_OD_US          1          /**< overdrive write 1 low time */
+#define DS2431_TIME_W0L_OD_US          10         /**< overdrive write 0 low time, also the rest of a write 1 slot */
+#define DS2431_TIME_REC_OD_US          2          /**< overdrive write 0 recovery time */
+#define DS2431_TIME_RL_OD_US           1          /**< overdrive read low time */
+#define DS2431_TIME_RREC_OD_US         10         /**< overdrive rest of a read slot */
+#define DS2431_TIME_POLL_US            1          /**< presence poll step */
+#define DS2431_TIME_COPY_MS            15         /**< copy scratchpad wait */
+#define DS2431_TIME_PROG_MS            10         /**< row write tPROG wait */
+
 /**
  * @}
  */
@@ -72,6 +132,15 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief ds2431 bool enumeration definition
+ */
+typedef enum
+{
+    DS2431_BOOL_FALSE = 0x00,        /**< false */
+    DS2431_BOOL_TRUE  = 0x01,        /**< true */
+} ds2431_bool_t;
+
 /**
  * @brief ds2431 mode enumeration definition
  */
@@ -118,23 +187,180 @@ typedef struct ds2431_config_control_s
     uint8_t user_byte_1;                     /**< user byte 1 */
 } ds2431_config_control_t;
 
+/**
+ * @brief ds2431 cache size definition
+ */
+#define DS2431_CACHE_SIZE        128        /**< 0x00 - 0x7F, data memory */
+#define DS2431_CACHE_ROW         16         /**< 8 bytes per row */
+
+/**
+ * @brief ds2431 cache structure definition
+ */
+typedef struct ds2431_cache_s
+{
+    uint8_t image[DS2431_CACHE_SIZE];        /**< shadow image of the device */
+    uint32_t valid;                          /**< bit n is set if row n is valid */
+    uint32_t dirty;                          /**< bit n is set if row n is newer than the chip */
+    uint8_t write_back;                      /**< write back enable */
+    uint8_t count;                           /**< writes since the last flush */
+    uint8_t flush_count;                     /**< auto flush write count, 0 is disabled */
+    uint32_t flush_us;                       /**< auto flush age in us, 0 is disabled */
+    uint32_t dirty_us;                       /**< timestamp of the oldest dirty row */
+} ds2431_cache_t;
+
+/**
+ * @brief ds2431 trace event enumeration definition
+ */
+typedef enum
+{
+    DS2431_TRACE_RESET           = 0x01,        /**< standard reset, data is 0 with a presence pulse and 1 without */
+    DS2431_TRACE_RESET_OVERDRIVE = 0x02,        /**< overdrive reset, data is 0 with a presence pulse and 1 without */
+    DS2431_TRACE_WRITE           = 0x03,        /**< standard byte write, data is the byte */
+    DS2431_TRACE_WRITE_OVERDRIVE = 0x04,        /**< overdrive byte write, data is the byte */
+    DS2431_TRACE_READ            = 0x05,        /**< standard byte read, data is the byte */
+    DS2431_TRACE_READ_OVERDRIVE  = 0x06,        /**< overdrive byte read, data is the byte */
+    DS2431_TRACE_WRITE_BIT       = 0x07,        /**< search direction write, data is the bit */
+    DS2431_TRACE_READ_2BIT       = 0x08,        /**< search read, data is the bit << 1 | the complement */
+    DS2431_TRACE_CRC             = 0x09,        /**< crc16 check, data is 0 if it passed and 1 if it failed */
+} ds2431_trace_event_t;
+
+/**
+ * @brief ds2431 trace event packing definition
+ * @note  bit 31 - 28 is the event, bit 27 - 20 the data and bit 19 - 0 the timestamp_us
+ *        at the start of the event, it wraps around every 1.048576 s
+ */
+#define DS2431_TRACE_PACK(EVENT, DATA, US)        (((uint32_t)(EVENT) << 28) | ((uint32_t)(DATA) << 20) | \
+                                                   ((uint32_t)(US) & 0xFFFFFUL))
+#define DS2431_TRACE_GET_EVENT(WORD)              ((uint8_t)(((WORD) >> 28) & 0x0F))
+#define DS2431_TRACE_GET_DATA(WORD)               ((uint8_t)(((WORD) >> 20) & 0xFF))
+#define DS2431_TRACE_GET_US(WORD)                 ((uint32_t)(WORD) & 0xFFFFFUL)
+
+/**
+ * @brief ds2431 trace structure definition
+ */
+typedef struct ds2431_trace_s
+{
+    uint32_t event[DS2431_TRACE_SIZE];        /**< event ring */
+    uint32_t head;                            /**< events recorded */
+    uint32_t tail;                            /**< events taken by ds2431_trace_read */
+} ds2431_trace_t;
+
+/**
+ * @brief ds2431 stats api enumeration definition
+ * @note  also the operation id of a transaction
+ */
+typedef enum
+{
+    DS2431_STATS_API_INIT                = 0x00,        /**< ds2431_init */
+    DS2431_STATS_API_READ                = 0x01,        /**< ds2431_read */
+    DS2431_STATS_API_WRITE               = 0x02,        /**< ds2431_write, one sample per row */
+    DS2431_STATS_API_READ_MEMORY         = 0x03,        /**< ds2431_read_memory */
+    DS2431_STATS_API_WRITE_SCRATCHPAD    = 0x04,        /**< ds2431_write_scratchpad */
+    DS2431_STATS_API_READ_SCRATCHPAD     = 0x05,        /**< ds2431_read_scratchpad */
+    DS2431_STATS_API_COPY_SCRATCHPAD     = 0x06,        /**< ds2431_copy_scratchpad */
+    DS2431_STATS_API_READ_MEMORY_CONFIG  = 0x07,        /**< ds2431_read_memory_config */
+    DS2431_STATS_API_WRITE_MEMORY_CONFIG = 0x08,        /**< ds2431_write_memory_config */
+    DS2431_STATS_API_WRITE_ROW           = 0x09,        /**< ds2431_write_row_start to ds2431_write_row_finish */
+    DS2431_STATS_API_SEARCH_ROM          = 0x0A,        /**< ds2431_search_rom */
+    DS2431_STATS_API_ROM_MATCH           = 0x0B,        /**< ds2431_rom_match */
+    DS2431_STATS_API_CACHE_REFRESH       = 0x0C,        /**< ds2431_cache_refresh */
+    DS2431_STATS_API_FLUSH               = 0x0D,        /**< ds2431_flush and ds2431_write_back_poll */
+    DS2431_STATS_API_SET_DIGEST          = 0x0E,        /**< ds2431_set_digest */
+    DS2431_STATS_API_IS_CHANGED          = 0x0F,        /**< ds2431_is_changed */
+    DS2431_STATS_API_GET_ROM             = 0x10,        /**< ds2431_get_rom */
+    DS2431_STATS_API_NUM                 = 0x11,        /**< api number */
+} ds2431_stats_api_t;
+
+/**
+ * @brief ds2431 stats structure definition
+ */
+typedef struct ds2431_stats_s
+{
+    uint32_t reset;                                                     /**< resets */
+    uint32_t presence_fail;                                             /**< resets without a presence pulse */
+    uint32_t byte_write;                                                /**< bytes written */
+    uint32_t byte_read;                                                 /**< bytes read */
+    uint32_t bit_write;                                                 /**< write slots, search bits included */
+    uint32_t bit_read;                                                  /**< read slots, search bits included */
+    uint32_t crc_error;                                                 /**< crc16 errors */
+    uint32_t prog_wait;                                                 /**< tPROG waits */
+    uint32_t prog_ms;                                                   /**< total tPROG wait time in ms */
+    uint32_t irq_off_us;                                                /**< total irq off time in us */
+    uint32_t irq_max_us;                                                /**< longest irq off window in us */
+    uint32_t total_us[DS2431_STATS_API_NUM];                            /**< total bus hold time per api in us */
+    uint32_t histogram[DS2431_STATS_API_NUM][DS2431_STATS_BINS];        /**< bus hold time histogram per api */
+} ds2431_stats_t;
+
+/**
+ * @brief ds2431 transaction structure definition
+ */
+typedef struct ds2431_transaction_s
+{
+    uint8_t op;                /**< operation id, a ds2431_stats_api_t */
+    uint8_t mode;              /**< chip mode */
+    uint8_t rom[8];            /**< target rom, used by the match modes */
+    uint32_t byte_write;       /**< bytes written, counted until the end */
+    uint32_t byte_read;        /**< bytes read, counted until the end */
+    uint8_t result;            /**< status code, set at the end */
+} ds2431_transaction_t;
+
+/**
+ * @brief ds2431 extension structure definition
+ * @note  optional per-device state owned by the caller and linked with ds2431_set_extension,
+ *        a handle without one runs the plain driver and keeps only the rom, the mode and the flags
+ */
+typedef struct ds2431_extension_s
+{
+    ds2431_cache_t *cache;                 /**< optional shadow cache */
+    ds2431_trace_t *trace;                 /**< optional bus trace */
+    ds2431_stats_t *stats;                 /**< optional performance counters */
+    uint32_t generation;                   /**< last known generation of the digest row */
+    ds2431_transaction_t transaction;      /**< current transaction */
+    ds2431_config_control_t config;        /**< cached memory config, the only copy of the config row */
+    uint8_t config_valid;                  /**< cached memory config valid flag */
+    uint8_t digest;                        /**< digest enable */
+    uint8_t digest_address;                /**< digest row address */
+    uint32_t irq_start_us;                 /**< start of the current irq off window */
+    uint32_t hold_start_us;                /**< start of the current bus hold */
+    uint8_t hold_api;                      /**< api of the current bus hold */
+} ds2431_extension_t;
+
+/**
+ * @brief ds2431 ops structure definition
+ * @note  the ops table holds no per-device state, so one const table can
+ *        be placed in flash and shared by every handle on every bus,
+ *        the transaction hooks only run for handles with an extension
+ */
+typedef struct ds2431_ops_s
+{
+    uint8_t (*bus_init)(void *user);                                                          /**< point to a bus_init function address */
+    uint8_t (*bus_deinit)(void *user);                                                        /**< point to a bus_deinit function address */
+    uint8_t (*bus_read)(void *user, uint8_t *value);                                          /**< point to a bus_read function address */
+    uint8_t (*bus_write)(void *user, uint8_t value);                                          /**< point to a bus_write function address */
+    void (*delay_ms)(void *user, uint32_t ms);                                                /**< point to a delay_ms function address */
+    void (*delay_us)(void *user, uint32_t us);                                                /**< point to a delay_us function address */
+    void (*enable_irq)(void *user);                                                           /**< point to an enable_irq function address */
+    void (*disable_irq)(void *user);                                                          /**< point to a disable_irq function address */
+    void (*debug_print)(const char *const fmt, ...);                                          /**< point to a debug_print function address */
+    uint32_t (*timestamp_us)(void *user);                                                     /**< point to an optional timestamp_us function address */
+    uint8_t (*lock)(void *user);                                                              /**< point to an optional lock function address */
+    void (*unlock)(void *user);                                                               /**< point to an optional unlock function address */
+    void (*on_transaction_begin)(void *user, const ds2431_transaction_t *transaction);        /**< point to an optional on_transaction_begin function address */
+    void (*on_transaction_end)(void *user, const ds2431_transaction_t *transaction);          /**< point to an optional on_transaction_end function address */
+} ds2431_ops_t;
+
 /**
  * @brief ds2431 handle structure definition
  */
 typedef struct ds2431_handle_s
 {
-    uint8_t (*bus_init)(void);                              /**< point to a bus_init function address */
-    uint8_t (*bus_deinit)(void);                            /**< point to a bus_deinit function address */
-    uint8_t (*bus_read)(uint8_t *value);                    /**< point to a bus_read function address */
-    uint8_t (*bus_write)(uint8_t value);                    /**< point to a bus_write function address */
-    void (*delay_ms)(uint32_t ms);                          /**< point to a delay_ms function address */
-    void (*delay_us)(uint32_t us);                          /**< point to a delay_us function address */
-    void (*enable_irq)(void);                               /**< point to an enable_irq function address */
-    void (*disable_irq)(void);                              /**< point to a disable_irq function address */
-    void (*debug_print)(const char *const fmt, ...);        /**< point to a debug_print function address */
-    uint8_t inited;                                         /**< inited flag */
-    uint8_t mode;                                           /**< chip mode */
-    uint8_t rom[8];                                         /**< chip mode */
+    const ds2431_ops_t *ops;        /**< point to a shared ops table */
+    void *user;                     /**< user context passed to the bus callbacks */
+    ds2431_extension_t *ext;        /**< optional extension */
+    uint8_t rom[8];                 /**< chip rom */
+    uint8_t mode;                   /**< chip mode */
+    uint8_t row_pending;            /**< pending row write, 1 data row and 2 digest row */
+    uint8_t inited;                 /**< inited flag */
 } ds2431_handle_t;
 
 /**
@@ -173,76 +399,118 @@ typedef struct ds2431_info_s
 #define DRIVER_DS2431_LINK_INIT(HANDLE, STRUCTURE)         memset(HANDLE, 0, sizeof(STRUCTURE))
 
 /**
- * @brief     link bus_init function
+ * @brief     link ops table
  * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
+ * @note      none
+ */
+#define DRIVER_DS2431_LINK_OPS(HANDLE, OPS)                (HANDLE)->ops = OPS
+
+/**
+ * @brief     link bus_init function
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to a bus_init function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_BUS_INIT(HANDLE, FUC)           (HANDLE)->bus_init = FUC
+#define DRIVER_DS2431_LINK_BUS_INIT(OPS, FUC)              (OPS)->bus_init = FUC
 
 /**
  * @brief     link bus_deinit function
- * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to a bus_deinit function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_BUS_DEINIT(HANDLE, FUC)         (HANDLE)->bus_deinit = FUC
+#define DRIVER_DS2431_LINK_BUS_DEINIT(OPS, FUC)            (OPS)->bus_deinit = FUC
 
 /**
  * @brief     link bus_read function
- * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to a bus_read function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_BUS_READ(HANDLE, FUC)           (HANDLE)->bus_read = FUC
+#define DRIVER_DS2431_LINK_BUS_READ(OPS, FUC)              (OPS)->bus_read = FUC
 
 /**
  * @brief     link bus_write function
- * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to a bus_write function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_BUS_WRITE(HANDLE, FUC)          (HANDLE)->bus_write = FUC
+#define DRIVER_DS2431_LINK_BUS_WRITE(OPS, FUC)             (OPS)->bus_write = FUC
 
 /**
  * @brief     link delay_ms function
- * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to a delay_ms function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_DELAY_MS(HANDLE, FUC)           (HANDLE)->delay_ms = FUC
+#define DRIVER_DS2431_LINK_DELAY_MS(OPS, FUC)              (OPS)->delay_ms = FUC
 
 /**
  * @brief     link delay_us function
- * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to a delay_us function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_DELAY_US(HANDLE, FUC)           (HANDLE)->delay_us = FUC
+#define DRIVER_DS2431_LINK_DELAY_US(OPS, FUC)              (OPS)->delay_us = FUC
 
 /**
  * @brief     link enable_irq function
- * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to an enable_irq function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_ENABLE_IRQ(HANDLE, FUC)         (HANDLE)->enable_irq = FUC
+#define DRIVER_DS2431_LINK_ENABLE_IRQ(OPS, FUC)            (OPS)->enable_irq = FUC
 
 /**
  * @brief     link disable_irq function
- * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to a disable_irq function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_DISABLE_IRQ(HANDLE, FUC)        (HANDLE)->disable_irq = FUC
+#define DRIVER_DS2431_LINK_DISABLE_IRQ(OPS, FUC)           (OPS)->disable_irq = FUC
 
 /**
  * @brief     link debug_print function
- * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] OPS pointer to a ds2431 ops structure
  * @param[in] FUC pointer to a debug_print function address
  * @note      none
  */
-#define DRIVER_DS2431_LINK_DEBUG_PRINT(HANDLE, FUC)        (HANDLE)->debug_print = FUC
+#define DRIVER_DS2431_LINK_DEBUG_PRINT(OPS, FUC)           (OPS)->debug_print = FUC
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] OPS pointer to a ds2431 ops structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      optional, a free running microsecond counter that may wrap around
+ */
+#define DRIVER_DS2431_LINK_TIMESTAMP_US(OPS, FUC)          (OPS)->timestamp_us = FUC
+
+/**
+ * @brief     link lock function
+ * @param[in] OPS pointer to a ds2431 ops structure
+ * @param[in] FUC pointer to a lock function address
+ * @note      optional, taken around every reset to reset transaction with the user context,
+ *            so handles on one bus share one lock and different buses never contend
+ */
+#define DRIVER_DS2431_LINK_LOCK(OPS, FUC)                  (OPS)->lock = FUC
+
+/**
+ * @brief     link unlock function
+ * @param[in] OPS pointer to a ds2431 ops structure
+ * @param[in] FUC pointer to an unlock function address
+ * @note      optional, must be linked together with lock
+ */
+#define DRIVER_DS2431_LINK_UNLOCK(OPS, FUC)                (OPS)->unlock = FUC
+
+/**
+ * @brief     link user context
+ * @param[in] HANDLE pointer to a ds2431 handle structure
+ * @param[in] USER pointer to a user context
+ * @note      the context is passed unchanged to every bus callback,
+ *            handles on the same bus should link the same context
+ */
+#define DRIVER_DS2431_LINK_USER(HANDLE, USER)              (HANDLE)->user = USER
 
 /**
  * @}
@@ -322,7 +590,10 @@ uint8_t ds2431_get_mode(ds2431_handle_t *handle, ds2431_mode_t *mode);
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 cache has dirty rows
+ * @note      another rom drops the cached config, the shadow rows and the digest,
+ *            so ds2431_set_digest must run again for the new device,
+ *            dirty write back rows must be flushed to the old device first
  */
 uint8_t ds2431_set_rom(ds2431_handle_t *handle, uint8_t rom[8]);
 
@@ -332,6 +603,7 @@ uint8_t ds2431_set_rom(ds2431_handle_t *handle, uint8_t rom[8]);
  * @param[out] *rom pointer to a rom buffer
  * @return     status code
  *             - 0 success
+ *             - 1 get rom failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
@@ -380,7 +652,13 @@ uint8_t ds2431_read(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uin
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 address and len are invalid
- * @note      none
+ *            - 5 range covers the digest row
+ *            - 6 page is write protected
+ * @note      the digest row is programmed once after the data if it is enabled,
+ *            with an extension page controls are checked against the cached memory config before any row is sent,
+ *            the config is read once and the bus is only locked for that check when it has to be read,
+ *            rows of eprom mode pages are programmed with the bitwise and of the old and the new data
+ *            and skipped if that changes nothing, a handle without an extension never reads the config
  */
 uint8_t ds2431_write(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len);
 
@@ -395,7 +673,9 @@ uint8_t ds2431_write(ds2431_handle_t *handle, uint8_t address, uint8_t *data, ui
  *            - 3 handle is not initialized
  *            - 4 address >= 0x0080
  *            - 5 address is invalid
- * @note      none
+ *            - 6 address is reserved
+ * @note      with the digest enabled the digest row can't be copied and
+ *            a successful copy programs the next generation before the bus is unlocked
  */
 uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address);
 
@@ -413,7 +693,8 @@ uint8_t ds2431_copy_scratchpad(ds2431_handle_t *handle, uint16_t address);
  *             - 4 address >= 0x0080
  *             - 5 address is invalid
  *             - 6 crc16 check error
- * @note       none
+ *             - 7 address is reserved
+ * @note       the digest row is reserved while the digest is enabled
  */
 uint8_t ds2431_write_scratchpad(ds2431_handle_t *handle, uint16_t address, uint8_t data[8], uint16_t *crc16);
 
@@ -482,7 +763,7 @@ uint8_t ds2431_search_rom(ds2431_handle_t *handle, uint8_t (*rom)[8], uint8_t *n
  *             - 1 read memory config failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       the result also refreshes the memory config cached in the handle
  */
 uint8_t ds2431_read_memory_config(ds2431_handle_t *handle, ds2431_config_control_t *config);
 
@@ -495,10 +776,372 @@ uint8_t ds2431_read_memory_config(ds2431_handle_t *handle, ds2431_config_control
  *            - 1 write memory config failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 config is copy protected
+ * @note      the cached memory config is dropped and reloaded on the next write
  */
 uint8_t ds2431_write_memory_config(ds2431_handle_t *handle, ds2431_config_control_t *config);
 
+/**
+ * @brief     calculate the 1-wire crc16
+ * @param[in] crc initial crc16
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    updated crc16
+ * @note      polynomial x^16 + x^15 + x^2 + 1, not inverted, start with 0
+ */
+uint16_t ds2431_crc16(uint16_t crc, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief     start a row write without waiting for the programming time
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address row address
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write row start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address is invalid
+ *            - 5 address is the digest row
+ *            - 6 page is write protected
+ *            - 7 a row is pending
+ * @note      address must be a multiple of 8 and not over 0x78,
+ *            the chip is programming for 10ms after success and the bus must not be used
+ *            until ds2431_write_row_finish is called, other buses are free,
+ *            the bus lock is held until the row is no longer pending,
+ *            the page control is only checked for a handle with an extension
+ */
+uint8_t ds2431_write_row_start(ds2431_handle_t *handle, uint8_t address, uint8_t data[8]);
+
+/**
+ * @brief     finish a row write started by ds2431_write_row_start
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write row finish failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no row is pending
+ * @note      call it at least 10ms after ds2431_write_row_start,
+ *            with the digest enabled the first call starts programming the digest row and
+ *            the row stays pending, call it once more at least 10ms later,
+ *            the bus lock is released when the row is no longer pending
+ */
+uint8_t ds2431_write_row_finish(ds2431_handle_t *handle);
+
+/**
+ * @brief      get the pending row state
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *pending pointer to a pending buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       true until ds2431_write_row_finish has released the bus lock
+ */
+uint8_t ds2431_get_row_pending(ds2431_handle_t *handle, ds2431_bool_t *pending);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ds2431_extension_driver ds2431 extension driver function
+ * @brief    ds2431 extension driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief     link an extension
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *ext pointer to a ds2431 extension structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      NULL unlinks the extension and everything attached to it,
+ *            the extension is cleared and may be linked before ds2431_init,
+ *            the cache, the digest, the trace, the stats and the transaction hooks need one
+ */
+uint8_t ds2431_set_extension(ds2431_handle_t *handle, ds2431_extension_t *ext);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ds2431_cache_driver ds2431 cache driver function
+ * @brief    ds2431 cache driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief     attach a shadow cache
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *cache pointer to a ds2431 cache structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 extension is NULL
+ * @note      NULL detaches the cache, every row starts invalid and fills on first access,
+ *            ds2431_read is served from valid rows and ds2431_read_memory_config from the
+ *            memory config kept in the extension, which is the only cached copy of the config row,
+ *            successful writes update the image unless the page is protected or in eprom mode
+ */
+uint8_t ds2431_set_cache(ds2431_handle_t *handle, ds2431_cache_t *cache);
+
+/**
+ * @brief     invalidate the cached rows of a range
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] address input address
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 cache is NULL
+ *            - 4 address and len are invalid
+ * @note      address + len must not be over 0x80
+ */
+uint8_t ds2431_cache_invalidate(ds2431_handle_t *handle, uint8_t address, uint8_t len);
+
+/**
+ * @brief     reload the whole shadow image from the chip
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cache is NULL
+ * @note      the memory config kept in the extension is reloaded as well
+ */
+uint8_t ds2431_cache_refresh(ds2431_handle_t *handle);
+
+/**
+ * @brief      get the valid row mask
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *valid pointer to a valid mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 cache is NULL
+ * @note       bit n is row n at address n * 8
+ */
+uint8_t ds2431_cache_get_valid(ds2431_handle_t *handle, uint32_t *valid);
+
+/**
+ * @brief      get the dirty row mask
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *dirty pointer to a dirty mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 cache is NULL
+ * @note       bit n is row n at address n * 8
+ */
+uint8_t ds2431_cache_get_dirty(ds2431_handle_t *handle, uint32_t *dirty);
+
+/**
+ * @brief     set the write back policy
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] enable bool value
+ * @param[in] flush_count flush after this many writes, 0 is disabled
+ * @param[in] flush_us flush once the oldest dirty row is this old, 0 is disabled
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 cache is NULL
+ *            - 4 timestamp_us is NULL
+ *            - 5 dirty rows must be flushed first
+ * @note      with write back enabled ds2431_write only updates the cached image and marks
+ *            the rows dirty, ds2431_flush programs them, flush_us is checked by
+ *            ds2431_write and ds2431_write_back_poll and needs the timestamp_us callback
+ */
+uint8_t ds2431_set_write_back(ds2431_handle_t *handle, ds2431_bool_t enable, uint8_t flush_count, uint32_t flush_us);
+
+/**
+ * @brief     program every dirty row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cache is NULL
+ * @note      rows are programmed in address order under one bus lock,
+ *            in match rom mode the rows after the first are selected with resume,
+ *            a row that fails stays dirty
+ */
+uint8_t ds2431_flush(ds2431_handle_t *handle);
+
+/**
+ * @brief     flush if the write back policy is due
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cache is NULL
+ * @note      call it periodically so an idle burst is flushed after flush_us
+ */
+uint8_t ds2431_write_back_poll(ds2431_handle_t *handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ds2431_digest_driver ds2431 digest driver function
+ * @brief    ds2431 digest driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief     enable or disable the digest row
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] enable bool value
+ * @param[in] address digest row address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set digest failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address is invalid
+ *            - 5 extension is NULL
+ * @note      address must be a multiple of 8 and not over 0x78,
+ *            the row holds a 32 bit generation, a magic byte and a crc16,
+ *            a blank or corrupted row is written with generation 0,
+ *            every later write through ds2431_write, ds2431_write_row_finish or ds2431_flush
+ *            programs the row once more with the next generation,
+ *            ds2431_write refuses ranges that cover the row
+ */
+uint8_t ds2431_set_digest(ds2431_handle_t *handle, ds2431_bool_t enable, uint8_t address);
+
+/**
+ * @brief      get the last known digest
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[out] *digest pointer to a digest buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 digest is disabled
+ * @note       no bus traffic
+ */
+uint8_t ds2431_get_digest(ds2431_handle_t *handle, uint32_t *digest);
+
+/**
+ * @brief      check if the memory changed since a known digest
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  known_digest digest saved by the caller
+ * @param[out] *changed pointer to a bool value buffer
+ * @param[out] *digest pointer to a current digest buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 digest is disabled
+ * @note       only the 8 byte digest row is read from the chip, never from the cache,
+ *             a corrupted row reads as changed,
+ *             if it changed the clean rows of an attached cache are invalidated
+ */
+uint8_t ds2431_is_changed(ds2431_handle_t *handle, uint32_t known_digest, ds2431_bool_t *changed, uint32_t *digest);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ds2431_trace_driver ds2431 trace driver function
+ * @brief    ds2431 trace driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief     attach a bus trace
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *trace pointer to a ds2431 trace structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 extension is NULL
+ * @note      NULL detaches the trace, it may be attached before ds2431_init,
+ *            every reset, byte, search bit and crc16 check is recorded as one 32 bit event,
+ *            the timestamps need the timestamp_us callback and are 0 without it,
+ *            once the ring is full the oldest events are overwritten
+ */
+uint8_t ds2431_set_trace(ds2431_handle_t *handle, ds2431_trace_t *trace);
+
+/**
+ * @brief         take the oldest events from the trace
+ * @param[in]     *handle pointer to a ds2431 handle structure
+ * @param[out]    *event pointer to an event buffer
+ * @param[in,out] *len pointer to an event length buffer
+ * @param[out]    *lost pointer to a lost event number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 trace is NULL
+ * @note          len is the buffer size on input and the number of events taken on output,
+ *                lost is the number of events overwritten since the last call
+ */
+uint8_t ds2431_trace_read(ds2431_handle_t *handle, uint32_t *event, uint16_t *len, uint32_t *lost);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ds2431_stats_driver ds2431 stats driver function
+ * @brief    ds2431 stats driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief     attach the performance counters
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @param[in] *stats pointer to a ds2431 stats structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 extension is NULL
+ * @note      NULL detaches the counters, attaching clears them and it may be done before ds2431_init,
+ *            the irq off times and the histograms need the timestamp_us callback,
+ *            one histogram sample is the time from taking the bus lock to releasing it,
+ *            so calls served from the cache add none and ds2431_write adds one per row
+ */
+uint8_t ds2431_set_stats(ds2431_handle_t *handle, ds2431_stats_t *stats);
+
+/**
+ * @brief      estimate the bus time of an api call
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  op operation id
+ * @param[in]  address input address
+ * @param[in]  len data length
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address and len are invalid
+ *             - 5 op is not supported
+ * @note       the estimate is an upper bound of the bus time of a chip within the datasheet limits,
+ *             it is built from the same slot timings as the driver and takes the current mode,
+ *             the cached rows, the cached memory config and the digest setting into account,
+ *             callback overhead and time spent waiting for the bus lock are not included,
+ *             supported ops are read, write, read_memory, write_scratchpad, read_scratchpad,
+ *             copy_scratchpad, read_memory_config, write_memory_config, write_row and flush,
+ *             a write back write covers only the row fills, its flush is estimated with the flush op,
+ *             address is ignored by the ops that do not take one
+ */
+uint8_t ds2431_estimate_us(ds2431_handle_t *handle, ds2431_stats_api_t op, uint16_t address, uint16_t len, uint32_t *us);
+
 /**
  * @}
  */
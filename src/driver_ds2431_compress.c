@@ -0,0 +1,369 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_compress.c
+ * @brief     driver ds2431 compress source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_compress.h"
+
+/**
+ * @brief compress run definition
+ */
+#define DS2431_COMPRESS_MIN_RUN        3          /**< shorter runs stay literal */
+#define DS2431_COMPRESS_MAX_RUN        129        /**< 0x7F + 2 */
+#define DS2431_COMPRESS_MAX_LITERAL    128        /**< 0x7F + 1 */
+
+/**
+ * @brief     get the run length at a position
+ * @param[in] *data pointer to a data buffer
+ * @param[in] pos position
+ * @param[in] len data length
+ * @return    run length
+ * @note      none
+ */
+static uint8_t a_ds2431_compress_run(const uint8_t *data, uint8_t pos, uint8_t len)
+{
+    uint8_t run;
+    
+    run = 1;                                       /* init 1 */
+    while (((pos + run) < len) && (data[pos + run] == data[pos]) &&
+           (run < DS2431_COMPRESS_MAX_RUN))        /* same byte */
+    {
+        run++;                                     /* run++ */
+    }
+    
+    return run;                                    /* return run */
+}
+
+/**
+ * @brief      encode or measure a buffer
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *out pointer to an output buffer, NULL only measures
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 output buffer is too small
+ * @note       none
+ */
+static uint8_t a_ds2431_compress_encode(const uint8_t *data, uint8_t len, uint8_t *out, uint16_t out_size, uint16_t *out_len)
+{
+    uint8_t pos;
+    uint8_t run;
+    uint8_t lit;
+    uint16_t n;
+    
+    n = 0;                                                  /* init 0 */
+    pos = 0;                                                /* init 0 */
+    while (pos < len)                                       /* all data */
+    {
+        run = a_ds2431_compress_run(data, pos, len);        /* get run */
+        if (run >= DS2431_COMPRESS_MIN_RUN)                 /* repeat */
+        {
+            if ((n + 2) > out_size)                         /* check size */
+            {
+                return 4;                                   /* return error */
+            }
+            if (out != NULL)                                /* check output */
+            {
+                out[n] = (uint8_t)(0x80 + run - 2);         /* control */
+                out[n + 1] = data[pos];                     /* byte */
+            }
+            n += 2;                                         /* next */
+            pos += run;                                     /* skip run */
+            
+            continue;                                       /* continue */
+        }
+        lit = 0;                                            /* literal run */
+        while (((pos + lit) < len) && (lit < DS2431_COMPRESS_MAX_LITERAL) &&
+               (a_ds2431_compress_run(data, (uint8_t)(pos + lit), len) < DS2431_COMPRESS_MIN_RUN))
+        {
+            lit++;                                          /* lit++ */
+        }
+        if ((n + 1 + lit) > out_size)                       /* check size */
+        {
+            return 4;                                       /* return error */
+        }
+        if (out != NULL)                                    /* check output */
+        {
+            out[n] = (uint8_t)(lit - 1);                    /* control */
+            memcpy(&out[n + 1], &data[pos], lit);           /* literals */
+        }
+        n += 1 + lit;                                       /* next */
+        pos += lit;                                         /* skip literals */
+    }
+    *out_len = n;                                           /* set length */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the packed size of a buffer
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *size pointer to a size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 data is NULL
+ * @note       the size includes the 2 byte header written by ds2431_compress_write,
+ *             nothing is encoded and no RAM besides the stack frame is used
+ */
+uint8_t ds2431_compress_size(const uint8_t *data, uint8_t len, uint8_t *size)
+{
+    uint16_t n;
+    
+    if ((data == NULL) || (size == NULL))                                /* check buffer */
+    {
+        return 2;                                                        /* return error */
+    }
+    
+    (void)a_ds2431_compress_encode(data, len, NULL, 0xFFFFU, &n);        /* measure */
+    n += DS2431_COMPRESS_HEADER;                                         /* add header */
+    *size = (n > 0xFF) ? 0xFF : (uint8_t)n;                              /* set size */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      encode a buffer with run length coding
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 output buffer is too small
+ * @note       control byte c < 0x80 copies c + 1 literal bytes,
+ *             c >= 0x80 repeats the next byte c - 0x80 + 2 times
+ */
+uint8_t ds2431_compress_encode(const uint8_t *data, uint8_t len, uint8_t *out, uint8_t out_size, uint8_t *out_len)
+{
+    uint16_t n;
+    
+    if ((data == NULL) || (out == NULL) || (out_len == NULL))               /* check buffer */
+    {
+        return 2;                                                           /* return error */
+    }
+    
+    if (a_ds2431_compress_encode(data, len, out, out_size, &n) != 0)        /* encode */
+    {
+        return 4;                                                           /* return error */
+    }
+    *out_len = (uint8_t)n;                                                  /* set length */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      decode a run length coded buffer
+ * @param[in]  *data pointer to a packed buffer
+ * @param[in]  len packed length
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 output buffer is too small
+ *             - 5 packed data is corrupted
+ * @note       none
+ */
+uint8_t ds2431_compress_decode(const uint8_t *data, uint8_t len, uint8_t *out, uint8_t out_size, uint8_t *out_len)
+{
+    uint8_t pos;
+    uint8_t c;
+    uint16_t cnt;
+    uint16_t n;
+    
+    if ((data == NULL) || (out == NULL) || (out_len == NULL))        /* check buffer */
+    {
+        return 2;                                                    /* return error */
+    }
+    
+    n = 0;                                                           /* init 0 */
+    pos = 0;                                                         /* init 0 */
+    while (pos < len)                                                /* all packed data */
+    {
+        c = data[pos];                                               /* get control */
+        if (c >= 0x80)                                               /* repeat */
+        {
+            cnt = (uint16_t)(c - 0x80 + 2);                          /* get count */
+            if ((pos + 1) >= len)                                    /* check byte */
+            {
+                return 5;                                            /* return error */
+            }
+            if ((n + cnt) > out_size)                                /* check size */
+            {
+                return 4;                                            /* return error */
+            }
+            memset(&out[n], data[pos + 1], cnt);                     /* repeat */
+            pos = (uint8_t)(pos + 2);                                /* next */
+        }
+        else                                                         /* literal */
+        {
+            cnt = (uint16_t)(c + 1);                                 /* get count */
+            if ((pos + 1 + cnt) > len)                               /* check literals */
+            {
+                return 5;                                            /* return error */
+            }
+            if ((n + cnt) > out_size)                                /* check size */
+            {
+                return 4;                                            /* return error */
+            }
+            memcpy(&out[n], &data[pos + 1], cnt);                    /* copy */
+            pos = (uint8_t)(pos + 1 + cnt);                          /* next */
+        }
+        n += cnt;                                                    /* n + cnt */
+    }
+    *out_len = (uint8_t)n;                                           /* set length */
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief      pack and write data
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  address input address
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *size pointer to a stored size buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 write failed
+ *             - 2 handle is NULL
+ *             - 4 packed data does not fit
+ * @note       the stored image is the raw length, the packed length and the packed bytes,
+ *             check the room with ds2431_compress_size first
+ */
+uint8_t ds2431_compress_write(ds2431_handle_t *handle, uint8_t address, const uint8_t *data, uint8_t len, uint8_t *size)
+{
+    uint16_t n;
+    uint8_t buf[128];
+    
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (address >= 0x80)                                                        /* check address */
+    {
+        return 4;                                                               /* return error */
+    }
+    
+    if (a_ds2431_compress_encode(data, len, &buf[DS2431_COMPRESS_HEADER],
+                                 (uint16_t)(0x80 - address - DS2431_COMPRESS_HEADER),
+                                 &n) != 0)                                      /* encode */
+    {
+        handle->ops->debug_print("ds2431: packed data does not fit.\n");        /* packed data does not fit */
+        
+        return 4;                                                               /* return error */
+    }
+    buf[0] = len;                                                               /* raw length */
+    buf[1] = (uint8_t)n;                                                        /* packed length */
+    if (ds2431_write(handle, address, buf,
+                     (uint8_t)(n + DS2431_COMPRESS_HEADER)) != 0)               /* write */
+    {
+        return 1;                                                               /* return error */
+    }
+    if (size != NULL)                                                           /* check size */
+    {
+        *size = (uint8_t)(n + DS2431_COMPRESS_HEADER);                          /* set size */
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief         read and unpack data
+ * @param[in]     *handle pointer to a ds2431 handle structure
+ * @param[in]     address input address
+ * @param[out]    *data pointer to a data buffer
+ * @param[in,out] *len pointer to a length buffer, buffer size in and data length out
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 4 buffer is too small
+ *                - 5 packed data is corrupted
+ * @note          none
+ */
+uint8_t ds2431_compress_read(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uint8_t *len)
+{
+    uint8_t res;
+    uint8_t n;
+    uint8_t buf[128];
+    
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if ((address + DS2431_COMPRESS_HEADER) > 0x80)                              /* check address */
+    {
+        return 5;                                                               /* return error */
+    }
+    
+    if (ds2431_read(handle, address, buf, DS2431_COMPRESS_HEADER) != 0)         /* read header */
+    {
+        return 1;                                                               /* return error */
+    }
+    if ((address + DS2431_COMPRESS_HEADER + buf[1]) > 0x80)                     /* check packed length */
+    {
+        handle->ops->debug_print("ds2431: packed data is corrupted.\n");        /* packed data is corrupted */
+        
+        return 5;                                                               /* return error */
+    }
+    if (buf[0] > *len)                                                          /* check buffer */
+    {
+        *len = buf[0];                                                          /* set needed length */
+        
+        return 4;                                                               /* return error */
+    }
+    if (ds2431_read(handle, (uint8_t)(address + DS2431_COMPRESS_HEADER),
+                    &buf[DS2431_COMPRESS_HEADER], buf[1]) != 0)                 /* read packed data */
+    {
+        return 1;                                                               /* return error */
+    }
+    res = ds2431_compress_decode(&buf[DS2431_COMPRESS_HEADER], buf[1],
+                                 data, *len, &n);                               /* decode */
+    if ((res != 0) || (n != buf[0]))                                            /* check the result */
+    {
+        handle->ops->debug_print("ds2431: packed data is corrupted.\n");        /* packed data is corrupted */
+        
+        return 5;                                                               /* return error */
+    }
+    *len = n;                                                                   /* set length */
+    
+    return 0;                                                                   /* success return 0 */
+}
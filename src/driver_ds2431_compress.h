@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_compress.h
+ * @brief     driver ds2431 compress header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS2431_COMPRESS_H
+#define DRIVER_DS2431_COMPRESS_H
+
+#include "driver_ds2431.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds2431_compress_driver ds2431 compress driver function
+ * @brief    ds2431 compress driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 compress header definition
+ */
+#define DS2431_COMPRESS_HEADER        2        /**< raw length and packed length */
+
+/**
+ * @brief      get the packed size of a buffer
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *size pointer to a size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 data is NULL
+ * @note       the size includes the 2 byte header written by ds2431_compress_write,
+ *             nothing is encoded and no RAM besides the stack frame is used
+ */
+uint8_t ds2431_compress_size(const uint8_t *data, uint8_t len, uint8_t *size);
+
+/**
+ * @brief      encode a buffer with run length coding
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 output buffer is too small
+ * @note       control byte c < 0x80 copies c + 1 literal bytes,
+ *             c >= 0x80 repeats the next byte c - 0x80 + 2 times
+ */
+uint8_t ds2431_compress_encode(const uint8_t *data, uint8_t len, uint8_t *out, uint8_t out_size, uint8_t *out_len);
+
+/**
+ * @brief      decode a run length coded buffer
+ * @param[in]  *data pointer to a packed buffer
+ * @param[in]  len packed length
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 output buffer is too small
+ *             - 5 packed data is corrupted
+ * @note       none
+ */
+uint8_t ds2431_compress_decode(const uint8_t *data, uint8_t len, uint8_t *out, uint8_t out_size, uint8_t *out_len);
+
+/**
+ * @brief      pack and write data
+ * @param[in]  *handle pointer to a ds2431 handle structure
+ * @param[in]  address input address
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *size pointer to a stored size buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 write failed
+ *             - 2 handle is NULL
+ *             - 4 packed data does not fit
+ * @note       the stored image is the raw length, the packed length and the packed bytes,
+ *             check the room with ds2431_compress_size first
+ */
+uint8_t ds2431_compress_write(ds2431_handle_t *handle, uint8_t address, const uint8_t *data, uint8_t len, uint8_t *size);
+
+/**
+ * @brief         read and unpack data
+ * @param[in]     *handle pointer to a ds2431 handle structure
+ * @param[in]     address input address
+ * @param[out]    *data pointer to a data buffer
+ * @param[in,out] *len pointer to a length buffer, buffer size in and data length out
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 4 buffer is too small
+ *                - 5 packed data is corrupted
+ * @note          none
+ */
+uint8_t ds2431_compress_read(ds2431_handle_t *handle, uint8_t address, uint8_t *data, uint8_t *len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,318 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_counter.c
+ * @brief     driver ds2431 counter source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_counter.h"
+
+/**
+ * @brief      decode a unary count
+ * @param[in]  *buf pointer to the counter rows
+ * @param[in]  len data length
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 6 counter is corrupted
+ * @note       none
+ */
+static uint8_t a_ds2431_counter_decode(uint8_t *buf, uint8_t len, uint16_t *count)
+{
+    uint8_t i;
+    uint8_t bit;
+    uint8_t hole;
+    uint16_t n;
+    
+    n = 0;                                              /* init 0 */
+    hole = 0;                                           /* init 0 */
+    for (i = 0; i < len; i++)                           /* every byte */
+    {
+        for (bit = 0; bit < 8; bit++)                   /* lsb first */
+        {
+            if ((buf[i] & (1 << bit)) == 0)             /* cleared */
+            {
+                if (hole != 0)                          /* set bit before it */
+                {
+                    hole = 2;                           /* tampered */
+                }
+                n = (uint16_t)(i * 8 + bit + 1);        /* highest cleared bit */
+            }
+            else if (hole == 0)                         /* first set bit */
+            {
+                hole = 1;                               /* end of the prefix */
+            }
+            else
+            {
+                /* keep the state */
+            }
+        }
+    }
+    *count = n;                                         /* set count */
+    if (hole == 2)                                      /* check tamper */
+    {
+        return 6;                                       /* return error */
+    }
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     mount a counter
+ * @param[in] *counter pointer to a ds2431 counter structure
+ * @param[in] *handle pointer to an initialized ds2431 handle structure
+ * @param[in] address first row address
+ * @param[in] rows counter rows
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 counter is NULL
+ *            - 3 handle is invalid
+ *            - 4 address and rows are invalid
+ *            - 5 page is not in eprom mode
+ *            - 6 counter is corrupted
+ * @note      setting a page to eprom mode can not be undone, so it is left to the caller
+ *            with ds2431_write_memory_config
+ */
+uint8_t ds2431_counter_init(ds2431_counter_t *counter, ds2431_handle_t *handle, uint8_t address, uint8_t rows)
+{
+    uint8_t page;
+    uint8_t control;
+    ds2431_config_control_t config;
+    
+    if (counter == NULL)                                                             /* check counter */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if ((handle == NULL) || (handle->inited != 1))                                   /* check handle */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if ((rows == 0) || ((address % 8) != 0) || ((address + rows * 8) > 0x80))        /* check rows */
+    {
+        handle->ops->debug_print("ds2431: address and rows are invalid.\n");         /* address and rows are invalid */
+        
+        return 4;                                                                    /* return error */
+    }
+    
+    counter->inited = 0;                                                             /* not ready */
+    if (ds2431_read_memory_config(handle, &config) != 0)                             /* read config */
+    {
+        return 1;                                                                    /* return error */
+    }
+    for (page = address / 32; page <= (address + rows * 8 - 1) / 32; page++)         /* every page */
+    {
+        control = (page == 0) ? config.page0_protection_control :
+                  (page == 1) ? config.page1_protection_control :
+                  (page == 2) ? config.page2_protection_control :
+                                config.page3_protection_control;                     /* get page control */
+        if (control != DS2431_CONFIG_EPROM_MODE)                                     /* check eprom mode */
+        {
+            handle->ops->debug_print("ds2431: page is not in eprom mode.\n");        /* page is not in eprom mode */
+            
+            return 5;                                                                /* return error */
+        }
+    }
+    counter->handle = handle;                                                        /* set handle */
+    counter->address = address;                                                      /* set address */
+    counter->rows = rows;                                                            /* set rows */
+    counter->count = 0;                                                              /* init 0 */
+    counter->inited = 1;                                                             /* ready */
+    
+    return ds2431_counter_read(counter, &counter->count);                            /* read count */
+}
+
+/**
+ * @brief      read the count
+ * @param[in]  *counter pointer to a ds2431 counter structure
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 counter is NULL
+ *             - 3 counter is not initialized
+ *             - 6 counter is corrupted
+ * @note       all rows are decoded from one ds2431_read,
+ *             a cleared bit after a set bit means the rows were tampered with,
+ *             the count is then the highest cleared bit + 1 and 6 is returned
+ */
+uint8_t ds2431_counter_read(ds2431_counter_t *counter, uint16_t *count)
+{
+    uint8_t res;
+    uint8_t buf[128];
+    
+    if (counter == NULL)                                                                      /* check counter */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (counter->inited != 1)                                                                 /* check counter initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    if (ds2431_read(counter->handle, counter->address, buf,
+                    (uint8_t)(counter->rows * 8)) != 0)                                       /* one read memory pass */
+    {
+        return 1;                                                                             /* return error */
+    }
+    res = a_ds2431_counter_decode(buf, (uint8_t)(counter->rows * 8), &counter->count);        /* decode */
+    if (res != 0)                                                                             /* check the result */
+    {
+        counter->handle->ops->debug_print("ds2431: counter is corrupted.\n");                 /* counter is corrupted */
+    }
+    *count = counter->count;                                                                  /* set count */
+    
+    return res;                                                                               /* return the result */
+}
+
+/**
+ * @brief      increment the count
+ * @param[in]  *counter pointer to a ds2431 counter structure
+ * @param[out] *count pointer to a count buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 increment failed
+ *             - 2 counter is NULL
+ *             - 3 counter is not initialized
+ *             - 4 counter is full
+ * @note       the row holding the next bit is read from the chip, so a stale count only picks
+ *             the first row to read, the row is programmed and read back and 0 is returned
+ *             only if the next bit is cleared on the chip
+ */
+uint8_t ds2431_counter_increment(ds2431_counter_t *counter, uint16_t *count)
+{
+    uint8_t i;
+    uint8_t row;
+    uint8_t bit;
+    uint8_t bits;
+    uint16_t n;
+    uint8_t buf[8];
+    
+    if (counter == NULL)                                                                          /* check counter */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (counter->inited != 1)                                                                     /* check counter initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    
+    n = DS2431_COUNTER_ROW_STEPS;                                                                 /* init full */
+    for (row = (uint8_t)(counter->count / DS2431_COUNTER_ROW_STEPS); row < counter->rows; row++)  /* from the known row */
+    {
+        if (ds2431_read_memory(counter->handle, (uint16_t)(counter->address + row * 8),
+                               buf, 8) != 0)                                                      /* read the row from the chip */
+        {
+            return 1;                                                                             /* return error */
+        }
+        (void)a_ds2431_counter_decode(buf, 8, &n);                                                /* count in the row */
+        if (n < DS2431_COUNTER_ROW_STEPS)                                                         /* row has a set bit */
+        {
+            break;                                                                                /* found */
+        }
+    }
+    if (row >= counter->rows)                                                                     /* check full */
+    {
+        counter->count = (uint16_t)(counter->rows * DS2431_COUNTER_ROW_STEPS);                    /* set count */
+        counter->handle->ops->debug_print("ds2431: counter is full.\n");                          /* counter is full */
+        
+        return 4;                                                                                 /* return error */
+    }
+    
+    bit = (uint8_t)n;                                                                             /* next bit in the row */
+    bits = (uint8_t)(bit + 1);                                                                    /* cleared bits in the row */
+    for (i = 0; i < 8; i++)                                                                       /* build the row */
+    {
+        if (bits >= 8)                                                                            /* whole byte */
+        {
+            buf[i] = 0x00;                                                                        /* all cleared */
+            bits = (uint8_t)(bits - 8);                                                           /* next byte */
+        }
+        else
+        {
+            buf[i] = (uint8_t)(0xFF << bits);                                                     /* clear the low bits */
+            bits = 0;                                                                             /* rest erased */
+        }
+    }
+    if (ds2431_write(counter->handle, (uint8_t)(counter->address + row * 8), buf, 8) != 0)        /* program the row */
+    {
+        return 1;                                                                                 /* return error */
+    }
+    if (ds2431_read_memory(counter->handle, (uint16_t)(counter->address + row * 8),
+                           buf, 8) != 0)                                                          /* read the row back */
+    {
+        return 1;                                                                                 /* return error */
+    }
+    if ((buf[bit / 8] & (1 << (bit % 8))) != 0)                                                   /* check the bit */
+    {
+        counter->handle->ops->debug_print("ds2431: counter bit is not cleared.\n");               /* counter bit is not cleared */
+        
+        return 1;                                                                                 /* return error */
+    }
+    (void)a_ds2431_counter_decode(buf, 8, &n);                                                    /* count in the row */
+    counter->count = (uint16_t)(row * DS2431_COUNTER_ROW_STEPS + n);                              /* set count */
+    if (count != NULL)                                                                            /* check count */
+    {
+        *count = counter->count;                                                                  /* set count */
+    }
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the counter capacity
+ * @param[in]  *counter pointer to a ds2431 counter structure
+ * @param[out] *per_row pointer to an increments per row buffer
+ * @param[out] *total pointer to a total increments buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 counter is NULL
+ *             - 3 counter is not initialized
+ * @note       the counter moves to the next row after per_row increments
+ *             and stops at total, it never rolls over
+ */
+uint8_t ds2431_counter_get_capacity(ds2431_counter_t *counter, uint8_t *per_row, uint16_t *total)
+{
+    if (counter == NULL)                                                  /* check counter */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (counter->inited != 1)                                             /* check counter initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    
+    *per_row = DS2431_COUNTER_ROW_STEPS;                                  /* set increments per row */
+    *total = (uint16_t)(counter->rows * DS2431_COUNTER_ROW_STEPS);        /* set total increments */
+    
+    return 0;                                                             /* success return 0 */
+}
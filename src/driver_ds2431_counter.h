@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_counter.h
+ * @brief     driver ds2431 counter header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS2431_COUNTER_H
+#define DRIVER_DS2431_COUNTER_H
+
+#include "driver_ds2431.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds2431_counter_driver ds2431 counter driver function
+ * @brief    ds2431 counter driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 counter row steps definition
+ */
+#define DS2431_COUNTER_ROW_STEPS        64        /**< one cleared bit per increment, 8 bytes per row */
+
+/**
+ * @brief ds2431 counter structure definition
+ * @note  the count is unary, bit n of the counter rows (byte n / 8, lsb first) is cleared by
+ *        increment n + 1, the pages must be in eprom mode so a bit can never be set again
+ */
+typedef struct ds2431_counter_s
+{
+    ds2431_handle_t *handle;        /**< chip handle */
+    uint8_t address;                /**< first row address */
+    uint8_t rows;                   /**< counter rows */
+    uint16_t count;                 /**< last known count */
+    uint8_t inited;                 /**< inited flag */
+} ds2431_counter_t;
+
+/**
+ * @brief     mount a counter
+ * @param[in] *counter pointer to a ds2431 counter structure
+ * @param[in] *handle pointer to an initialized ds2431 handle structure
+ * @param[in] address first row address
+ * @param[in] rows counter rows
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 counter is NULL
+ *            - 3 handle is invalid
+ *            - 4 address and rows are invalid
+ *            - 5 page is not in eprom mode
+ *            - 6 counter is corrupted
+ * @note      setting a page to eprom mode can not be undone, so it is left to the caller
+ *            with ds2431_write_memory_config
+ */
+uint8_t ds2431_counter_init(ds2431_counter_t *counter, ds2431_handle_t *handle, uint8_t address, uint8_t rows);
+
+/**
+ * @brief      read the count
+ * @param[in]  *counter pointer to a ds2431 counter structure
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 counter is NULL
+ *             - 3 counter is not initialized
+ *             - 6 counter is corrupted
+ * @note       all rows are decoded from one ds2431_read,
+ *             a cleared bit after a set bit means the rows were tampered with,
+ *             the count is then the highest cleared bit + 1 and 6 is returned
+ */
+uint8_t ds2431_counter_read(ds2431_counter_t *counter, uint16_t *count);
+
+/**
+ * @brief      increment the count
+ * @param[in]  *counter pointer to a ds2431 counter structure
+ * @param[out] *count pointer to a count buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 increment failed
+ *             - 2 counter is NULL
+ *             - 3 counter is not initialized
+ *             - 4 counter is full
+ * @note       the row holding the next bit is read from the chip, so a stale count only picks
+ *             the first row to read, the row is programmed and read back and 0 is returned
+ *             only if the next bit is cleared on the chip
+ */
+uint8_t ds2431_counter_increment(ds2431_counter_t *counter, uint16_t *count);
+
+/**
+ * @brief      get the counter capacity
+ * @param[in]  *counter pointer to a ds2431 counter structure
+ * @param[out] *per_row pointer to an increments per row buffer
+ * @param[out] *total pointer to a total increments buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 counter is NULL
+ *             - 3 counter is not initialized
+ * @note       the counter moves to the next row after per_row increments
+ *             and stops at total, it never rolls over
+ */
+uint8_t ds2431_counter_get_capacity(ds2431_counter_t *counter, uint8_t *per_row, uint16_t *total);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,359 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_journal.c
+ * @brief     driver ds2431 journal source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_journal.h"
+
+/**
+ * @brief journal magic definition
+ */
+#define DS2431_JOURNAL_MAGIC        0x4A        /**< commit row magic */
+
+/**
+ * @brief     get the physical address of a logical row
+ * @param[in] *journal pointer to a ds2431 journal structure
+ * @param[in] row logical row
+ * @param[in] bank bank index
+ * @return    row address
+ * @note      none
+ */
+static uint8_t a_ds2431_journal_row(ds2431_journal_t *journal, uint8_t row, uint8_t bank)
+{
+    return (uint8_t)(journal->address + (bank * journal->rows + row) * 8);        /* return address */
+}
+
+/**
+ * @brief     get the address of a commit row
+ * @param[in] *journal pointer to a ds2431 journal structure
+ * @param[in] slot commit slot
+ * @return    row address
+ * @note      none
+ */
+static uint8_t a_ds2431_journal_commit_row(ds2431_journal_t *journal, uint8_t slot)
+{
+    return (uint8_t)(journal->address + (2 * journal->rows + slot) * 8);          /* return address */
+}
+
+/**
+ * @brief     write a commit row
+ * @param[in] *journal pointer to a ds2431 journal structure
+ * @param[in] slot commit slot
+ * @param[in] generation generation
+ * @param[in] map bank map
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds2431_journal_commit(ds2431_journal_t *journal, uint8_t slot, uint16_t generation, uint16_t map)
+{
+    uint8_t buf[8];
+    uint16_t crc;
+    
+    buf[0] = (generation >> 0) & 0xFF;                                                 /* generation lsb */
+    buf[1] = (generation >> 8) & 0xFF;                                                 /* generation msb */
+    buf[2] = (map >> 0) & 0xFF;                                                        /* map lsb */
+    buf[3] = (map >> 8) & 0xFF;                                                        /* map msb */
+    buf[4] = journal->rows;                                                            /* rows */
+    buf[5] = DS2431_JOURNAL_MAGIC;                                                     /* magic */
+    crc = ds2431_crc16(0, buf, 6);                                                     /* crc16 */
+    buf[6] = (crc >> 0) & 0xFF;                                                        /* crc16 lsb */
+    buf[7] = (crc >> 8) & 0xFF;                                                        /* crc16 msb */
+    if (ds2431_write(journal->handle, a_ds2431_journal_commit_row(journal, slot),
+                     buf, 8) != 0)                                                     /* write commit row */
+    {
+        return 1;                                                                      /* return error */
+    }
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      parse a commit row
+ * @param[in]  *journal pointer to a ds2431 journal structure
+ * @param[in]  *buf pointer to a row buffer
+ * @param[out] *generation pointer to a generation buffer
+ * @param[out] *map pointer to a bank map buffer
+ * @return     1 if the row is a good commit, 0 if not
+ * @note       none
+ */
+static uint8_t a_ds2431_journal_parse(ds2431_journal_t *journal, uint8_t buf[8], uint16_t *generation, uint16_t *map)
+{
+    uint16_t crc;
+    
+    crc = (uint16_t)(((uint16_t)buf[7] << 8) | buf[6]);                                /* get crc16 */
+    if ((buf[5] != DS2431_JOURNAL_MAGIC) || (buf[4] != journal->rows) ||
+        (ds2431_crc16(0, buf, 6) != crc))                                              /* check row */
+    {
+        return 0;                                                                      /* not a commit */
+    }
+    *generation = (uint16_t)(((uint16_t)buf[1] << 8) | buf[0]);                        /* get generation */
+    *map = (uint16_t)(((uint16_t)buf[3] << 8) | buf[2]);                               /* get map */
+    
+    return 1;                                                                          /* good commit */
+}
+
+/**
+ * @brief     open a journal area and recover it
+ * @param[in] *journal pointer to a ds2431 journal structure
+ * @param[in] *handle pointer to an initialized ds2431 handle structure
+ * @param[in] address first row address of the area
+ * @param[in] rows logical rows
+ * @return    status code
+ *            - 0 success
+ *            - 1 recover failed
+ *            - 2 journal is NULL
+ *            - 3 handle is invalid
+ *            - 4 address and rows are invalid
+ * @note      the area uses (2 * rows + 2) rows from address, call it right after ds2431_init,
+ *            the newest commit row with a good crc16 wins, which rolls an update that
+ *            reached its commit forward and an interrupted one back,
+ *            an area without any good commit row is formatted with bank a current
+ */
+uint8_t ds2431_journal_init(ds2431_journal_t *journal, ds2431_handle_t *handle, uint8_t address, uint8_t rows)
+{
+    uint8_t i;
+    uint8_t good[2];
+    uint8_t buf[8];
+    uint16_t generation[2];
+    uint16_t map[2];
+    
+    if (journal == NULL)                                                                       /* check journal */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if ((handle == NULL) || (handle->inited != 1))                                             /* check handle */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if ((rows == 0) || (rows > DS2431_JOURNAL_MAX_ROWS) || ((address % 8) != 0) ||
+        ((address + (2 * rows + 2) * 8) > 0x80))                                               /* check area */
+    {
+        handle->ops->debug_print("ds2431: address and rows are invalid.\n");                   /* address and rows are invalid */
+        
+        return 4;                                                                              /* return error */
+    }
+    
+    journal->handle = handle;                                                                  /* set handle */
+    journal->address = address;                                                                /* set address */
+    journal->rows = rows;                                                                      /* set rows */
+    journal->inited = 0;                                                                       /* not ready */
+    for (i = 0; i < 2; i++)                                                                    /* both commit rows */
+    {
+        if (ds2431_read(handle, a_ds2431_journal_commit_row(journal, i), buf, 8) != 0)         /* read commit row */
+        {
+            return 1;                                                                          /* return error */
+        }
+        good[i] = a_ds2431_journal_parse(journal, buf, &generation[i], &map[i]);               /* parse */
+    }
+    if ((good[0] != 0) &&
+        ((good[1] == 0) || ((int16_t)(generation[0] - generation[1]) > 0)))                    /* slot 0 is newer */
+    {
+        journal->slot = 0;                                                                     /* set slot */
+    }
+    else if (good[1] != 0)                                                                     /* slot 1 is newer */
+    {
+        journal->slot = 1;                                                                     /* set slot */
+    }
+    else                                                                                       /* blank area */
+    {
+        if (a_ds2431_journal_commit(journal, 0, 0, 0) != 0)                                    /* format */
+        {
+            return 1;                                                                          /* return error */
+        }
+        journal->slot = 0;                                                                     /* set slot */
+        generation[0] = 0;                                                                     /* set generation */
+        map[0] = 0;                                                                            /* bank a */
+    }
+    journal->generation = generation[journal->slot];                                           /* set generation */
+    journal->map = map[journal->slot];                                                         /* set map */
+    journal->inited = 1;                                                                       /* flag finish initialization */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      read logical data
+ * @param[in]  *journal pointer to a ds2431 journal structure
+ * @param[in]  offset logical offset
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 journal is NULL
+ *             - 3 journal is not initialized
+ *             - 4 offset and len are invalid
+ * @note       none
+ */
+uint8_t ds2431_journal_read(ds2431_journal_t *journal, uint8_t offset, uint8_t *data, uint8_t len)
+{
+    uint8_t row;
+    uint8_t off;
+    uint8_t n;
+    
+    if (journal == NULL)                                                                  /* check journal */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (journal->inited != 1)                                                             /* check journal initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if ((offset + len) > (journal->rows * 8))                                             /* check offset */
+    {
+        journal->handle->ops->debug_print("ds2431: offset and len are invalid.\n");       /* offset and len are invalid */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    while (len != 0)                                                                      /* every row */
+    {
+        row = offset / 8;                                                                 /* logical row */
+        off = offset % 8;                                                                 /* row offset */
+        n = (uint8_t)(8 - off);                                                           /* row remain */
+        if (n > len)                                                                      /* check length */
+        {
+            n = len;                                                                      /* set remain */
+        }
+        if (ds2431_read(journal->handle,
+                        (uint8_t)(a_ds2431_journal_row(journal, row, (journal->map >> row) & 0x01) + off),
+                        data, n) != 0)                                                    /* read current bank */
+        {
+            return 1;                                                                     /* return error */
+        }
+        offset += n;                                                                      /* next offset */
+        data += n;                                                                        /* next data */
+        len -= n;                                                                         /* len - n */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     update logical data atomically
+ * @param[in] *journal pointer to a ds2431 journal structure
+ * @param[in] offset logical offset
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 journal is NULL
+ *            - 3 journal is not initialized
+ *            - 4 offset and len are invalid
+ *            - 5 handle is in write back mode
+ * @note      after a power loss the next ds2431_journal_init sees either all or none
+ *            of the update, only changed rows and one commit row are programmed
+ */
+uint8_t ds2431_journal_write(ds2431_journal_t *journal, uint8_t offset, uint8_t *data, uint8_t len)
+{
+    uint8_t row;
+    uint8_t off;
+    uint8_t n;
+    uint8_t bank;
+    uint16_t map;
+    uint8_t old[8];
+    uint8_t buf[8];
+    
+    if (journal == NULL)                                                                  /* check journal */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (journal->inited != 1)                                                             /* check journal initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if ((offset + len) > (journal->rows * 8))                                             /* check offset */
+    {
+        journal->handle->ops->debug_print("ds2431: offset and len are invalid.\n");       /* offset and len are invalid */
+        
+        return 4;                                                                         /* return error */
+    }
+    if ((journal->handle->ext != NULL) && (journal->handle->ext->cache != NULL) &&
+        (journal->handle->ext->cache->write_back != 0))                                   /* check write back */
+    {
+        journal->handle->ops->debug_print("ds2431: handle is in write back mode.\n");     /* handle is in write back mode */
+        
+        return 5;                                                                         /* return error */
+    }
+    
+    map = journal->map;                                                                   /* copy map */
+    while (len != 0)                                                                      /* every row */
+    {
+        row = offset / 8;                                                                 /* logical row */
+        off = offset % 8;                                                                 /* row offset */
+        n = (uint8_t)(8 - off);                                                           /* row remain */
+        if (n > len)                                                                      /* check length */
+        {
+            n = len;                                                                      /* set remain */
+        }
+        bank = (journal->map >> row) & 0x01;                                              /* current bank */
+        if (ds2431_read(journal->handle, a_ds2431_journal_row(journal, row, bank),
+                        old, 8) != 0)                                                     /* read current row */
+        {
+            return 1;                                                                     /* return error */
+        }
+        memcpy(buf, old, 8);                                                              /* copy row */
+        memcpy(&buf[off], data, n);                                                       /* merge */
+        if (memcmp(buf, old, 8) != 0)                                                     /* check changed */
+        {
+            if (ds2431_write(journal->handle, a_ds2431_journal_row(journal, row, bank ^ 0x01),
+                             buf, 8) != 0)                                                /* write the other bank */
+            {
+                return 1;                                                                 /* return error */
+            }
+            map ^= (uint16_t)(1U << row);                                                 /* flip row */
+        }
+        offset += n;                                                                      /* next offset */
+        data += n;                                                                        /* next data */
+        len -= n;                                                                         /* len - n */
+    }
+    if (map == journal->map)                                                              /* check changed */
+    {
+        return 0;                                                                         /* nothing to commit */
+    }
+    
+    if (a_ds2431_journal_commit(journal, journal->slot ^ 0x01,
+                                (uint16_t)(journal->generation + 1), map) != 0)           /* commit */
+    {
+        return 1;                                                                         /* return error */
+    }
+    journal->slot ^= 0x01;                                                                /* switch slot */
+    journal->generation++;                                                                /* generation++ */
+    journal->map = map;                                                                   /* set map */
+    
+    return 0;                                                                             /* success return 0 */
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_journal.h
+ * @brief     driver ds2431 journal header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS2431_JOURNAL_H
+#define DRIVER_DS2431_JOURNAL_H
+
+#include "driver_ds2431.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds2431_journal_driver ds2431 journal driver function
+ * @brief    ds2431 journal driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 journal max rows definition
+ */
+#define DS2431_JOURNAL_MAX_ROWS        7        /**< 2 banks and 2 commit rows must fit 16 rows */
+
+/**
+ * @brief ds2431 journal structure definition
+ * @note  every logical row has a copy in bank a and bank b, the commit row says which one
+ *        is current, an update writes the changed rows into the other bank and then
+ *        flips them all at once with one commit row, the two commit rows alternate
+ *        and carry a generation and a crc16, so a torn commit falls back to the previous one
+ */
+typedef struct ds2431_journal_s
+{
+    ds2431_handle_t *handle;        /**< chip handle */
+    uint8_t address;                /**< first row address of the journal area */
+    uint8_t rows;                   /**< logical rows */
+    uint8_t slot;                   /**< commit row holding the current generation */
+    uint16_t generation;            /**< current generation */
+    uint16_t map;                   /**< bit n is set if logical row n lives in bank b */
+    uint8_t inited;                 /**< inited flag */
+} ds2431_journal_t;
+
+/**
+ * @brief     open a journal area and recover it
+ * @param[in] *journal pointer to a ds2431 journal structure
+ * @param[in] *handle pointer to an initialized ds2431 handle structure
+ * @param[in] address first row address of the area
+ * @param[in] rows logical rows
+ * @return    status code
+ *            - 0 success
+ *            - 1 recover failed
+ *            - 2 journal is NULL
+ *            - 3 handle is invalid
+ *            - 4 address and rows are invalid
+ * @note      the area uses (2 * rows + 2) rows from address, call it right after ds2431_init,
+ *            the newest commit row with a good crc16 wins, which rolls an update that
+ *            reached its commit forward and an interrupted one back,
+ *            an area without any good commit row is formatted with bank a current
+ */
+uint8_t ds2431_journal_init(ds2431_journal_t *journal, ds2431_handle_t *handle, uint8_t address, uint8_t rows);
+
+/**
+ * @brief      read logical data
+ * @param[in]  *journal pointer to a ds2431 journal structure
+ * @param[in]  offset logical offset
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 journal is NULL
+ *             - 3 journal is not initialized
+ *             - 4 offset and len are invalid
+ * @note       none
+ */
+uint8_t ds2431_journal_read(ds2431_journal_t *journal, uint8_t offset, uint8_t *data, uint8_t len);
+
+/**
+ * @brief     update logical data atomically
+ * @param[in] *journal pointer to a ds2431 journal structure
+ * @param[in] offset logical offset
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 journal is NULL
+ *            - 3 journal is not initialized
+ *            - 4 offset and len are invalid
+ *            - 5 handle is in write back mode
+ * @note      after a power loss the next ds2431_journal_init sees either all or none
+ *            of the update, only changed rows and one commit row are programmed
+ */
+uint8_t ds2431_journal_write(ds2431_journal_t *journal, uint8_t offset, uint8_t *data, uint8_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,430 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_kv.c
+ * @brief     driver ds2431 kv source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_kv.h"
+
+/**
+ * @brief kv magic definition
+ */
+#define DS2431_KV_MAGIC        0x4B        /**< index row magic */
+
+/**
+ * @brief      build an index row
+ * @param[in]  used used row mask
+ * @param[in]  start entry start mask
+ * @param[out] *buf pointer to a row buffer
+ * @note       none
+ */
+static void a_ds2431_kv_index(uint16_t used, uint16_t start, uint8_t buf[8])
+{
+    uint16_t crc;
+    
+    buf[0] = DS2431_KV_MAGIC;             /* magic */
+    buf[1] = 0x00;                        /* reserved */
+    buf[2] = (used >> 0) & 0xFF;          /* used lsb */
+    buf[3] = (used >> 8) & 0xFF;          /* used msb */
+    buf[4] = (start >> 0) & 0xFF;         /* start lsb */
+    buf[5] = (start >> 8) & 0xFF;         /* start msb */
+    crc = ds2431_crc16(0, buf, 6);        /* crc16 */
+    buf[6] = (crc >> 0) & 0xFF;           /* crc16 lsb */
+    buf[7] = (crc >> 8) & 0xFF;           /* crc16 msb */
+}
+
+/**
+ * @brief     program the index row
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] used used row mask
+ * @param[in] start entry start mask
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds2431_kv_commit(ds2431_kv_t *kv, uint16_t used, uint16_t start)
+{
+    uint8_t buf[8];
+    
+    a_ds2431_kv_index(used, start, buf);                    /* build index */
+    if (memcmp(buf, kv->image, 8) == 0)                     /* check changed */
+    {
+        return 0;                                           /* success return 0 */
+    }
+    if (ds2431_write(kv->handle, 0x00, buf, 8) != 0)        /* program index row */
+    {
+        return 1;                                           /* return error */
+    }
+    memcpy(kv->image, buf, 8);                              /* update image */
+    kv->used = used;                                        /* set used */
+    kv->start = start;                                      /* set start */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief     rebuild the directory from the image
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 directory is corrupted
+ * @note      none
+ */
+static uint8_t a_ds2431_kv_scan(ds2431_kv_t *kv)
+{
+    uint8_t row;
+    uint8_t end;
+    ds2431_kv_entry_t *e;
+    
+    kv->count = 0;                                                                      /* init 0 */
+    for (row = 1; row < 16; row++)                                                      /* every data row */
+    {
+        if ((kv->start & (1U << row)) == 0)                                             /* check start */
+        {
+            continue;                                                                   /* next row */
+        }
+        e = &kv->entry[kv->count];                                                      /* get entry */
+        e->row = row;                                                                   /* set row */
+        e->key_len = kv->image[row * 8 + 0];                                            /* key length */
+        e->value_len = kv->image[row * 8 + 1];                                          /* value length */
+        e->rows = (uint8_t)((2 + e->key_len + e->value_len + 7) / 8);                   /* row number */
+        end = (uint8_t)(row + e->rows);                                                 /* end row */
+        if ((e->key_len == 0) || (e->key_len > DS2431_KV_MAX_KEY) || (end > 16))        /* check entry */
+        {
+            return 1;                                                                   /* return error */
+        }
+        kv->count++;                                                                    /* count++ */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     find a key
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] *key pointer to a key string
+ * @param[in] key_len key length
+ * @return    entry index or -1 if not found
+ * @note      none
+ */
+static int8_t a_ds2431_kv_find(ds2431_kv_t *kv, const char *key, uint8_t key_len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < kv->count; i++)                                                   /* every entry */
+    {
+        if ((kv->entry[i].key_len == key_len) &&
+            (memcmp(&kv->image[kv->entry[i].row * 8 + 2], key, key_len) == 0))       /* check key */
+        {
+            return (int8_t)i;                                                         /* found */
+        }
+    }
+    
+    return -1;                                                                        /* not found */
+}
+
+/**
+ * @brief     program the rows of an entry that differ from the image
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] row first row
+ * @param[in] *buf pointer to the entry rows
+ * @param[in] rows row number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds2431_kv_program(ds2431_kv_t *kv, uint8_t row, uint8_t *buf, uint8_t rows)
+{
+    uint8_t i;
+    
+    for (i = 0; i < rows; i++)                                                             /* every row */
+    {
+        if (memcmp(&kv->image[(row + i) * 8], &buf[i * 8], 8) == 0)                        /* check changed */
+        {
+            continue;                                                                      /* skip */
+        }
+        if (ds2431_write(kv->handle, (uint8_t)((row + i) * 8), &buf[i * 8], 8) != 0)       /* program row */
+        {
+            return 1;                                                                      /* return error */
+        }
+        memcpy(&kv->image[(row + i) * 8], &buf[i * 8], 8);                                 /* update image */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     mount the kv store
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] *handle pointer to an initialized ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 kv is NULL
+ *            - 3 handle is invalid
+ *            - 4 store is corrupted
+ * @note      the 128 bytes are read once, a blank or foreign index row is formatted
+ */
+uint8_t ds2431_kv_mount(ds2431_kv_t *kv, ds2431_handle_t *handle)
+{
+    uint16_t crc;
+    
+    if (kv == NULL)                                                                         /* check kv */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if ((handle == NULL) || (handle->inited != 1))                                          /* check handle */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    kv->handle = handle;                                                                    /* set handle */
+    kv->inited = 0;                                                                         /* not mounted */
+    if (ds2431_read(handle, 0x00, kv->image, 128) != 0)                                     /* read all */
+    {
+        return 1;                                                                           /* return error */
+    }
+    crc = (uint16_t)(((uint16_t)kv->image[7] << 8) | kv->image[6]);                         /* get crc16 */
+    if ((kv->image[0] != DS2431_KV_MAGIC) || (ds2431_crc16(0, kv->image, 6) != crc))        /* check index row */
+    {
+        handle->ops->debug_print("ds2431: format kv store.\n");                             /* format kv store */
+        memset(kv->image, 0xFF, 8);                                                         /* force the write */
+        if (a_ds2431_kv_commit(kv, 0x0001, 0x0000) != 0)                                    /* empty index */
+        {
+            return 1;                                                                       /* return error */
+        }
+    }
+    kv->used = (uint16_t)(((uint16_t)kv->image[3] << 8) | kv->image[2]);                    /* get used */
+    kv->start = (uint16_t)(((uint16_t)kv->image[5] << 8) | kv->image[4]);                   /* get start */
+    if (a_ds2431_kv_scan(kv) != 0)                                                          /* build directory */
+    {
+        handle->ops->debug_print("ds2431: store is corrupted.\n");                          /* store is corrupted */
+        
+        return 4;                                                                           /* return error */
+    }
+    kv->inited = 1;                                                                         /* flag finish initialization */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief         get a value
+ * @param[in]     *kv pointer to a ds2431 kv structure
+ * @param[in]     *key pointer to a key string
+ * @param[out]    *value pointer to a value buffer
+ * @param[in,out] *len pointer to a length buffer, buffer size in and value length out
+ * @return        status code
+ *                - 0 success
+ *                - 2 kv is NULL
+ *                - 3 kv is not mounted
+ *                - 4 key is not found
+ *                - 5 buffer is too small
+ * @note          served from RAM without bus traffic
+ */
+uint8_t ds2431_kv_get(ds2431_kv_t *kv, const char *key, uint8_t *value, uint8_t *len)
+{
+    int8_t i;
+    ds2431_kv_entry_t *e;
+    
+    if (kv == NULL)                                                                   /* check kv */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (kv->inited != 1)                                                              /* check kv mount */
+    {
+        return 3;                                                                     /* return error */
+    }
+    
+    i = a_ds2431_kv_find(kv, key, (uint8_t)strlen(key));                              /* find key */
+    if (i < 0)                                                                        /* check found */
+    {
+        return 4;                                                                     /* return error */
+    }
+    e = &kv->entry[i];                                                                /* get entry */
+    if (*len < e->value_len)                                                          /* check buffer */
+    {
+        *len = e->value_len;                                                          /* set needed length */
+        
+        return 5;                                                                     /* return error */
+    }
+    memcpy(value, &kv->image[e->row * 8 + 2 + e->key_len], e->value_len);            /* copy value */
+    *len = e->value_len;                                                              /* set length */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     set a value
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] *key pointer to a key string
+ * @param[in] *value pointer to a value buffer
+ * @param[in] len value length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not mounted
+ *            - 4 key is invalid
+ *            - 5 no space left
+ * @note      a value that keeps its row number is rewritten in place and only the changed
+ *            rows are programmed, otherwise the entry is written to free rows and the
+ *            index row is programmed last
+ */
+uint8_t ds2431_kv_set(ds2431_kv_t *kv, const char *key, const uint8_t *value, uint8_t len)
+{
+    int8_t i;
+    uint8_t row;
+    uint8_t run;
+    uint8_t rows;
+    uint8_t key_len;
+    uint16_t mask;
+    uint16_t used;
+    uint16_t start;
+    uint8_t buf[120];
+    
+    if (kv == NULL)                                                                   /* check kv */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (kv->inited != 1)                                                              /* check kv mount */
+    {
+        return 3;                                                                     /* return error */
+    }
+    key_len = (uint8_t)strlen(key);                                                   /* get key length */
+    if ((key_len == 0) || (key_len > DS2431_KV_MAX_KEY) ||
+        ((2 + key_len + len) > (15 * 8)))                                          /* check key */
+    {
+        kv->handle->ops->debug_print("ds2431: key is invalid.\n");                    /* key is invalid */
+        
+        return 4;                                                                     /* return error */
+    }
+    
+    rows = (uint8_t)((2 + key_len + len + 7) / 8);                                    /* row number */
+    memset(buf, 0xFF, sizeof(buf));                                                   /* erased pattern */
+    buf[0] = key_len;                                                                 /* key length */
+    buf[1] = len;                                                                     /* value length */
+    memcpy(&buf[2], key, key_len);                                                    /* key */
+    memcpy(&buf[2 + key_len], value, len);                                            /* value */
+    i = a_ds2431_kv_find(kv, key, key_len);                                           /* find key */
+    if ((i >= 0) && (kv->entry[i].rows == rows))                                      /* same size */
+    {
+        if (a_ds2431_kv_program(kv, kv->entry[i].row, buf, rows) != 0)                /* rewrite in place */
+        {
+            return 1;                                                                 /* return error */
+        }
+        kv->entry[i].value_len = len;                                                 /* set length */
+        
+        return 0;                                                                     /* success return 0 */
+    }
+    
+    run = 0;                                                                          /* init 0 */
+    for (row = 1; row < 16; row++)                                                    /* first fit */
+    {
+        run = ((kv->used & (1U << row)) == 0) ? (uint8_t)(run + 1) : 0;               /* free run */
+        if (run == rows)                                                              /* check run */
+        {
+            break;                                                                    /* found */
+        }
+    }
+    if (run != rows)                                                                  /* check space */
+    {
+        kv->handle->ops->debug_print("ds2431: no space left.\n");                     /* no space left */
+        
+        return 5;                                                                     /* return error */
+    }
+    row = (uint8_t)(row + 1 - rows);                                                  /* first row */
+    if (a_ds2431_kv_program(kv, row, buf, rows) != 0)                                 /* write the entry */
+    {
+        return 1;                                                                     /* return error */
+    }
+    mask = (uint16_t)(((1U << rows) - 1) << row);                                     /* entry rows */
+    used = kv->used | mask;                                                           /* allocate */
+    start = kv->start | (uint16_t)(1U << row);                                        /* new start */
+    if (i >= 0)                                                                       /* replace */
+    {
+        used &= ~(uint16_t)(((1U << kv->entry[i].rows) - 1) << kv->entry[i].row);     /* free old rows */
+        start &= ~(uint16_t)(1U << kv->entry[i].row);                                 /* drop old start */
+    }
+    if (a_ds2431_kv_commit(kv, used, start) != 0)                                     /* program index row */
+    {
+        return 1;                                                                     /* return error */
+    }
+    (void)a_ds2431_kv_scan(kv);                                                       /* rebuild directory */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     delete a value
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] *key pointer to a key string
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not mounted
+ *            - 4 key is not found
+ * @note      only the index row is programmed
+ */
+uint8_t ds2431_kv_delete(ds2431_kv_t *kv, const char *key)
+{
+    int8_t i;
+    uint16_t used;
+    uint16_t start;
+    
+    if (kv == NULL)                                                                              /* check kv */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (kv->inited != 1)                                                                         /* check kv mount */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    i = a_ds2431_kv_find(kv, key, (uint8_t)strlen(key));                                         /* find key */
+    if (i < 0)                                                                                   /* check found */
+    {
+        return 4;                                                                                /* return error */
+    }
+    used = kv->used & (uint16_t)(~(((1U << kv->entry[i].rows) - 1) << kv->entry[i].row));        /* free rows */
+    start = kv->start & (uint16_t)(~(1U << kv->entry[i].row));                                   /* drop start */
+    if (a_ds2431_kv_commit(kv, used, start) != 0)                                                /* program index row */
+    {
+        return 1;                                                                                /* return error */
+    }
+    (void)a_ds2431_kv_scan(kv);                                                                  /* rebuild directory */
+    
+    return 0;                                                                                    /* success return 0 */
+}
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_kv.h
+ * @brief     driver ds2431 kv header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS2431_KV_H
+#define DRIVER_DS2431_KV_H
+
+#include "driver_ds2431.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds2431_kv_driver ds2431 kv driver function
+ * @brief    ds2431 kv driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 kv definition
+ */
+#define DS2431_KV_MAX_ENTRY        15        /**< one entry per data row at most */
+#define DS2431_KV_MAX_KEY          8         /**< max key length */
+
+/**
+ * @brief ds2431 kv entry structure definition
+ */
+typedef struct ds2431_kv_entry_s
+{
+    uint8_t row;            /**< first row */
+    uint8_t rows;           /**< row number */
+    uint8_t key_len;        /**< key length */
+    uint8_t value_len;      /**< value length */
+} ds2431_kv_entry_t;
+
+/**
+ * @brief ds2431 kv structure definition
+ * @note  row 0 is the index row: magic, used row mask, entry start mask and crc16,
+ *        an entry starts on a row with key length, value length, key and value,
+ *        the index, the directory and the image are kept in RAM after mount
+ */
+typedef struct ds2431_kv_s
+{
+    ds2431_handle_t *handle;                              /**< chip handle */
+    uint8_t image[128];                                   /**< memory image */
+    uint16_t used;                                        /**< bit n is set if row n is used */
+    uint16_t start;                                       /**< bit n is set if an entry starts at row n */
+    ds2431_kv_entry_t entry[DS2431_KV_MAX_ENTRY];         /**< directory */
+    uint8_t count;                                        /**< entry number */
+    uint8_t inited;                                       /**< inited flag */
+} ds2431_kv_t;
+
+/**
+ * @brief     mount the kv store
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] *handle pointer to an initialized ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 kv is NULL
+ *            - 3 handle is invalid
+ *            - 4 store is corrupted
+ * @note      the 128 bytes are read once, a blank or foreign index row is formatted
+ */
+uint8_t ds2431_kv_mount(ds2431_kv_t *kv, ds2431_handle_t *handle);
+
+/**
+ * @brief         get a value
+ * @param[in]     *kv pointer to a ds2431 kv structure
+ * @param[in]     *key pointer to a key string
+ * @param[out]    *value pointer to a value buffer
+ * @param[in,out] *len pointer to a length buffer, buffer size in and value length out
+ * @return        status code
+ *                - 0 success
+ *                - 2 kv is NULL
+ *                - 3 kv is not mounted
+ *                - 4 key is not found
+ *                - 5 buffer is too small
+ * @note          served from RAM without bus traffic
+ */
+uint8_t ds2431_kv_get(ds2431_kv_t *kv, const char *key, uint8_t *value, uint8_t *len);
+
+/**
+ * @brief     set a value
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] *key pointer to a key string
+ * @param[in] *value pointer to a value buffer
+ * @param[in] len value length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not mounted
+ *            - 4 key is invalid
+ *            - 5 no space left
+ * @note      a value that keeps its row number is rewritten in place and only the changed
+ *            rows are programmed, otherwise the entry is written to free rows and the
+ *            index row is programmed last
+ */
+uint8_t ds2431_kv_set(ds2431_kv_t *kv, const char *key, const uint8_t *value, uint8_t len);
+
+/**
+ * @brief     delete a value
+ * @param[in] *kv pointer to a ds2431 kv structure
+ * @param[in] *key pointer to a key string
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not mounted
+ *            - 4 key is not found
+ * @note      only the index row is programmed
+ */
+uint8_t ds2431_kv_delete(ds2431_kv_t *kv, const char *key);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
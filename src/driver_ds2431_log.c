@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_log.c
+ * @brief     driver ds2431 log source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_log.h"
+
+/**
+ * @brief log crc definition
+ */
+#define DS2431_LOG_CRC_SEED        0x4C4F        /**< crc16 seed of a record */
+
+/**
+ * @brief     get the check value of a record
+ * @param[in] *buf pointer to a row buffer
+ * @return    inverted crc16 of the first 6 bytes
+ * @note      the seed and the inversion keep blank 0xFF rows, zeroed rows
+ *            and crc16 protected rows of the other modules from parsing as records
+ */
+static uint16_t a_ds2431_log_crc(uint8_t buf[8])
+{
+    return (uint16_t)(~ds2431_crc16(DS2431_LOG_CRC_SEED, buf, 6));        /* seeded and inverted crc16 */
+}
+
+/**
+ * @brief      parse a record row
+ * @param[in]  *buf pointer to a row buffer
+ * @param[out] *sequence pointer to a sequence buffer
+ * @return     1 if the row is a good record, 0 if not
+ * @note       none
+ */
+static uint8_t a_ds2431_log_parse(uint8_t buf[8], uint16_t *sequence)
+{
+    uint16_t crc;
+    
+    crc = (uint16_t)(((uint16_t)buf[7] << 8) | buf[6]);                  /* get crc16 */
+    if (a_ds2431_log_crc(buf) != crc)                                    /* check crc16 */
+    {
+        return 0;                                                        /* not a record */
+    }
+    *sequence = (uint16_t)(((uint16_t)buf[1] << 8) | buf[0]);            /* get sequence */
+    
+    return 1;                                                            /* good record */
+}
+
+/**
+ * @brief     mount a ring log and find its head
+ * @param[in] *log pointer to a ds2431 log structure
+ * @param[in] *handle pointer to an initialized ds2431 handle structure
+ * @param[in] address first row address of the ring
+ * @param[in] rows ring rows
+ * @return    status code
+ *            - 0 success
+ *            - 1 scan failed
+ *            - 2 log is NULL
+ *            - 3 handle is invalid
+ *            - 4 address and rows are invalid
+ * @note      the whole ring is read with one ds2431_read, the newest record with a good
+ *            crc16 is the head and the records before it with consecutive sequences are kept
+ */
+uint8_t ds2431_log_init(ds2431_log_t *log, ds2431_handle_t *handle, uint8_t address, uint8_t rows)
+{
+    uint8_t i;
+    uint8_t row;
+    uint8_t found;
+    uint16_t seq;
+    uint16_t expect;
+    uint8_t buf[128];
+    
+    if (log == NULL)                                                                  /* check log */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if ((handle == NULL) || (handle->inited != 1))                                    /* check handle */
+    {
+        return 3;                                                                     /* return error */
+    }
+    if ((rows < 2) || ((address % 8) != 0) || ((address + rows * 8) > 0x80))          /* check ring */
+    {
+        handle->ops->debug_print("ds2431: address and rows are invalid.\n");          /* address and rows are invalid */
+        
+        return 4;                                                                     /* return error */
+    }
+    
+    log->handle = handle;                                                             /* set handle */
+    log->address = address;                                                           /* set address */
+    log->rows = rows;                                                                 /* set rows */
+    log->inited = 0;                                                                  /* not ready */
+    if (ds2431_read(handle, address, buf, (uint8_t)(rows * 8)) != 0)                  /* read the ring */
+    {
+        return 1;                                                                     /* return error */
+    }
+    found = 0;                                                                        /* init 0 */
+    log->head = (uint8_t)(rows - 1);                                                  /* empty head */
+    log->sequence = 0xFFFFU;                                                          /* empty sequence */
+    for (i = 0; i < rows; i++)                                                        /* find the newest */
+    {
+        if (a_ds2431_log_parse(&buf[i * 8], &seq) == 0)                               /* parse row */
+        {
+            continue;                                                                 /* skip */
+        }
+        if ((found == 0) || ((int16_t)(seq - log->sequence) > 0))                     /* check newer */
+        {
+            found = 1;                                                                /* found */
+            log->head = i;                                                            /* set head */
+            log->sequence = seq;                                                      /* set sequence */
+        }
+    }
+    log->count = 0;                                                                   /* init 0 */
+    if (found != 0)                                                                   /* check found */
+    {
+        expect = log->sequence;                                                       /* newest */
+        row = log->head;                                                              /* from head */
+        for (i = 0; i < rows; i++)                                                    /* walk back */
+        {
+            if ((a_ds2431_log_parse(&buf[row * 8], &seq) == 0) || (seq != expect))    /* check chain */
+            {
+                break;                                                                /* stop */
+            }
+            log->count++;                                                             /* count++ */
+            expect--;                                                                 /* previous sequence */
+            row = (uint8_t)((row + rows - 1) % rows);                                 /* previous row */
+        }
+    }
+    log->inited = 1;                                                                  /* flag finish initialization */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      append a record
+ * @param[in]  *log pointer to a ds2431 log structure
+ * @param[in]  *payload pointer to a payload buffer
+ * @param[out] *sequence pointer to a sequence buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 append failed
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ * @note       costs one row program, the oldest record is overwritten when the ring is full
+ */
+uint8_t ds2431_log_append(ds2431_log_t *log, uint8_t payload[DS2431_LOG_PAYLOAD], uint16_t *sequence)
+{
+    uint8_t row;
+    uint16_t seq;
+    uint16_t crc;
+    uint8_t buf[8];
+    
+    if (log == NULL)                                                                  /* check log */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (log->inited != 1)                                                             /* check log initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    
+    row = (uint8_t)((log->head + 1) % log->rows);                                     /* next row */
+    seq = (uint16_t)(log->sequence + 1);                                              /* next sequence */
+    buf[0] = (seq >> 0) & 0xFF;                                                       /* sequence lsb */
+    buf[1] = (seq >> 8) & 0xFF;                                                       /* sequence msb */
+    memcpy(&buf[2], payload, DS2431_LOG_PAYLOAD);                                     /* payload */
+    crc = a_ds2431_log_crc(buf);                                                      /* crc16 */
+    buf[6] = (crc >> 0) & 0xFF;                                                       /* crc16 lsb */
+    buf[7] = (crc >> 8) & 0xFF;                                                       /* crc16 msb */
+    if (ds2431_write(log->handle, (uint8_t)(log->address + row * 8), buf, 8) != 0)    /* program one row */
+    {
+        return 1;                                                                     /* return error */
+    }
+    log->head = row;                                                                  /* set head */
+    log->sequence = seq;                                                              /* set sequence */
+    if (log->count < log->rows)                                                       /* check full */
+    {
+        log->count++;                                                                 /* count++ */
+    }
+    if (sequence != NULL)                                                             /* check sequence buffer */
+    {
+        *sequence = seq;                                                              /* set sequence */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      read a record
+ * @param[in]  *log pointer to a ds2431 log structure
+ * @param[in]  index record index, 0 is the oldest
+ * @param[out] *payload pointer to a payload buffer
+ * @param[out] *sequence pointer to a sequence buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ *             - 4 index is invalid
+ *             - 5 record is corrupted
+ * @note       none
+ */
+uint8_t ds2431_log_read(ds2431_log_t *log, uint8_t index, uint8_t payload[DS2431_LOG_PAYLOAD], uint16_t *sequence)
+{
+    uint8_t row;
+    uint16_t seq;
+    uint8_t buf[8];
+    
+    if (log == NULL)                                                                  /* check log */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (log->inited != 1)                                                             /* check log initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    if (index >= log->count)                                                          /* check index */
+    {
+        return 4;                                                                     /* return error */
+    }
+    
+    row = (uint8_t)((log->head + log->rows + 1 - log->count + index) % log->rows);    /* get row */
+    if (ds2431_read(log->handle, (uint8_t)(log->address + row * 8), buf, 8) != 0)     /* read row */
+    {
+        return 1;                                                                     /* return error */
+    }
+    if (a_ds2431_log_parse(buf, &seq) == 0)                                           /* parse row */
+    {
+        log->handle->ops->debug_print("ds2431: record is corrupted.\n");              /* record is corrupted */
+        
+        return 5;                                                                     /* return error */
+    }
+    memcpy(payload, &buf[2], DS2431_LOG_PAYLOAD);                                     /* copy payload */
+    if (sequence != NULL)                                                             /* check sequence buffer */
+    {
+        *sequence = seq;                                                              /* set sequence */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the record number
+ * @param[in]  *log pointer to a ds2431 log structure
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ * @note       none
+ */
+uint8_t ds2431_log_get_count(ds2431_log_t *log, uint8_t *count)
+{
+    if (log == NULL)                  /* check log */
+    {
+        return 2;                     /* return error */
+    }
+    if (log->inited != 1)             /* check log initialization */
+    {
+        return 3;                     /* return error */
+    }
+    
+    *count = log->count;              /* get count */
+    
+    return 0;                         /* success return 0 */
+}
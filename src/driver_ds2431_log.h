@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_log.h
+ * @brief     driver ds2431 log header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS2431_LOG_H
+#define DRIVER_DS2431_LOG_H
+
+#include "driver_ds2431.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds2431_log_driver ds2431 log driver function
+ * @brief    ds2431 log driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 log payload definition
+ */
+#define DS2431_LOG_PAYLOAD        4        /**< payload bytes per record */
+
+/**
+ * @brief ds2431 log structure definition
+ * @note  one record per row: sequence (2 bytes), payload (4 bytes), seeded and inverted crc16 (2 bytes),
+ *        records are appended to the row after the head so every row is programmed
+ *        once per lap of the ring
+ */
+typedef struct ds2431_log_s
+{
+    ds2431_handle_t *handle;        /**< chip handle */
+    uint8_t address;                /**< first row address of the ring */
+    uint8_t rows;                   /**< ring rows */
+    uint8_t head;                   /**< row index of the newest record */
+    uint8_t count;                  /**< valid records */
+    uint16_t sequence;              /**< sequence of the newest record */
+    uint8_t inited;                 /**< inited flag */
+} ds2431_log_t;
+
+/**
+ * @brief     mount a ring log and find its head
+ * @param[in] *log pointer to a ds2431 log structure
+ * @param[in] *handle pointer to an initialized ds2431 handle structure
+ * @param[in] address first row address of the ring
+ * @param[in] rows ring rows
+ * @return    status code
+ *            - 0 success
+ *            - 1 scan failed
+ *            - 2 log is NULL
+ *            - 3 handle is invalid
+ *            - 4 address and rows are invalid
+ * @note      the whole ring is read with one ds2431_read, the newest record with a good
+ *            crc16 is the head and the records before it with consecutive sequences are kept
+ */
+uint8_t ds2431_log_init(ds2431_log_t *log, ds2431_handle_t *handle, uint8_t address, uint8_t rows);
+
+/**
+ * @brief      append a record
+ * @param[in]  *log pointer to a ds2431 log structure
+ * @param[in]  *payload pointer to a payload buffer
+ * @param[out] *sequence pointer to a sequence buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 append failed
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ * @note       costs one row program, the oldest record is overwritten when the ring is full
+ */
+uint8_t ds2431_log_append(ds2431_log_t *log, uint8_t payload[DS2431_LOG_PAYLOAD], uint16_t *sequence);
+
+/**
+ * @brief      read a record
+ * @param[in]  *log pointer to a ds2431 log structure
+ * @param[in]  index record index, 0 is the oldest
+ * @param[out] *payload pointer to a payload buffer
+ * @param[out] *sequence pointer to a sequence buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ *             - 4 index is invalid
+ *             - 5 record is corrupted
+ * @note       none
+ */
+uint8_t ds2431_log_read(ds2431_log_t *log, uint8_t index, uint8_t payload[DS2431_LOG_PAYLOAD], uint16_t *sequence);
+
+/**
+ * @brief      get the record number
+ * @param[in]  *log pointer to a ds2431 log structure
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 log is NULL
+ *             - 3 log is not initialized
+ * @note       none
+ */
+uint8_t ds2431_log_get_count(ds2431_log_t *log, uint8_t *count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,796 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_multi.c
+ * @brief     driver ds2431 multi lane source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_multi.h"
+
+/**
+ * @brief chip command definition
+ */
+#define DS2431_MULTI_CMD_SKIP_ROM                 0xCC        /**< skip rom command */
+#define DS2431_MULTI_CMD_WRITE_SCRATCHPAD         0x0F        /**< write scratchpad command */
+#define DS2431_MULTI_CMD_READ_SCRATCHPAD          0xAA        /**< read scratchpad command */
+#define DS2431_MULTI_CMD_COPY_SCRATCHPAD          0x55        /**< copy scratchpad command */
+#define DS2431_MULTI_CMD_READ_MEMORY              0xF0        /**< read memory command */
+
+/**
+ * @brief all lines released definition
+ */
+#define DS2431_MULTI_RELEASE                      0xFFFFFFFFU        /**< every line released */
+
+/**
+ * @brief row authorization definition
+ */
+#define DS2431_MULTI_ES_MASK                      0xA7        /**< aa, pf and the ending offset */
+#define DS2431_MULTI_ES_ROW                       0x07        /**< a whole row is loaded and not copied yet */
+
+/**
+ * @brief      reset the enabled lanes
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  lane reset lane mask
+ * @param[out] *present pointer to a presence mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 reset failed
+ * @note       none
+ */
+static uint8_t a_ds2431_multi_reset(ds2431_multi_handle_t *handle, uint32_t lane, uint32_t *present)
+{
+    uint8_t retry = 0;
+    uint32_t level;
+    uint32_t seen;
+    
+    seen = 0;                                                                  /* init 0 */
+    handle->ops->disable_irq(handle->user);                                    /* disable irq */
+    if (handle->ops->bus_write_mask(handle->user, ~lane) != 0)                 /* pull the lanes low */
+    {
+        handle->ops->enable_irq(handle->user);                                 /* enable irq */
+        handle->ops->debug_print("ds2431: bus write failed.\n");               /* write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    handle->ops->delay_us(handle->user, DS2431_TIME_RSTL_US);                  /* wait 550 us */
+    if (handle->ops->bus_write_mask(handle->user, DS2431_MULTI_RELEASE) != 0)  /* release all */
+    {
+        handle->ops->enable_irq(handle->user);                                 /* enable irq */
+        handle->ops->debug_print("ds2431: bus write failed.\n");               /* write failed */
+        
+        return 1;                                                              /* return error */
+    }
+    handle->ops->delay_us(handle->user, DS2431_TIME_MSP_US);                   /* wait 15 us */
+    while ((seen != lane) && (retry < 200))                                    /* wait 200 us */
+    {
+        if (handle->ops->bus_read_mask(handle->user, &level) != 0)             /* read the lanes */
+        {
+            handle->ops->enable_irq(handle->user);                             /* enable irq */
+            handle->ops->debug_print("ds2431: bus read failed.\n");            /* read failed */
+            
+            return 1;                                                          /* return error */
+        }
+        seen |= (~level) & lane;                                               /* collect presence */
+        retry++;                                                               /* retry times++ */
+        handle->ops->delay_us(handle->user, DS2431_TIME_POLL_US);              /* delay 1 us */
+    }
+    retry = 0;                                                                 /* reset retry */
+    level = 0;                                                                 /* reset level */
+    while (((level & seen) != seen) && (retry < 240))                          /* wait 240 us */
+    {
+        if (handle->ops->bus_read_mask(handle->user, &level) != 0)             /* read the lanes */
+        {
+            handle->ops->enable_irq(handle->user);                             /* enable irq */
+            handle->ops->debug_print("ds2431: bus read failed.\n");            /* read failed */
+            
+            return 1;                                                          /* return error */
+        }
+        retry++;                                                               /* retry times++ */
+        handle->ops->delay_us(handle->user, DS2431_TIME_POLL_US);              /* delay 1 us */
+    }
+    handle->ops->enable_irq(handle->user);                                     /* enable irq */
+    *present = seen & level;                                                   /* drop stuck low lanes */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     write one byte to the enabled lanes
+ * @param[in] *handle pointer to a ds2431 multi handle structure
+ * @param[in] lane written lane mask
+ * @param[in] *one pointer to the per bit mask of lanes sending 1
+ * @return    status code
+ *            - 0 success
+ *            - 1 write byte failed
+ * @note      none
+ */
+static uint8_t a_ds2431_multi_write_byte(ds2431_multi_handle_t *handle, uint32_t lane, uint32_t one[8])
+{
+    uint8_t j;
+    
+    handle->ops->disable_irq(handle->user);                                       /* disable irq */
+    for (j = 0; j < 8; j++)                                                       /* run 8 times, 8 bits = 1 Byte */
+    {
+        if (handle->ops->bus_write_mask(handle->user, ~lane) != 0)                /* write 0 */
+        {
+            handle->ops->enable_irq(handle->user);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus write failed.\n");              /* write failed */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_us(handle->user, DS2431_TIME_W1L_US);                  /* wait 6 us */
+        if (handle->ops->bus_write_mask(handle->user, (~lane) | one[j]) != 0)     /* release the 1 lanes */
+        {
+            handle->ops->enable_irq(handle->user);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus write failed.\n");              /* write failed */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_us(handle->user,
+                              DS2431_TIME_W0L_US - DS2431_TIME_W1L_US);           /* a 0 is held low for 65 us */
+        if (handle->ops->bus_write_mask(handle->user, DS2431_MULTI_RELEASE) != 0) /* release all */
+        {
+            handle->ops->enable_irq(handle->user);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus write failed.\n");              /* write failed */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_us(handle->user, DS2431_TIME_REC_US);                  /* wait 6 us */
+    }
+    handle->ops->enable_irq(handle->user);                                        /* enable irq */
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      read one byte from the enabled lanes
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  lane read lane mask
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  stride distance between the bytes of two lanes
+ * @return     status code
+ *             - 0 success
+ *             - 1 read byte failed
+ * @note       none
+ */
+static uint8_t a_ds2431_multi_read_byte(ds2431_multi_handle_t *handle, uint32_t lane, uint8_t *data, uint32_t stride)
+{
+    uint8_t j;
+    uint8_t n;
+    uint32_t level[8];
+    
+    handle->ops->disable_irq(handle->user);                                       /* disable irq */
+    for (j = 0; j < 8; j++)                                                       /* 8 bits */
+    {
+        if (handle->ops->bus_write_mask(handle->user, ~lane) != 0)                /* write 0 */
+        {
+            handle->ops->enable_irq(handle->user);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus write failed.\n");              /* write failed */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_us(handle->user, DS2431_TIME_RL_US);                   /* wait 6 us */
+        if (handle->ops->bus_write_mask(handle->user, DS2431_MULTI_RELEASE) != 0) /* write 1 */
+        {
+            handle->ops->enable_irq(handle->user);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus write failed.\n");              /* write failed */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_us(handle->user, DS2431_TIME_MSR_US);                  /* wait 6 us */
+        if (handle->ops->bus_read_mask(handle->user, &level[j]) != 0)             /* sample all lanes */
+        {
+            handle->ops->enable_irq(handle->user);                                /* enable irq */
+            handle->ops->debug_print("ds2431: bus read failed.\n");               /* read failed */
+            
+            return 1;                                                             /* return error */
+        }
+        handle->ops->delay_us(handle->user, DS2431_TIME_RREC_US);                 /* wait 50 us */
+    }
+    handle->ops->enable_irq(handle->user);                                        /* enable irq */
+    
+    for (n = 0; n < DS2431_MULTI_MAX_LANE; n++)                                   /* transpose the samples */
+    {
+        if (((lane >> n) & 0x01) != 0)                                            /* check lane */
+        {
+            uint8_t byte;
+            
+            byte = 0;                                                             /* init 0 */
+            for (j = 0; j < 8; j++)                                               /* 8 bits */
+            {
+                byte |= (uint8_t)(((level[j] >> n) & 0x01) << j);                 /* set bit */
+            }
+            data[n * stride] = byte;                                              /* save byte */
+        }
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      spread one byte to every enabled lane
+ * @param[in]  lane lane mask
+ * @param[in]  byte sent byte
+ * @param[out] *one pointer to the per bit mask of lanes sending 1
+ * @note       none
+ */
+static void a_ds2431_multi_spread(uint32_t lane, uint8_t byte, uint32_t one[8])
+{
+    uint8_t j;
+    
+    for (j = 0; j < 8; j++)                                             /* 8 bits */
+    {
+        one[j] = (((byte >> j) & 0x01) != 0) ? lane : 0;                /* set mask */
+    }
+}
+
+/**
+ * @brief      gather one byte per enabled lane
+ * @param[in]  lane lane mask
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  stride distance between the bytes of two lanes
+ * @param[out] *one pointer to the per bit mask of lanes sending 1
+ * @note       none
+ */
+static void a_ds2431_multi_gather(uint32_t lane, const uint8_t *data, uint32_t stride, uint32_t one[8])
+{
+    uint8_t j;
+    uint8_t n;
+    
+    memset(one, 0, sizeof(uint32_t) * 8);                               /* clear masks */
+    for (n = 0; n < DS2431_MULTI_MAX_LANE; n++)                         /* all lanes */
+    {
+        if (((lane >> n) & 0x01) != 0)                                  /* check lane */
+        {
+            uint8_t byte;
+            
+            byte = data[n * stride];                                    /* get byte */
+            for (j = 0; j < 8; j++)                                     /* 8 bits */
+            {
+                if (((byte >> j) & 0x01) != 0)                          /* check bit */
+                {
+                    one[j] |= (uint32_t)1 << n;                         /* set lane */
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief     send the same byte to every enabled lane
+ * @param[in] *handle pointer to a ds2431 multi handle structure
+ * @param[in] lane lane mask
+ * @param[in] byte sent byte
+ * @return    status code
+ *            - 0 success
+ *            - 1 write byte failed
+ * @note      none
+ */
+static uint8_t a_ds2431_multi_write_common(ds2431_multi_handle_t *handle, uint32_t lane, uint8_t byte)
+{
+    uint32_t one[8];
+    
+    a_ds2431_multi_spread(lane, byte, one);                     /* spread the byte */
+    
+    return a_ds2431_multi_write_byte(handle, lane, one);        /* write the byte */
+}
+
+/**
+ * @brief      select every present lane with reset and skip rom
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  *alive pointer to a live lane mask buffer
+ * @param[out] *fail pointer to a failed lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 select failed
+ * @note       lanes without presence are moved from alive to fail
+ */
+static uint8_t a_ds2431_multi_select(ds2431_multi_handle_t *handle, uint32_t *alive, uint32_t *fail)
+{
+    uint32_t present;
+    
+    if (a_ds2431_multi_reset(handle, *alive, &present) != 0)                              /* reset the lanes */
+    {
+        handle->ops->debug_print("ds2431: bus reset failed.\n");                          /* reset bus failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    *fail |= (*alive) & (~present);                                                       /* flag absent lanes */
+    *alive &= present;                                                                    /* keep present lanes */
+    if (*alive == 0)                                                                      /* check alive */
+    {
+        return 0;                                                                         /* nothing to do */
+    }
+    if (a_ds2431_multi_write_common(handle, *alive, DS2431_MULTI_CMD_SKIP_ROM) != 0)      /* send skip rom command */
+    {
+        handle->ops->debug_print("ds2431: write command failed.\n");                      /* write command failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      initialize the lanes
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  lane enabled lane mask
+ * @param[out] *present pointer to a presence mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 bus initialization failed
+ *             - 2 handle is NULL
+ *             - 3 linked functions is NULL
+ *             - 4 no lane is present
+ * @note       lanes without a presence pulse are dropped from the enabled mask
+ */
+uint8_t ds2431_multi_init(ds2431_multi_handle_t *handle, uint32_t lane, uint32_t *present)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->ops == NULL)                                                /* check ops */
+    {
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->debug_print == NULL)                                   /* check debug_print */
+    {
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->bus_init == NULL)                                      /* check bus_init */
+    {
+        handle->ops->debug_print("ds2431: bus_init is null.\n");            /* bus_init is null */
+        
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->bus_deinit == NULL)                                    /* check bus_deinit */
+    {
+        handle->ops->debug_print("ds2431: bus_deinit is null.\n");          /* bus_deinit is null */
+        
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->bus_read_mask == NULL)                                 /* check bus_read_mask */
+    {
+        handle->ops->debug_print("ds2431: bus_read_mask is null.\n");       /* bus_read_mask is null */
+        
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->bus_write_mask == NULL)                                /* check bus_write_mask */
+    {
+        handle->ops->debug_print("ds2431: bus_write_mask is null.\n");      /* bus_write_mask is null */
+        
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->delay_ms == NULL)                                      /* check delay_ms */
+    {
+        handle->ops->debug_print("ds2431: delay_ms is null.\n");            /* delay_ms is null */
+        
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->delay_us == NULL)                                      /* check delay_us */
+    {
+        handle->ops->debug_print("ds2431: delay_us is null.\n");            /* delay_us is null */
+        
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->enable_irq == NULL)                                    /* check enable_irq */
+    {
+        handle->ops->debug_print("ds2431: enable_irq is null.\n");          /* enable_irq is null */
+        
+        return 3;                                                           /* return error */
+    }
+    if (handle->ops->disable_irq == NULL)                                   /* check disable_irq */
+    {
+        handle->ops->debug_print("ds2431: disable_irq is null.\n");         /* disable_irq is null */
+        
+        return 3;                                                           /* return error */
+    }
+    
+    if (handle->ops->bus_init(handle->user) != 0)                           /* initialize bus */
+    {
+        handle->ops->debug_print("ds2431: bus init failed.\n");             /* bus init failed */
+        
+        return 1;                                                           /* return error */
+    }
+    if (a_ds2431_multi_reset(handle, lane, present) != 0)                   /* reset lanes */
+    {
+        handle->ops->debug_print("ds2431: reset failed.\n");                /* reset failed */
+        (void)handle->ops->bus_deinit(handle->user);                        /* close bus */
+        
+        return 1;                                                           /* return error */
+    }
+    if (*present == 0)                                                      /* check presence */
+    {
+        handle->ops->debug_print("ds2431: no lane is present.\n");          /* no lane is present */
+        (void)handle->ops->bus_deinit(handle->user);                        /* close bus */
+        
+        return 4;                                                           /* return error */
+    }
+    handle->lane = *present;                                                /* save lanes */
+    handle->inited = 1;                                                     /* flag finish initialization */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     close the lanes
+ * @param[in] *handle pointer to a ds2431 multi handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds2431_multi_deinit(ds2431_multi_handle_t *handle)
+{
+    if (handle == NULL)                                               /* check handle */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (handle->inited != 1)                                          /* check handle initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    
+    if (handle->ops->bus_deinit(handle->user) != 0)                   /* close bus */
+    {
+        handle->ops->debug_print("ds2431: deinit failed.\n");         /* deinit failed */
+        
+        return 1;                                                     /* return error */
+    }
+    handle->inited = 0;                                               /* flag close */
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief     set the enabled lanes
+ * @param[in] *handle pointer to a ds2431 multi handle structure
+ * @param[in] lane enabled lane mask
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds2431_multi_set_lane(ds2431_multi_handle_t *handle, uint32_t lane)
+{
+    if (handle == NULL)                  /* check handle */
+    {
+        return 2;                        /* return error */
+    }
+    if (handle->inited != 1)             /* check handle initialization */
+    {
+        return 3;                        /* return error */
+    }
+    
+    handle->lane = lane;                 /* set lane */
+    
+    return 0;                            /* success return 0 */
+}
+
+/**
+ * @brief      get the enabled lanes
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[out] *lane pointer to a lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds2431_multi_get_lane(ds2431_multi_handle_t *handle, uint32_t *lane)
+{
+    if (handle == NULL)                  /* check handle */
+    {
+        return 2;                        /* return error */
+    }
+    if (handle->inited != 1)             /* check handle initialization */
+    {
+        return 3;                        /* return error */
+    }
+    
+    *lane = handle->lane;                /* get lane */
+    
+    return 0;                            /* success return 0 */
+}
+
+/**
+ * @brief      read data from every enabled lane in lockstep
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  address input address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length per lane
+ * @param[out] *fail pointer to a failed lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address and len are invalid
+ * @note       data of lane n is stored at data[n * len], so the buffer must hold
+ *             (highest enabled lane + 1) * len bytes
+ */
+uint8_t ds2431_multi_read(ds2431_multi_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len, uint32_t *fail)
+{
+    uint8_t i;
+    uint32_t alive;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if ((address + len) > 0x80)                                                           /* check address */
+    {
+        handle->ops->debug_print("ds2431: address and len are invalid.\n");               /* address and len are invalid */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    *fail = 0;                                                                            /* no failed lane */
+    alive = handle->lane;                                                                 /* all enabled lanes */
+    if (a_ds2431_multi_select(handle, &alive, fail) != 0)                                 /* select the lanes */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if (alive == 0)                                                                       /* check alive */
+    {
+        return 0;                                                                         /* success return 0 */
+    }
+    if (a_ds2431_multi_write_common(handle, alive, DS2431_MULTI_CMD_READ_MEMORY) != 0)    /* read memory command */
+    {
+        handle->ops->debug_print("ds2431: write command failed.\n");                      /* write command failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if (a_ds2431_multi_write_common(handle, alive, address) != 0)                         /* write address lsb */
+    {
+        handle->ops->debug_print("ds2431: write command failed.\n");                      /* write command failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    if (a_ds2431_multi_write_common(handle, alive, 0x00) != 0)                            /* write address msb */
+    {
+        handle->ops->debug_print("ds2431: write command failed.\n");                      /* write command failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    for (i = 0; i < len; i++)                                                             /* loop */
+    {
+        if (a_ds2431_multi_read_byte(handle, alive, &data[i], len) != 0)                  /* read one byte per lane */
+        {
+            handle->ops->debug_print("ds2431: read data failed.\n");                      /* read data failed */
+            
+            return 1;                                                                     /* return error */
+        }
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      write data to every enabled lane in lockstep
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  address input address
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length per lane
+ * @param[out] *fail pointer to a failed lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 write failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address and len are invalid
+ * @note       address and len must be multiples of 8,
+ *             data of lane n is read from data[n * len],
+ *             every lane copies with the authorization read back from its own scratchpad,
+ *             a lane that fails presence, crc16, the authorization or the copy response
+ *             is set in fail and released for the rest of the transaction
+ */
+uint8_t ds2431_multi_write(ds2431_multi_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len, uint32_t *fail)
+{
+    uint8_t i;
+    uint8_t n;
+    uint8_t row;
+    uint32_t alive;
+    uint32_t one[8];
+    uint16_t crc0;
+    uint16_t crc;
+    uint8_t head[3];
+    uint8_t buf[DS2431_MULTI_MAX_LANE * 3];
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if (((address + len) > 0x80) || ((address % 8) != 0) || ((len % 8) != 0))                 /* check address */
+    {
+        handle->ops->debug_print("ds2431: address and len are invalid.\n");                   /* address and len are invalid */
+        
+        return 4;                                                                             /* return error */
+    }
+    
+    *fail = 0;                                                                                /* no failed lane */
+    alive = handle->lane;                                                                     /* all enabled lanes */
+    for (row = 0; row < (len / 8); row++)                                                     /* every row */
+    {
+        uint8_t ta1;
+        
+        ta1 = (uint8_t)(address + row * 8);                                                   /* target address */
+        if (a_ds2431_multi_select(handle, &alive, fail) != 0)                                 /* select the lanes */
+        {
+            return 1;                                                                         /* return error */
+        }
+        if (alive == 0)                                                                       /* check alive */
+        {
+            return 0;                                                                         /* success return 0 */
+        }
+        
+        head[0] = DS2431_MULTI_CMD_WRITE_SCRATCHPAD;                                          /* write scratchpad command */
+        head[1] = ta1;                                                                        /* address lsb */
+        head[2] = 0x00;                                                                       /* address msb */
+        for (i = 0; i < 3; i++)                                                               /* send the header */
+        {
+            if (a_ds2431_multi_write_common(handle, alive, head[i]) != 0)                     /* write header byte */
+            {
+                handle->ops->debug_print("ds2431: write command failed.\n");                  /* write command failed */
+                
+                return 1;                                                                     /* return error */
+            }
+        }
+        crc0 = ds2431_crc16(0, head, 3);                                                      /* shared prefix */
+        for (i = 0; i < 8; i++)                                                               /* write 8 bytes */
+        {
+            a_ds2431_multi_gather(alive, &data[row * 8 + i], len, one);                       /* gather per lane bits */
+            if (a_ds2431_multi_write_byte(handle, alive, one) != 0)                           /* write data */
+            {
+                handle->ops->debug_print("ds2431: write data failed.\n");                     /* write data failed */
+                
+                return 1;                                                                     /* return error */
+            }
+        }
+        for (i = 0; i < 2; i++)                                                               /* read crc16 */
+        {
+            if (a_ds2431_multi_read_byte(handle, alive, &buf[i], 2) != 0)                     /* read byte */
+            {
+                handle->ops->debug_print("ds2431: read data failed.\n");                      /* read data failed */
+                
+                return 1;                                                                     /* return error */
+            }
+        }
+        for (n = 0; n < DS2431_MULTI_MAX_LANE; n++)                                           /* every lane */
+        {
+            if (((alive >> n) & 0x01) == 0)                                                   /* check lane */
+            {
+                continue;                                                                     /* next lane */
+            }
+            crc = ds2431_crc16(crc0, &data[n * len + row * 8], 8);                            /* add the lane data */
+            crc = ds2431_crc16(crc, &buf[n * 2], 2);                                          /* add the inverted crc16 */
+            if (crc != 0xB001U)                                                               /* check crc16 */
+            {
+                handle->ops->debug_print("ds2431: lane %d crc16 check error.\n", n);          /* crc16 check error */
+                *fail |= (uint32_t)1 << n;                                                    /* flag lane */
+                alive &= ~((uint32_t)1 << n);                                                 /* drop lane */
+            }
+        }
+        
+        if (a_ds2431_multi_select(handle, &alive, fail) != 0)                                 /* select the lanes */
+        {
+            return 1;                                                                         /* return error */
+        }
+        if (alive == 0)                                                                       /* check alive */
+        {
+            return 0;                                                                         /* success return 0 */
+        }
+        if (a_ds2431_multi_write_common(handle, alive,
+                                        DS2431_MULTI_CMD_READ_SCRATCHPAD) != 0)               /* read scratchpad command */
+        {
+            handle->ops->debug_print("ds2431: write command failed.\n");                      /* write command failed */
+            
+            return 1;                                                                         /* return error */
+        }
+        for (i = 0; i < 3; i++)                                                               /* ta1, ta2 and es */
+        {
+            if (a_ds2431_multi_read_byte(handle, alive, &buf[i], 3) != 0)                     /* read byte */
+            {
+                handle->ops->debug_print("ds2431: read data failed.\n");                      /* read data failed */
+                
+                return 1;                                                                     /* return error */
+            }
+        }
+        for (n = 0; n < DS2431_MULTI_MAX_LANE; n++)                                           /* every lane */
+        {
+            if ((((alive >> n) & 0x01) != 0) &&
+                ((buf[n * 3 + 0] != ta1) || (buf[n * 3 + 1] != 0x00) ||
+                 ((buf[n * 3 + 2] & DS2431_MULTI_ES_MASK) != DS2431_MULTI_ES_ROW)))           /* check authorization */
+            {
+                handle->ops->debug_print("ds2431: lane %d authorization error.\n", n);        /* authorization error */
+                *fail |= (uint32_t)1 << n;                                                    /* flag lane */
+                alive &= ~((uint32_t)1 << n);                                                 /* drop lane */
+            }
+        }
+        
+        if (a_ds2431_multi_select(handle, &alive, fail) != 0)                                 /* select the lanes */
+        {
+            return 1;                                                                         /* return error */
+        }
+        if (alive == 0)                                                                       /* check alive */
+        {
+            return 0;                                                                         /* success return 0 */
+        }
+        head[0] = DS2431_MULTI_CMD_COPY_SCRATCHPAD;                                           /* copy scratchpad command */
+        for (i = 0; i < 3; i++)                                                               /* send the command and the address */
+        {
+            if (a_ds2431_multi_write_common(handle, alive, head[i]) != 0)                     /* write header byte */
+            {
+                handle->ops->debug_print("ds2431: write command failed.\n");                  /* write command failed */
+                
+                return 1;                                                                     /* return error */
+            }
+        }
+        a_ds2431_multi_gather(alive, &buf[2], 3, one);                                        /* echo the es of every lane */
+        if (a_ds2431_multi_write_byte(handle, alive, one) != 0)                               /* write es */
+        {
+            handle->ops->debug_print("ds2431: write command failed.\n");                      /* write command failed */
+            
+            return 1;                                                                         /* return error */
+        }
+        handle->ops->delay_ms(handle->user, DS2431_TIME_PROG_MS);                             /* delay 10ms */
+        if (a_ds2431_multi_read_byte(handle, alive, buf, 1) != 0)                             /* read response */
+        {
+            handle->ops->debug_print("ds2431: read data failed.\n");                          /* read data failed */
+            
+            return 1;                                                                         /* return error */
+        }
+        for (n = 0; n < DS2431_MULTI_MAX_LANE; n++)                                           /* every lane */
+        {
+            if ((((alive >> n) & 0x01) != 0) && (buf[n] != 0xAA))                             /* check response */
+            {
+                handle->ops->debug_print("ds2431: lane %d response error.\n", n);             /* response error */
+                *fail |= (uint32_t)1 << n;                                                    /* flag lane */
+                alive &= ~((uint32_t)1 << n);                                                 /* drop lane */
+            }
+        }
+    }
+    
+    return 0;                                                                                 /* success return 0 */
+}
@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_multi.h
+ * @brief     driver ds2431 multi lane header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS2431_MULTI_H
+#define DRIVER_DS2431_MULTI_H
+
+#include "driver_ds2431.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds2431_multi_driver ds2431 multi lane driver function
+ * @brief    ds2431 multi lane driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 multi max lane definition
+ */
+#define DS2431_MULTI_MAX_LANE        32        /**< one bit of a uint32_t port mask per lane */
+
+/**
+ * @brief ds2431 multi ops structure definition
+ * @note  bit n of a port mask is the line level of lane n, 0 is low and 1 is released
+ */
+typedef struct ds2431_multi_ops_s
+{
+    uint8_t (*bus_init)(void *user);                              /**< point to a bus_init function address */
+    uint8_t (*bus_deinit)(void *user);                            /**< point to a bus_deinit function address */
+    uint8_t (*bus_read_mask)(void *user, uint32_t *mask);         /**< point to a bus_read_mask function address */
+    uint8_t (*bus_write_mask)(void *user, uint32_t mask);         /**< point to a bus_write_mask function address */
+    void (*delay_ms)(void *user, uint32_t ms);                    /**< point to a delay_ms function address */
+    void (*delay_us)(void *user, uint32_t us);                    /**< point to a delay_us function address */
+    void (*enable_irq)(void *user);                               /**< point to an enable_irq function address */
+    void (*disable_irq)(void *user);                              /**< point to a disable_irq function address */
+    void (*debug_print)(const char *const fmt, ...);              /**< point to a debug_print function address */
+} ds2431_multi_ops_t;
+
+/**
+ * @brief ds2431 multi handle structure definition
+ */
+typedef struct ds2431_multi_handle_s
+{
+    const ds2431_multi_ops_t *ops;        /**< point to a shared ops table */
+    void *user;                           /**< user context passed to the bus callbacks */
+    uint32_t lane;                        /**< enabled lane mask */
+    uint8_t inited;                       /**< inited flag */
+} ds2431_multi_handle_t;
+
+/**
+ * @brief     initialize ds2431_multi_handle_t structure
+ * @param[in] HANDLE pointer to a ds2431 multi handle structure
+ * @param[in] STRUCTURE ds2431_multi_handle_t
+ * @note      none
+ */
+#define DRIVER_DS2431_MULTI_LINK_INIT(HANDLE, STRUCTURE)        memset(HANDLE, 0, sizeof(STRUCTURE))
+
+/**
+ * @brief     link ops table
+ * @param[in] HANDLE pointer to a ds2431 multi handle structure
+ * @param[in] OPS pointer to a ds2431 multi ops structure
+ * @note      none
+ */
+#define DRIVER_DS2431_MULTI_LINK_OPS(HANDLE, OPS)               (HANDLE)->ops = OPS
+
+/**
+ * @brief     link user context
+ * @param[in] HANDLE pointer to a ds2431 multi handle structure
+ * @param[in] USER pointer to a user context
+ * @note      none
+ */
+#define DRIVER_DS2431_MULTI_LINK_USER(HANDLE, USER)             (HANDLE)->user = USER
+
+/**
+ * @brief      initialize the lanes
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  lane enabled lane mask
+ * @param[out] *present pointer to a presence mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 bus initialization failed
+ *             - 2 handle is NULL
+ *             - 3 linked functions is NULL
+ *             - 4 no lane is present
+ * @note       lanes without a presence pulse are dropped from the enabled mask
+ */
+uint8_t ds2431_multi_init(ds2431_multi_handle_t *handle, uint32_t lane, uint32_t *present);
+
+/**
+ * @brief     close the lanes
+ * @param[in] *handle pointer to a ds2431 multi handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds2431_multi_deinit(ds2431_multi_handle_t *handle);
+
+/**
+ * @brief     set the enabled lanes
+ * @param[in] *handle pointer to a ds2431 multi handle structure
+ * @param[in] lane enabled lane mask
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds2431_multi_set_lane(ds2431_multi_handle_t *handle, uint32_t lane);
+
+/**
+ * @brief      get the enabled lanes
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[out] *lane pointer to a lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds2431_multi_get_lane(ds2431_multi_handle_t *handle, uint32_t *lane);
+
+/**
+ * @brief      read data from every enabled lane in lockstep
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  address input address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length per lane
+ * @param[out] *fail pointer to a failed lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address and len are invalid
+ * @note       data of lane n is stored at data[n * len], so the buffer must hold
+ *             (highest enabled lane + 1) * len bytes
+ */
+uint8_t ds2431_multi_read(ds2431_multi_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len, uint32_t *fail);
+
+/**
+ * @brief      write data to every enabled lane in lockstep
+ * @param[in]  *handle pointer to a ds2431 multi handle structure
+ * @param[in]  address input address
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length per lane
+ * @param[out] *fail pointer to a failed lane mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 write failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address and len are invalid
+ * @note       address and len must be multiples of 8,
+ *             data of lane n is read from data[n * len],
+ *             every lane copies with the authorization read back from its own scratchpad,
+ *             a lane that fails presence, crc16, the authorization or the copy response
+ *             is set in fail and released for the rest of the transaction
+ */
+uint8_t ds2431_multi_write(ds2431_multi_handle_t *handle, uint8_t address, uint8_t *data, uint8_t len, uint32_t *fail);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
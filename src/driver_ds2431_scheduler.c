@@ -0,0 +1,352 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_scheduler.c
+ * @brief     driver ds2431 scheduler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_scheduler.h"
+
+/**
+ * @brief     complete the head request of a bus
+ * @param[in] *b pointer to a ds2431 scheduler bus structure
+ * @param[in] status request status
+ * @note      none
+ */
+static void a_ds2431_scheduler_complete(ds2431_scheduler_bus_t *b, ds2431_scheduler_status_t status)
+{
+    ds2431_scheduler_request_t *request;
+    
+    request = b->queue[b->head];                                     /* get head */
+    b->head = (b->head + 1) % DS2431_SCHEDULER_MAX_QUEUE;            /* pop */
+    b->count--;                                                      /* count-- */
+    request->status = status;                                        /* set status */
+    if (request->done != NULL)                                       /* check callback */
+    {
+        request->done(request);                                      /* run callback */
+    }
+}
+
+/**
+ * @brief     run one step on a bus
+ * @param[in] *b pointer to a ds2431 scheduler bus structure
+ * @return    1 if the bus is still busy, 0 if it is idle
+ * @note      none
+ */
+static uint8_t a_ds2431_scheduler_step(ds2431_scheduler_bus_t *b)
+{
+    ds2431_handle_t *handle;
+    ds2431_scheduler_request_t *request;
+    uint8_t row;
+    uint8_t off;
+    uint8_t n;
+    uint8_t buf[8];
+    
+    handle = b->handle;                                                            /* get handle */
+    if (b->programming != 0)                                                       /* check tPROG */
+    {
+        uint32_t now;
+        ds2431_bool_t pending;
+        
+        now = handle->ops->timestamp_us(handle->user);                             /* get now */
+        if ((uint32_t)(now - b->start) < DS2431_SCHEDULER_PROGRAM_TIME_US)         /* check elapsed */
+        {
+            return 1;                                                              /* still programming */
+        }
+        b->programming = 0;                                                        /* clear tPROG */
+        request = b->queue[b->head];                                               /* get head */
+        if (ds2431_write_row_finish(handle) != 0)                                  /* finish the row */
+        {
+            a_ds2431_scheduler_complete(b, DS2431_SCHEDULER_STATUS_FAILED);        /* failed */
+            
+            return (b->count != 0) ? 1 : 0;                                       /* return busy */
+        }
+        (void)ds2431_get_row_pending(handle, &pending);                            /* get pending */
+        if (pending == DS2431_BOOL_TRUE)                                           /* digest row programs */
+        {
+            b->start = handle->ops->timestamp_us(handle->user);                    /* save start */
+            b->programming = 1;                                                    /* set tPROG */
+            
+            return 1;                                                              /* busy */
+        }
+        request->offset += b->step;                                                /* next row */
+        if (request->offset >= request->len)                                       /* check end */
+        {
+            a_ds2431_scheduler_complete(b, DS2431_SCHEDULER_STATUS_DONE);          /* done */
+        }
+        
+        return (b->count != 0) ? 1 : 0;                                            /* return busy */
+    }
+    if (b->count == 0)                                                             /* check queue */
+    {
+        return 0;                                                                  /* idle */
+    }
+    
+    request = b->queue[b->head];                                                   /* get head */
+    if (request->op == DS2431_SCHEDULER_OP_READ)                                   /* read */
+    {
+        if (ds2431_read(handle, request->address,
+                        request->data, request->len) != 0)                         /* read whole */
+        {
+            a_ds2431_scheduler_complete(b, DS2431_SCHEDULER_STATUS_FAILED);        /* failed */
+        }
+        else
+        {
+            a_ds2431_scheduler_complete(b, DS2431_SCHEDULER_STATUS_DONE);          /* done */
+        }
+        
+        return (b->count != 0) ? 1 : 0;                                            /* return busy */
+    }
+    
+    row = (uint8_t)((request->address + request->offset) & ~0x07);                 /* row address */
+    off = (uint8_t)((request->address + request->offset) & 0x07);                  /* row offset */
+    n = (uint8_t)(8 - off);                                                        /* row remain */
+    if (n > (request->len - request->offset))                                      /* check length */
+    {
+        n = (uint8_t)(request->len - request->offset);                             /* set remain */
+    }
+    if (n != 8)                                                                    /* partial row */
+    {
+        if (ds2431_read(handle, row, buf, 8) != 0)                                 /* read the row */
+        {
+            a_ds2431_scheduler_complete(b, DS2431_SCHEDULER_STATUS_FAILED);        /* failed */
+            
+            return (b->count != 0) ? 1 : 0;                                        /* return busy */
+        }
+    }
+    memcpy(&buf[off], &request->data[request->offset], n);                         /* merge */
+    if (ds2431_write_row_start(handle, row, buf) != 0)                             /* start the row */
+    {
+        a_ds2431_scheduler_complete(b, DS2431_SCHEDULER_STATUS_FAILED);            /* failed */
+        
+        return (b->count != 0) ? 1 : 0;                                            /* return busy */
+    }
+    b->step = n;                                                                   /* save step */
+    b->start = handle->ops->timestamp_us(handle->user);                            /* save start */
+    b->programming = 1;                                                            /* set tPROG */
+    
+    return 1;                                                                      /* busy */
+}
+
+/**
+ * @brief     initialize the scheduler
+ * @param[in] *sched pointer to a ds2431 scheduler structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sched is NULL
+ * @note      none
+ */
+uint8_t ds2431_scheduler_init(ds2431_scheduler_t *sched)
+{
+    if (sched == NULL)                                 /* check sched */
+    {
+        return 2;                                      /* return error */
+    }
+    
+    memset(sched, 0, sizeof(ds2431_scheduler_t));     /* clear */
+    sched->inited = 1;                                 /* flag finish initialization */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief      add a bus to the scheduler
+ * @param[in]  *sched pointer to a ds2431 scheduler structure
+ * @param[in]  *handle pointer to an initialized ds2431 handle structure
+ * @param[out] *bus pointer to a bus index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sched is NULL
+ *             - 3 sched is not initialized
+ *             - 4 handle is invalid
+ *             - 5 timestamp_us is NULL
+ *             - 6 bus is full
+ * @note       every bus must be a separate 1-wire line
+ */
+uint8_t ds2431_scheduler_add_bus(ds2431_scheduler_t *sched, ds2431_handle_t *handle, uint8_t *bus)
+{
+    if (sched == NULL)                                                         /* check sched */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (sched->inited != 1)                                                    /* check sched initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if ((handle == NULL) || (handle->inited != 1))                             /* check handle */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (handle->ops->timestamp_us == NULL)                                     /* check timestamp_us */
+    {
+        handle->ops->debug_print("ds2431: timestamp_us is null.\n");           /* timestamp_us is null */
+        
+        return 5;                                                              /* return error */
+    }
+    if (sched->bus_count >= DS2431_SCHEDULER_MAX_BUS)                          /* check bus number */
+    {
+        handle->ops->debug_print("ds2431: bus is full.\n");                    /* bus is full */
+        
+        return 6;                                                              /* return error */
+    }
+    
+    memset(&sched->bus[sched->bus_count], 0, sizeof(ds2431_scheduler_bus_t));  /* clear bus */
+    sched->bus[sched->bus_count].handle = handle;                              /* set handle */
+    *bus = sched->bus_count;                                                   /* set index */
+    sched->bus_count++;                                                        /* bus_count++ */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     submit a request to a bus
+ * @param[in] *sched pointer to a ds2431 scheduler structure
+ * @param[in] bus bus index
+ * @param[in] *request pointer to a ds2431 scheduler request structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sched is NULL
+ *            - 3 sched is not initialized
+ *            - 4 bus is invalid
+ *            - 5 address and len are invalid
+ *            - 6 queue is full
+ * @note      requests of one bus run in order
+ */
+uint8_t ds2431_scheduler_submit(ds2431_scheduler_t *sched, uint8_t bus, ds2431_scheduler_request_t *request)
+{
+    ds2431_scheduler_bus_t *b;
+    
+    if (sched == NULL)                                                                    /* check sched */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (sched->inited != 1)                                                               /* check sched initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if ((bus >= sched->bus_count) || (request == NULL))                                   /* check bus */
+    {
+        return 4;                                                                         /* return error */
+    }
+    
+    b = &sched->bus[bus];                                                                 /* get bus */
+    if ((request->len == 0) || ((request->address + request->len) > 0x80))                /* check address */
+    {
+        b->handle->ops->debug_print("ds2431: address and len are invalid.\n");            /* address and len are invalid */
+        
+        return 5;                                                                         /* return error */
+    }
+    if (b->count >= DS2431_SCHEDULER_MAX_QUEUE)                                           /* check queue */
+    {
+        b->handle->ops->debug_print("ds2431: queue is full.\n");                          /* queue is full */
+        
+        return 6;                                                                         /* return error */
+    }
+    request->offset = 0;                                                                  /* reset progress */
+    request->status = DS2431_SCHEDULER_STATUS_PENDING;                                    /* set pending */
+    b->queue[(b->head + b->count) % DS2431_SCHEDULER_MAX_QUEUE] = request;                /* push */
+    b->count++;                                                                           /* count++ */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      run one step on every bus
+ * @param[in]  *sched pointer to a ds2431 scheduler structure
+ * @param[out] *busy pointer to a busy bus number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sched is NULL
+ *             - 3 sched is not initialized
+ * @note       a bus in tPROG is skipped until its program time elapses,
+ *             so the other buses are served meanwhile,
+ *             with the digest enabled the digest row gets its own tPROG the same way
+ */
+uint8_t ds2431_scheduler_poll(ds2431_scheduler_t *sched, uint8_t *busy)
+{
+    uint8_t i;
+    uint8_t cnt;
+    
+    if (sched == NULL)                                                        /* check sched */
+    {
+        return 2;                                                             /* return error */
+    }
+    if (sched->inited != 1)                                                   /* check sched initialization */
+    {
+        return 3;                                                             /* return error */
+    }
+    
+    cnt = 0;                                                                  /* init 0 */
+    for (i = 0; i < sched->bus_count; i++)                                    /* every bus */
+    {
+        uint8_t index;
+        
+        index = (uint8_t)((sched->next + i) % sched->bus_count);              /* round robin */
+        cnt += a_ds2431_scheduler_step(&sched->bus[index]);                   /* run one step */
+    }
+    if (sched->bus_count != 0)                                                /* check bus number */
+    {
+        sched->next = (uint8_t)((sched->next + 1) % sched->bus_count);        /* rotate start */
+    }
+    if (busy != NULL)                                                         /* check busy */
+    {
+        *busy = cnt;                                                          /* set busy */
+    }
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     poll the scheduler until every bus is idle
+ * @param[in] *sched pointer to a ds2431 scheduler structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sched is NULL
+ *            - 3 sched is not initialized
+ * @note      none
+ */
+uint8_t ds2431_scheduler_run(ds2431_scheduler_t *sched)
+{
+    uint8_t res;
+    uint8_t busy;
+    
+    do
+    {
+        res = ds2431_scheduler_poll(sched, &busy);        /* poll */
+        if (res != 0)                                     /* check result */
+        {
+            return res;                                   /* return error */
+        }
+    } while (busy != 0);                                  /* until idle */
+    
+    return 0;                                             /* success return 0 */
+}
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_scheduler.h
+ * @brief     driver ds2431 scheduler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS2431_SCHEDULER_H
+#define DRIVER_DS2431_SCHEDULER_H
+
+#include "driver_ds2431.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds2431_scheduler_driver ds2431 scheduler driver function
+ * @brief    ds2431 scheduler driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 scheduler max bus definition
+ */
+#ifndef DS2431_SCHEDULER_MAX_BUS
+    #define DS2431_SCHEDULER_MAX_BUS                4        /**< max bus number */
+#endif
+
+/**
+ * @brief ds2431 scheduler max queue definition
+ */
+#ifndef DS2431_SCHEDULER_MAX_QUEUE
+    #define DS2431_SCHEDULER_MAX_QUEUE              8        /**< max queued requests per bus */
+#endif
+
+/**
+ * @brief ds2431 scheduler program time definition
+ */
+#ifndef DS2431_SCHEDULER_PROGRAM_TIME_US
+    #define DS2431_SCHEDULER_PROGRAM_TIME_US        10000    /**< tPROG in us */
+#endif
+
+/**
+ * @brief ds2431 scheduler operation enumeration definition
+ */
+typedef enum
+{
+    DS2431_SCHEDULER_OP_READ  = 0x00,        /**< read memory */
+    DS2431_SCHEDULER_OP_WRITE = 0x01,        /**< write memory */
+} ds2431_scheduler_op_t;
+
+/**
+ * @brief ds2431 scheduler request status enumeration definition
+ */
+typedef enum
+{
+    DS2431_SCHEDULER_STATUS_PENDING = 0x00,        /**< queued or in progress */
+    DS2431_SCHEDULER_STATUS_DONE    = 0x01,        /**< finished */
+    DS2431_SCHEDULER_STATUS_FAILED  = 0x02,        /**< failed */
+} ds2431_scheduler_status_t;
+
+/**
+ * @brief ds2431 scheduler request structure definition
+ * @note  owned by the caller and must stay valid until its status leaves pending
+ */
+typedef struct ds2431_scheduler_request_s
+{
+    ds2431_scheduler_op_t op;                                         /**< operation */
+    uint8_t address;                                                  /**< memory address */
+    uint8_t *data;                                                    /**< data buffer */
+    uint8_t len;                                                      /**< data length */
+    volatile ds2431_scheduler_status_t status;                        /**< request status */
+    void (*done)(struct ds2431_scheduler_request_s *request);         /**< optional completion callback */
+    void *arg;                                                        /**< caller argument */
+    uint8_t offset;                                                   /**< private progress */
+} ds2431_scheduler_request_t;
+
+/**
+ * @brief ds2431 scheduler bus structure definition
+ */
+typedef struct ds2431_scheduler_bus_s
+{
+    ds2431_handle_t *handle;                                                 /**< bus handle */
+    ds2431_scheduler_request_t *queue[DS2431_SCHEDULER_MAX_QUEUE];           /**< request ring */
+    uint8_t head;                                                            /**< ring head */
+    uint8_t count;                                                           /**< ring count */
+    uint8_t programming;                                                     /**< tPROG flag */
+    uint8_t step;                                                            /**< bytes of the programming row */
+    uint32_t start;                                                          /**< tPROG start timestamp */
+} ds2431_scheduler_bus_t;
+
+/**
+ * @brief ds2431 scheduler structure definition
+ */
+typedef struct ds2431_scheduler_s
+{
+    ds2431_scheduler_bus_t bus[DS2431_SCHEDULER_MAX_BUS];        /**< buses */
+    uint8_t bus_count;                                           /**< bus number */
+    uint8_t next;                                                /**< round robin index */
+    uint8_t inited;                                              /**< inited flag */
+} ds2431_scheduler_t;
+
+/**
+ * @brief     initialize the scheduler
+ * @param[in] *sched pointer to a ds2431 scheduler structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sched is NULL
+ * @note      none
+ */
+uint8_t ds2431_scheduler_init(ds2431_scheduler_t *sched);
+
+/**
+ * @brief      add a bus to the scheduler
+ * @param[in]  *sched pointer to a ds2431 scheduler structure
+ * @param[in]  *handle pointer to an initialized ds2431 handle structure
+ * @param[out] *bus pointer to a bus index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sched is NULL
+ *             - 3 sched is not initialized
+ *             - 4 handle is invalid
+ *             - 5 timestamp_us is NULL
+ *             - 6 bus is full
+ * @note       every bus must be a separate 1-wire line
+ */
+uint8_t ds2431_scheduler_add_bus(ds2431_scheduler_t *sched, ds2431_handle_t *handle, uint8_t *bus);
+
+/**
+ * @brief     submit a request to a bus
+ * @param[in] *sched pointer to a ds2431 scheduler structure
+ * @param[in] bus bus index
+ * @param[in] *request pointer to a ds2431 scheduler request structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sched is NULL
+ *            - 3 sched is not initialized
+ *            - 4 bus is invalid
+ *            - 5 address and len are invalid
+ *            - 6 queue is full
+ * @note      requests of one bus run in order
+ */
+uint8_t ds2431_scheduler_submit(ds2431_scheduler_t *sched, uint8_t bus, ds2431_scheduler_request_t *request);
+
+/**
+ * @brief      run one step on every bus
+ * @param[in]  *sched pointer to a ds2431 scheduler structure
+ * @param[out] *busy pointer to a busy bus number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 sched is NULL
+ *             - 3 sched is not initialized
+ * @note       a bus in tPROG is skipped until its program time elapses,
+ *             so the other buses are served meanwhile,
+ *             with the digest enabled the digest row gets its own tPROG the same way
+ */
+uint8_t ds2431_scheduler_poll(ds2431_scheduler_t *sched, uint8_t *busy);
+
+/**
+ * @brief     poll the scheduler until every bus is idle
+ * @param[in] *sched pointer to a ds2431 scheduler structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sched is NULL
+ *            - 3 sched is not initialized
+ * @note      none
+ */
+uint8_t ds2431_scheduler_run(ds2431_scheduler_t *sched);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_snapshot.c
+ * @brief     driver ds2431 snapshot source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds2431_snapshot.h"
+
+/**
+ * @brief     copy a buffer into one image copy
+ * @param[in] *snapshot pointer to a ds2431 snapshot structure
+ * @param[in] index copy index
+ * @param[in] *buf pointer to a data buffer
+ * @note      none
+ */
+static void a_ds2431_snapshot_copy(ds2431_snapshot_t *snapshot, uint8_t index, uint8_t *buf)
+{
+    uint16_t i;
+    
+    for (i = 0; i < DS2431_SNAPSHOT_SIZE; i++)        /* copy all */
+    {
+        snapshot->image[index][i] = buf[i];           /* copy byte */
+    }
+}
+
+/**
+ * @brief     initialize a snapshot
+ * @param[in] *snapshot pointer to a ds2431 snapshot structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 snapshot is NULL
+ * @note      the snapshot is empty until the first refresh
+ */
+uint8_t ds2431_snapshot_init(ds2431_snapshot_t *snapshot)
+{
+    uint8_t buf[DS2431_SNAPSHOT_SIZE];
+    
+    if (snapshot == NULL)                                 /* check snapshot */
+    {
+        return 2;                                         /* return error */
+    }
+    
+    memset(buf, 0xFF, DS2431_SNAPSHOT_SIZE);              /* erased pattern */
+    a_ds2431_snapshot_copy(snapshot, 0, buf);             /* clear copy 0 */
+    a_ds2431_snapshot_copy(snapshot, 1, buf);             /* clear copy 1 */
+    snapshot->sequence = 0;                               /* empty */
+    DS2431_SNAPSHOT_BARRIER();                            /* publish */
+    
+    return 0;                                             /* success return 0 */
+}
+
+/**
+ * @brief     read the chip and publish a new snapshot
+ * @param[in] *snapshot pointer to a ds2431 snapshot structure
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh failed
+ *            - 2 snapshot is NULL
+ * @note      the chip is read with ds2431_read and ds2431_read_memory_config,
+ *            so the bus lock and an attached cache are honoured,
+ *            only one task may refresh a snapshot at a time
+ */
+uint8_t ds2431_snapshot_refresh(ds2431_snapshot_t *snapshot, ds2431_handle_t *handle)
+{
+    uint8_t buf[DS2431_SNAPSHOT_SIZE];
+    ds2431_config_control_t config;
+    
+    if (snapshot == NULL)                                                   /* check snapshot */
+    {
+        return 2;                                                           /* return error */
+    }
+    
+    if (ds2431_read(handle, 0x00, buf, 128) != 0)                           /* read memory */
+    {
+        return 1;                                                           /* return error */
+    }
+    if (ds2431_read_memory_config(handle, &config) != 0)                    /* read config */
+    {
+        return 1;                                                           /* return error */
+    }
+    buf[0x80] = config.page0_protection_control;                            /* set page0 protection control */
+    buf[0x81] = config.page1_protection_control;                            /* set page1 protection control */
+    buf[0x82] = config.page2_protection_control;                            /* set page2 protection control */
+    buf[0x83] = config.page3_protection_control;                            /* set page3 protection control */
+    buf[0x84] = config.copy_protection;                                     /* set copy protection */
+    buf[0x85] = config.factory_byte;                                        /* set factory byte */
+    buf[0x86] = config.user_byte_0;                                         /* set user byte 0 */
+    buf[0x87] = config.user_byte_1;                                         /* set user byte 1 */
+    
+    snapshot->sequence++;                                                   /* odd, readers use copy 1 */
+    DS2431_SNAPSHOT_BARRIER();                                              /* order */
+    a_ds2431_snapshot_copy(snapshot, 0, buf);                               /* write copy 0 */
+    DS2431_SNAPSHOT_BARRIER();                                              /* order */
+    snapshot->sequence++;                                                   /* even, readers use copy 0 */
+    DS2431_SNAPSHOT_BARRIER();                                              /* order */
+    a_ds2431_snapshot_copy(snapshot, 1, buf);                               /* write copy 1 */
+    DS2431_SNAPSHOT_BARRIER();                                              /* publish */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      copy data out of a snapshot without locking
+ * @param[in]  *snapshot pointer to a ds2431 snapshot structure
+ * @param[in]  address input address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *sequence pointer to a sequence buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 snapshot changed on every retry
+ *             - 2 snapshot is NULL
+ *             - 4 address and len are invalid
+ *             - 5 snapshot is empty
+ * @note       safe from any task or interrupt, the returned sequence grows by 2 per refresh
+ */
+uint8_t ds2431_snapshot_read(ds2431_snapshot_t *snapshot, uint8_t address, uint8_t *data, uint8_t len, uint32_t *sequence)
+{
+    uint8_t i;
+    uint8_t retry;
+    uint32_t seq;
+    
+    if (snapshot == NULL)                                                        /* check snapshot */
+    {
+        return 2;                                                                /* return error */
+    }
+    if ((address + len) > DS2431_SNAPSHOT_SIZE)                                  /* check address */
+    {
+        return 4;                                                                /* return error */
+    }
+    
+    for (retry = 0; retry < DS2431_SNAPSHOT_MAX_RETRY; retry++)                  /* retry */
+    {
+        seq = snapshot->sequence;                                                /* get sequence */
+        DS2431_SNAPSHOT_BARRIER();                                               /* order */
+        if (seq < 2)                                                             /* check empty */
+        {
+            return 5;                                                            /* return error */
+        }
+        for (i = 0; i < len; i++)                                                /* copy data */
+        {
+            data[i] = snapshot->image[seq & 0x01][address + i];                  /* read the stable copy */
+        }
+        DS2431_SNAPSHOT_BARRIER();                                               /* order */
+        if (snapshot->sequence == seq)                                           /* check sequence */
+        {
+            if (sequence != NULL)                                                /* check sequence buffer */
+            {
+                *sequence = seq & (~0x01U);                                      /* last finished refresh */
+            }
+            
+            return 0;                                                            /* success return 0 */
+        }
+    }
+    
+    return 1;                                                                    /* return error */
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ds2431_snapshot.h
+ * @brief     driver ds2431 snapshot header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS2431_SNAPSHOT_H
+#define DRIVER_DS2431_SNAPSHOT_H
+
+#include "driver_ds2431.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds2431_snapshot_driver ds2431 snapshot driver function
+ * @brief    ds2431 snapshot driver modules
+ * @ingroup  ds2431_driver
+ * @{
+ */
+
+/**
+ * @brief ds2431 snapshot size definition
+ */
+#define DS2431_SNAPSHOT_SIZE        136        /**< 0x00 - 0x87, memory and config */
+
+/**
+ * @brief ds2431 snapshot max retry definition
+ */
+#ifndef DS2431_SNAPSHOT_MAX_RETRY
+    #define DS2431_SNAPSHOT_MAX_RETRY        16        /**< reader retries before giving up */
+#endif
+
+/**
+ * @brief ds2431 snapshot barrier definition
+ * @note  override it with the platform barrier if the compiler is not gcc compatible
+ */
+#ifndef DS2431_SNAPSHOT_BARRIER
+    #if defined(__GNUC__) || defined(__clang__)
+        #define DS2431_SNAPSHOT_BARRIER()        __sync_synchronize()
+    #else
+        #define DS2431_SNAPSHOT_BARRIER()
+    #endif
+#endif
+
+/**
+ * @brief ds2431 snapshot structure definition
+ * @note  two copies are kept, while copy n is written readers use the other one,
+ *        so a reader interrupting the writer never has to wait for it
+ */
+typedef struct ds2431_snapshot_s
+{
+    volatile uint32_t sequence;                              /**< bit 0 selects the copy being written */
+    volatile uint8_t image[2][DS2431_SNAPSHOT_SIZE];         /**< published images */
+} ds2431_snapshot_t;
+
+/**
+ * @brief     initialize a snapshot
+ * @param[in] *snapshot pointer to a ds2431 snapshot structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 snapshot is NULL
+ * @note      the snapshot is empty until the first refresh
+ */
+uint8_t ds2431_snapshot_init(ds2431_snapshot_t *snapshot);
+
+/**
+ * @brief     read the chip and publish a new snapshot
+ * @param[in] *snapshot pointer to a ds2431 snapshot structure
+ * @param[in] *handle pointer to a ds2431 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh failed
+ *            - 2 snapshot is NULL
+ * @note      the chip is read with ds2431_read and ds2431_read_memory_config,
+ *            so the bus lock and an attached cache are honoured,
+ *            only one task may refresh a snapshot at a time
+ */
+uint8_t ds2431_snapshot_refresh(ds2431_snapshot_t *snapshot, ds2431_handle_t *handle);
+
+/**
+ * @brief      copy data out of a snapshot without locking
+ * @param[in]  *snapshot pointer to a ds2431 snapshot structure
+ * @param[in]  address input address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *sequence pointer to a sequence buffer, NULL is allowed
+ * @return     status code
+ *             - 0 success
+ *             - 1 snapshot changed on every retry
+ *             - 2 snapshot is NULL
+ *             - 4 address and len are invalid
+ *             - 5 snapshot is empty
+ * @note       safe from any task or interrupt, the returned sequence grows by 2 per refresh
+ */
+uint8_t ds2431_snapshot_read(ds2431_snapshot_t *snapshot, uint8_t address, uint8_t *data, uint8_t len, uint32_t *sequence);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
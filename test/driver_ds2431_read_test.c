@@ -38,6 +38,18 @@
 #include <stdlib.h>
 
 static ds2431_handle_t gs_handle;        /**< ds2431 handle */
+static const ds2431_ops_t gs_ops =      /**< ds2431 ops */
+{
+    .bus_init = ds2431_interface_init,
+    .bus_deinit = ds2431_interface_deinit,
+    .bus_read = ds2431_interface_read,
+    .bus_write = ds2431_interface_write,
+    .delay_ms = ds2431_interface_delay_ms,
+    .delay_us = ds2431_interface_delay_us,
+    .enable_irq = ds2431_interface_enable_irq,
+    .disable_irq = ds2431_interface_disable_irq,
+    .debug_print = ds2431_interface_debug_print,
+};
 static uint8_t gs_buffer[128];           /**< data buffer */
 static uint8_t gs_buffer_check[128];     /**< check buffer */
 
@@ -63,15 +75,7 @@ uint8_t ds2431_read_test(uint32_t times)
    
     /* link interface function */
     DRIVER_DS2431_LINK_INIT(&gs_handle, ds2431_handle_t);
-    DRIVER_DS2431_LINK_BUS_INIT(&gs_handle, ds2431_interface_init);
-    DRIVER_DS2431_LINK_BUS_DEINIT(&gs_handle, ds2431_interface_deinit);
-    DRIVER_DS2431_LINK_BUS_READ(&gs_handle, ds2431_interface_read);
-    DRIVER_DS2431_LINK_BUS_WRITE(&gs_handle, ds2431_interface_write);
-    DRIVER_DS2431_LINK_DELAY_MS(&gs_handle, ds2431_interface_delay_ms);
-    DRIVER_DS2431_LINK_DELAY_US(&gs_handle, ds2431_interface_delay_us);
-    DRIVER_DS2431_LINK_ENABLE_IRQ(&gs_handle, ds2431_interface_enable_irq);
-    DRIVER_DS2431_LINK_DISABLE_IRQ(&gs_handle, ds2431_interface_disable_irq);
-    DRIVER_DS2431_LINK_DEBUG_PRINT(&gs_handle, ds2431_interface_debug_print);
+    DRIVER_DS2431_LINK_OPS(&gs_handle, &gs_ops);
 
     /* get ds2431 info */
     res = ds2431_info(&info);
@@ -831,7 +835,7 @@ uint8_t ds2431_read_test(uint32_t times)
         ds2431_interface_debug_print("ds2431: passed.\n"); 
         
         /* delay 1000ms */
-        ds2431_interface_delay_ms(1000);
+        ds2431_interface_delay_ms(NULL, 1000);
     }
     
     /* overdrive skip rom mode */
@@ -890,7 +894,7 @@ uint8_t ds2431_read_test(uint32_t times)
         ds2431_interface_debug_print("ds2431: passed.\n"); 
         
         /* delay 1000ms */
-        ds2431_interface_delay_ms(1000);
+        ds2431_interface_delay_ms(NULL, 1000);
     }
     
     /* set rom */
@@ -967,7 +971,7 @@ uint8_t ds2431_read_test(uint32_t times)
         ds2431_interface_debug_print("ds2431: passed.\n"); 
         
         /* delay 1000ms */
-        ds2431_interface_delay_ms(1000);
+        ds2431_interface_delay_ms(NULL, 1000);
     }
     
     /* overdrive match rom mode */
@@ -1026,7 +1030,7 @@ uint8_t ds2431_read_test(uint32_t times)
         ds2431_interface_debug_print("ds2431: passed.\n"); 
         
         /* delay 1000ms */
-        ds2431_interface_delay_ms(1000);
+        ds2431_interface_delay_ms(NULL, 1000);
     }
     
     /* resume mode */
@@ -1095,7 +1099,7 @@ uint8_t ds2431_read_test(uint32_t times)
         ds2431_interface_debug_print("ds2431: passed.\n"); 
         
         /* delay 1000ms */
-        ds2431_interface_delay_ms(1000);
+        ds2431_interface_delay_ms(NULL, 1000);
     }
     
     /* overdrive resume mode */
@@ -1164,7 +1168,7 @@ uint8_t ds2431_read_test(uint32_t times)
         ds2431_interface_debug_print("ds2431: passed.\n"); 
         
         /* delay 1000ms */
-        ds2431_interface_delay_ms(1000);
+        ds2431_interface_delay_ms(NULL, 1000);
     }
     
     /* finish read test */